@@ -51,7 +51,7 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't add a point with weight scale less than 0.0: %f.", p_weight_scale));
 
 	Point *found_pt;
-	bool p_exists = points.lookup(p_id, found_pt);
+	bool p_exists = _lookup_point(p_id, found_pt);
 
 	if (!p_exists) {
 		Point *pt = memnew(Point);
@@ -62,16 +62,85 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 		pt->open_pass = 0;
 		pt->closed_pass = 0;
 		pt->enabled = true;
+		if (points.get_num_elements() == 0) {
+			points_aabb = AABB(p_pos, Vector3());
+		} else {
+			points_aabb.expand_to(p_pos);
+		}
+		pt->bvh_id = points_bvh.insert(AABB(p_pos, Vector3()), pt);
 		points.set(p_id, pt);
+
+		_grow_dense_points(p_id);
+		if (p_id < (int64_t)dense_points.size()) {
+			dense_points[p_id] = pt;
+		}
 	} else {
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
+		_update_point_bounds(found_pt);
+	}
+}
+
+void AStar3D::_grow_dense_points(int64_t p_id) {
+	// Only keep ids in the array while it stays about as small as the hash map,
+	// so a few large ids do not allocate for all the ids below them.
+	const int64_t max_size = 2 * (int64_t)points.get_num_elements() + 1024;
+	const int64_t old_size = dense_points.size();
+	if (p_id < old_size || p_id >= max_size) {
+		return;
+	}
+
+	const int64_t new_size = MIN(MAX(p_id + 1, old_size * 2), max_size);
+	dense_points.resize(new_size);
+	for (int64_t i = old_size; i < new_size; i++) {
+		dense_points[i] = nullptr;
+	}
+
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		if (*(it.key) >= old_size && *(it.key) < new_size) {
+			dense_points[*(it.key)] = *(it.value);
+		}
+	}
+}
+
+void AStar3D::_insert_segment_leaf(Point *p_from_point, Point *p_to_point) {
+	HashMap<Pair<int64_t, int64_t>, SegmentLeaf, PairHash<int64_t, int64_t>>::Iterator E = segment_leaves.insert(Segment(p_from_point->id, p_to_point->id).key, SegmentLeaf());
+	E->value.from_point = p_from_point;
+	E->value.to_point = p_to_point;
+
+	AABB aabb(p_from_point->pos, Vector3());
+	aabb.expand_to(p_to_point->pos);
+	E->value.bvh_id = segments_bvh.insert(aabb, &E->value);
+}
+
+void AStar3D::_remove_segment_leaf(int64_t p_id, int64_t p_with_id) {
+	HashMap<Pair<int64_t, int64_t>, SegmentLeaf, PairHash<int64_t, int64_t>>::Iterator E = segment_leaves.find(Segment(p_id, p_with_id).key);
+	if (E) {
+		segments_bvh.remove(E->value.bvh_id);
+		segment_leaves.remove(E);
+	}
+}
+
+void AStar3D::_update_point_bounds(Point *p_point) {
+	points_aabb.expand_to(p_point->pos);
+	points_bvh.update(p_point->bvh_id, AABB(p_point->pos, Vector3()));
+
+	for (int i = 0; i < 2; i++) {
+		const OAHashMap<int64_t, Point *> &connected = i == 0 ? p_point->neighbors : p_point->unlinked_neighbours;
+		for (OAHashMap<int64_t, Point *>::Iterator it = connected.iter(); it.valid; it = connected.next_iter(it)) {
+			HashMap<Pair<int64_t, int64_t>, SegmentLeaf, PairHash<int64_t, int64_t>>::Iterator E = segment_leaves.find(Segment(p_point->id, *(it.key)).key);
+			if (E) {
+				AABB aabb(E->value.from_point->pos, Vector3());
+				aabb.expand_to(E->value.to_point->pos);
+				segments_bvh.update(E->value.bvh_id, aabb);
+			}
+		}
 	}
 }
 
 Vector3 AStar3D::get_point_position(int64_t p_id) const {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_V_MSG(!p_exists, Vector3(), vformat("Can't get point's position. Point with id: %d doesn't exist.", p_id));
 
 	return p->pos;
@@ -79,15 +148,16 @@ Vector3 AStar3D::get_point_position(int64_t p_id) const {
 
 void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
 	p->pos = p_pos;
+	_update_point_bounds(p);
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_V_MSG(!p_exists, 0, vformat("Can't get point's weight scale. Point with id: %d doesn't exist.", p_id));
 
 	return p->weight_scale;
@@ -95,7 +165,7 @@ real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
 
 void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's weight scale. Point with id: %d doesn't exist.", p_id));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
@@ -104,12 +174,13 @@ void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
 
 void AStar3D::remove_point(int64_t p_id) {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't remove point. Point with id: %d doesn't exist.", p_id));
 
 	for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
 		Segment s(p_id, (*it.key));
 		segments.erase(s);
+		_remove_segment_leaf(p_id, *(it.key));
 
 		(*it.value)->neighbors.remove(p->id);
 		(*it.value)->unlinked_neighbours.remove(p->id);
@@ -118,11 +189,17 @@ void AStar3D::remove_point(int64_t p_id) {
 	for (OAHashMap<int64_t, Point *>::Iterator it = p->unlinked_neighbours.iter(); it.valid; it = p->unlinked_neighbours.next_iter(it)) {
 		Segment s(p_id, (*it.key));
 		segments.erase(s);
+		_remove_segment_leaf(p_id, *(it.key));
 
 		(*it.value)->neighbors.remove(p->id);
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	points_bvh.remove(p->bvh_id);
+	if (p_id < (int64_t)dense_points.size()) {
+		dense_points[p_id] = nullptr;
+	}
+
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
@@ -132,11 +209,11 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 	ERR_FAIL_COND_MSG(p_id == p_with_id, vformat("Can't connect point with id: %d to itself.", p_id));
 
 	Point *a = nullptr;
-	bool from_exists = points.lookup(p_id, a);
+	bool from_exists = _lookup_point(p_id, a);
 	ERR_FAIL_COND_MSG(!from_exists, vformat("Can't connect points. Point with id: %d doesn't exist.", p_id));
 
 	Point *b = nullptr;
-	bool to_exists = points.lookup(p_with_id, b);
+	bool to_exists = _lookup_point(p_with_id, b);
 	ERR_FAIL_COND_MSG(!to_exists, vformat("Can't connect points. Point with id: %d doesn't exist.", p_with_id));
 
 	a->neighbors.set(b->id, b);
@@ -161,6 +238,8 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 			b->unlinked_neighbours.remove(a->id);
 		}
 		segments.remove(element);
+	} else {
+		_insert_segment_leaf(a, b);
 	}
 
 	segments.insert(s);
@@ -168,11 +247,11 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 
 void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
 	Point *a = nullptr;
-	bool a_exists = points.lookup(p_id, a);
+	bool a_exists = _lookup_point(p_id, a);
 	ERR_FAIL_COND_MSG(!a_exists, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_id));
 
 	Point *b = nullptr;
-	bool b_exists = points.lookup(p_with_id, b);
+	bool b_exists = _lookup_point(p_with_id, b);
 	ERR_FAIL_COND_MSG(!b_exists, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_with_id));
 
 	Segment s(p_id, p_with_id);
@@ -202,6 +281,8 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 		segments.remove(element);
 		if (s.direction != Segment::NONE) {
 			segments.insert(s);
+		} else {
+			_remove_segment_leaf(p_id, p_with_id);
 		}
 	}
 }
@@ -222,7 +303,7 @@ PackedInt64Array AStar3D::get_point_ids() {
 
 Vector<int64_t> AStar3D::get_point_connections(int64_t p_id) {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_V_MSG(!p_exists, Vector<int64_t>(), vformat("Can't get point's connections. Point with id: %d doesn't exist.", p_id));
 
 	Vector<int64_t> point_list;
@@ -249,6 +330,11 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+	dense_points.reset();
+	points_bvh.clear();
+	segments_bvh.clear();
+	segment_leaves.clear();
+	open_list.reset();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -265,26 +351,56 @@ void AStar3D::reserve_space(int64_t p_num_nodes) {
 	points.reserve(p_num_nodes);
 }
 
+real_t AStar3D::_get_closest_search_radius(const Vector3 &p_point, int64_t p_count) const {
+	// Start at the bounds of all points, with a margin about the spacing of evenly spread points.
+	const Vector3 closest_in_bounds = p_point.clamp(points_aabb.position, points_aabb.position + points_aabb.size);
+	return MAX(p_point.distance_to(closest_in_bounds) + points_aabb.get_longest_axis_size() / Math::sqrt((real_t)p_count), (real_t)CMP_EPSILON);
+}
+
 int64_t AStar3D::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
 	int64_t closest_id = -1;
 	real_t closest_dist = 1e20;
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
-		if (!p_include_disabled && !(*it.value)->enabled) {
-			continue; // Disabled points should not be considered.
+	if (points_bvh.is_empty()) {
+		return closest_id;
+	}
+
+	auto check_point = [&](void *p_data) {
+		const Point *p = (const Point *)p_data;
+		if (!p_include_disabled && !p->enabled) {
+			return false; // Disabled points should not be considered.
 		}
 
 		// Keep the closest point's ID, and in case of multiple closest IDs,
 		// the smallest one (makes it deterministic).
-		real_t d = p_point.distance_squared_to((*it.value)->pos);
-		int64_t id = *(it.key);
+		real_t d = p_point.distance_squared_to(p->pos);
 		if (d <= closest_dist) {
-			if (d == closest_dist && id > closest_id) { // Keep lowest ID.
-				continue;
+			if (d == closest_dist && p->id > closest_id) { // Keep lowest ID.
+				return false;
 			}
 			closest_dist = d;
-			closest_id = id;
+			closest_id = p->id;
 		}
+		return false;
+	};
+
+	if (likely(p_point.is_finite() && points_aabb.is_finite())) {
+		real_t search_radius = _get_closest_search_radius(p_point, points.get_num_elements());
+		while (Math::is_finite(search_radius)) {
+			const AABB search_aabb = AABB(p_point, Vector3()).grow(search_radius);
+			points_bvh.aabb_query(search_aabb, check_point);
+
+			// Any point closer than the one found lies inside a box of that distance around the position.
+			if ((closest_id != -1 && Math::sqrt(closest_dist) <= search_radius) || search_aabb.encloses(points_aabb)) {
+				return closest_id;
+			}
+			search_radius = closest_id != -1 ? Math::sqrt(closest_dist) : search_radius * 2.0;
+		}
+	}
+
+	// The search box can never enclose non-finite positions, check every point instead.
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		check_point(*it.value);
 	}
 
 	return closest_id;
@@ -293,19 +409,21 @@ int64_t AStar3D::get_closest_point(const Vector3 &p_point, bool p_include_disabl
 Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	real_t closest_dist = 1e20;
 	Vector3 closest_point;
+	bool found = false;
 
-	for (const Segment &E : segments) {
-		Point *from_point = nullptr, *to_point = nullptr;
-		points.lookup(E.key.first, from_point);
-		points.lookup(E.key.second, to_point);
+	if (segments_bvh.is_empty()) {
+		return closest_point;
+	}
 
-		if (!(from_point->enabled && to_point->enabled)) {
-			continue;
+	auto check_segment = [&](void *p_data) {
+		const SegmentLeaf *leaf = (const SegmentLeaf *)p_data;
+		if (!(leaf->from_point->enabled && leaf->to_point->enabled)) {
+			return false;
 		}
 
 		Vector3 segment[2] = {
-			from_point->pos,
-			to_point->pos,
+			leaf->from_point->pos,
+			leaf->to_point->pos,
 		};
 
 		Vector3 p = Geometry3D::get_closest_point_to_segment(p_point, segment);
@@ -313,9 +431,30 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 		if (d < closest_dist) {
 			closest_point = p;
 			closest_dist = d;
+			found = true;
+		}
+		return false;
+	};
+
+	if (likely(p_point.is_finite() && points_aabb.is_finite())) {
+		real_t search_radius = _get_closest_search_radius(p_point, segments.size());
+		while (Math::is_finite(search_radius)) {
+			const AABB search_aabb = AABB(p_point, Vector3()).grow(search_radius);
+			segments_bvh.aabb_query(search_aabb, check_segment);
+
+			// Any segment closer than the one found has bounds overlapping a box of that distance around the position.
+			if ((found && Math::sqrt(closest_dist) <= search_radius) || search_aabb.encloses(points_aabb)) {
+				return closest_point;
+			}
+			search_radius = found ? Math::sqrt(closest_dist) : search_radius * 2.0;
 		}
 	}
 
+	// The search box can never enclose non-finite positions, check every segment instead.
+	for (const KeyValue<Pair<int64_t, int64_t>, SegmentLeaf> &E : segment_leaves) {
+		check_segment((void *)&E.value);
+	}
+
 	return closest_point;
 }
 
@@ -329,7 +468,7 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point) {
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
+	open_list.clear();
 	SortArray<Point *, SortPoints> sorter;
 
 	begin_point->g_score = 0;
@@ -398,11 +537,11 @@ real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 	}
 
 	Point *from_point = nullptr;
-	bool from_exists = points.lookup(p_from_id, from_point);
+	bool from_exists = _lookup_point(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 
 	Point *to_point = nullptr;
-	bool to_exists = points.lookup(p_to_id, to_point);
+	bool to_exists = _lookup_point(p_to_id, to_point);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_to_id));
 
 	return from_point->pos.distance_to(to_point->pos);
@@ -415,11 +554,11 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 	}
 
 	Point *from_point = nullptr;
-	bool from_exists = points.lookup(p_from_id, from_point);
+	bool from_exists = _lookup_point(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 
 	Point *to_point = nullptr;
-	bool to_exists = points.lookup(p_to_id, to_point);
+	bool to_exists = _lookup_point(p_to_id, to_point);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
 
 	return from_point->pos.distance_to(to_point->pos);
@@ -427,11 +566,11 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 
 Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
 	Point *a = nullptr;
-	bool from_exists = points.lookup(p_from_id, a);
+	bool from_exists = _lookup_point(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 
 	Point *b = nullptr;
-	bool to_exists = points.lookup(p_to_id, b);
+	bool to_exists = _lookup_point(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
 	if (a == b) {
@@ -481,11 +620,11 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 
 Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
 	Point *a = nullptr;
-	bool from_exists = points.lookup(p_from_id, a);
+	bool from_exists = _lookup_point(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 
 	Point *b = nullptr;
-	bool to_exists = points.lookup(p_to_id, b);
+	bool to_exists = _lookup_point(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
 
 	if (a == b) {
@@ -535,7 +674,7 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 
 	p->enabled = !p_disabled;
@@ -543,7 +682,7 @@ void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
 	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	bool p_exists = _lookup_point(p_id, p);
 	ERR_FAIL_COND_V_MSG(!p_exists, false, vformat("Can't get if point is disabled. Point with id: %d doesn't exist.", p_id));
 
 	return !p->enabled;
@@ -682,11 +821,11 @@ real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 	}
 
 	AStar3D::Point *from_point = nullptr;
-	bool from_exists = astar.points.lookup(p_from_id, from_point);
+	bool from_exists = astar._lookup_point(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 
 	AStar3D::Point *to_point = nullptr;
-	bool to_exists = astar.points.lookup(p_to_id, to_point);
+	bool to_exists = astar._lookup_point(p_to_id, to_point);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_to_id));
 
 	return from_point->pos.distance_to(to_point->pos);
@@ -699,11 +838,11 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 	}
 
 	AStar3D::Point *from_point = nullptr;
-	bool from_exists = astar.points.lookup(p_from_id, from_point);
+	bool from_exists = astar._lookup_point(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 
 	AStar3D::Point *to_point = nullptr;
-	bool to_exists = astar.points.lookup(p_to_id, to_point);
+	bool to_exists = astar._lookup_point(p_to_id, to_point);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
 
 	return from_point->pos.distance_to(to_point->pos);
@@ -711,11 +850,11 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 
 Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
 	AStar3D::Point *a = nullptr;
-	bool from_exists = astar.points.lookup(p_from_id, a);
+	bool from_exists = astar._lookup_point(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 
 	AStar3D::Point *b = nullptr;
-	bool to_exists = astar.points.lookup(p_to_id, b);
+	bool to_exists = astar._lookup_point(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
 	if (a == b) {
@@ -764,11 +903,11 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 
 Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
 	AStar3D::Point *a = nullptr;
-	bool from_exists = astar.points.lookup(p_from_id, a);
+	bool from_exists = astar._lookup_point(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 
 	AStar3D::Point *b = nullptr;
-	bool to_exists = astar.points.lookup(p_to_id, b);
+	bool to_exists = astar._lookup_point(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
 
 	if (a == b) {
@@ -826,7 +965,8 @@ bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
 
 	bool found_route = false;
 
-	LocalVector<AStar3D::Point *> open_list;
+	LocalVector<AStar3D::Point *> &open_list = astar.open_list;
+	open_list.clear();
 	SortArray<AStar3D::Point *, AStar3D::SortPoints> sorter;
 
 	begin_point->g_score = 0;
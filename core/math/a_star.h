@@ -31,8 +31,10 @@
 #ifndef A_STAR_H
 #define A_STAR_H
 
+#include "core/math/dynamic_bvh.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 
 /**
@@ -50,6 +52,7 @@ class AStar3D : public RefCounted {
 		Vector3 pos;
 		real_t weight_scale = 0;
 		bool enabled = false;
+		DynamicBVH::ID bvh_id;
 
 		OAHashMap<int64_t, Point *> neighbors = 4u;
 		OAHashMap<int64_t, Point *> unlinked_neighbours = 4u;
@@ -108,6 +111,12 @@ class AStar3D : public RefCounted {
 		}
 	};
 
+	struct SegmentLeaf {
+		Point *from_point = nullptr;
+		Point *to_point = nullptr;
+		DynamicBVH::ID bvh_id;
+	};
+
 	int64_t last_free_id = 0;
 	uint64_t pass = 1;
 
@@ -115,6 +124,33 @@ class AStar3D : public RefCounted {
 	HashSet<Segment, Segment> segments;
 	Point *last_closest_point = nullptr;
 
+	// Points with small ids are also stored in a flat array indexed by id, so they can be looked up without hashing.
+	LocalVector<Point *> dense_points;
+
+	// Queries do not modify the trees, `DynamicBVH` just does not declare them const.
+	mutable DynamicBVH points_bvh;
+	mutable DynamicBVH segments_bvh;
+	HashMap<Pair<int64_t, int64_t>, SegmentLeaf, PairHash<int64_t, int64_t>> segment_leaves;
+	// Grows to enclose every position points had, used to bound the closest point and segment searches.
+	AABB points_aabb;
+
+	// Kept between solves to avoid reallocating it.
+	LocalVector<Point *> open_list;
+
+	_FORCE_INLINE_ bool _lookup_point(int64_t p_id, Point *&r_point) const {
+		if (p_id >= 0 && p_id < (int64_t)dense_points.size()) {
+			r_point = dense_points[p_id];
+			return r_point != nullptr;
+		}
+		return points.lookup(p_id, r_point);
+	}
+
+	void _grow_dense_points(int64_t p_id);
+	void _insert_segment_leaf(Point *p_from_point, Point *p_to_point);
+	void _remove_segment_leaf(int64_t p_id, int64_t p_with_id);
+	void _update_point_bounds(Point *p_point);
+	real_t _get_closest_search_radius(const Vector3 &p_point, int64_t p_count) const;
+
 	bool _solve(Point *begin_point, Point *end_point);
 
 protected:
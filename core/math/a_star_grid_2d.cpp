@@ -254,11 +254,11 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
+AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to, const Point *p_end) {
 	if (!p_to || p_to->solid) {
 		return nullptr;
 	}
-	if (p_to == end) {
+	if (p_to == p_end) {
 		return p_to;
 	}
 
@@ -276,10 +276,10 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
+			if (_jump(p_to, _get_point(to_x + dx, to_y), p_end) != nullptr) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
+			if (_jump(p_to, _get_point(to_x, to_y + dy), p_end) != nullptr) {
 				return p_to;
 			}
 		} else {
@@ -294,17 +294,17 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 			}
 		}
 		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+			return _jump(p_to, _get_point(to_x + dx, to_y + dy), p_end);
 		}
 	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 		if (dx != 0 && dy != 0) {
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
+			if (_jump(p_to, _get_point(to_x + dx, to_y), p_end) != nullptr) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
+			if (_jump(p_to, _get_point(to_x, to_y + dy), p_end) != nullptr) {
 				return p_to;
 			}
 		} else {
@@ -319,7 +319,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 			}
 		}
 		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+			return _jump(p_to, _get_point(to_x + dx, to_y + dy), p_end);
 		}
 	} else { // DIAGONAL_MODE_NEVER
 		if (dx != 0) {
@@ -330,14 +330,14 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
+			if (_jump(p_to, _get_point(to_x + 1, to_y), p_end) != nullptr) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
+			if (_jump(p_to, _get_point(to_x - 1, to_y), p_end) != nullptr) {
 				return p_to;
 			}
 		}
-		return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+		return _jump(p_to, _get_point(to_x + dx, to_y + dy), p_end);
 	}
 	return nullptr;
 }
@@ -446,9 +446,46 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
-	last_closest_point = nullptr;
-	pass++;
+AStarGrid2D::SolveContext *AStarGrid2D::_acquire_solve_context() {
+	SolveContext *context = nullptr;
+	{
+		MutexLock lock(solve_contexts_mutex);
+		if (!free_solve_contexts.is_empty()) {
+			context = free_solve_contexts[free_solve_contexts.size() - 1];
+			free_solve_contexts.remove_at(free_solve_contexts.size() - 1);
+		}
+	}
+	if (!context) {
+		context = memnew(SolveContext);
+	}
+
+	// The grid might have been resized since this context was last used.
+	const uint32_t point_count = region.size.x * region.size.y;
+	if (context->states.size() != point_count) {
+		context->states.clear();
+		context->states.resize(point_count);
+		context->pass = 0;
+	}
+	return context;
+}
+
+void AStarGrid2D::_release_solve_context(SolveContext *p_context) {
+	MutexLock lock(solve_contexts_mutex);
+	free_solve_contexts.push_back(p_context);
+}
+
+bool AStarGrid2D::_solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point) {
+	r_context.last_closest_state = nullptr;
+	r_context.pass++;
+	if (r_context.pass == 0) {
+		// The pass counter wrapped around, so older marks could match again.
+		for (PointState &state : r_context.states) {
+			state.open_pass = 0;
+			state.closed_pass = 0;
+		}
+		r_context.pass = 1;
+	}
+	const uint32_t pass = r_context.pass;
 
 	if (p_end_point->solid) {
 		return false;
@@ -456,34 +493,38 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	LocalVector<PointState *> &open_list = r_context.open_list;
+	open_list.clear();
+	SortArray<PointState *, SortPoints> sorter;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	PointState *begin_state = _get_state(r_context, p_begin_point);
+	PointState *end_state = _get_state(r_context, p_end_point);
+	begin_state->g_score = 0;
+	begin_state->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	open_list.push_back(begin_state);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		PointState *p_state = open_list[0]; // The currently processed point.
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		// The distance to begin_point is g_score and the estimated distance to end_point is f_score - g_score.
+		const PointState *closest = r_context.last_closest_state;
+		if (closest == nullptr || closest->f_score - closest->g_score > p_state->f_score - p_state->g_score || (closest->f_score - closest->g_score >= p_state->f_score - p_state->g_score && closest->g_score > p_state->g_score)) {
+			r_context.last_closest_state = p_state;
 		}
 
-		if (p == p_end_point) {
+		if (p_state == end_state) {
 			found_route = true;
 			break;
 		}
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		p_state->closed_pass = pass; // Mark the point as closed.
 
-		LocalVector<Point *> nbors;
+		Point *p = _get_state_point(r_context, p_state);
+		LocalVector<Point *> &nbors = r_context.nbors;
+		nbors.clear();
 		_get_nbors(p, nbors);
 
 		for (Point *e : nbors) {
@@ -491,39 +532,37 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e = _jump(p, e, p_end_point);
+				if (!e || _get_state(r_context, e)->closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				if (e->solid || _get_state(r_context, e)->closed_pass == pass) {
 					continue;
 				}
 				weight_scale = e->weight_scale;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			PointState *e_state = _get_state(r_context, e);
+			real_t tentative_g_score = p_state->g_score + _compute_cost(p->id, e->id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (e_state->open_pass != pass) { // The point wasn't inside the open list.
+				e_state->open_pass = pass;
+				open_list.push_back(e_state);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= e_state->g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
-
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			e_state->prev_state = p_state;
+			e_state->g_score = tentative_g_score;
+			e_state->f_score = e_state->g_score + _estimate_cost(e->id, p_end_point->id);
 
 			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+				sorter.push_heap(0, open_list.size() - 1, 0, e_state, open_list.ptr());
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+				sorter.push_heap(0, open_list.find(e_state), 0, e_state, open_list.ptr());
 			}
 		}
 	}
@@ -531,6 +570,17 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 	return found_route;
 }
 
+AStarGrid2D::PointState *AStarGrid2D::_find_path_end(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
+	if (_solve(r_context, p_begin_point, p_end_point)) {
+		return _get_state(r_context, p_end_point);
+	}
+	if (!p_allow_partial_path) {
+		return nullptr;
+	}
+	// Use closest point instead.
+	return r_context.last_closest_state;
+}
+
 real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
@@ -572,42 +622,35 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	SolveContext *context = _acquire_solve_context();
 
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Vector<Vector2>();
+	Vector<Vector2> path;
+	PointState *end_state = _find_path_end(*context, a, b, p_allow_partial_path);
+	if (end_state) {
+		PointState *begin_state = _get_state(*context, a);
+
+		PointState *p = end_state;
+		int32_t pc = 1;
+		while (p != begin_state) {
+			pc++;
+			p = p->prev_state;
 		}
 
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
+		path.resize(pc);
 
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
-	Vector<Vector2> path;
-	path.resize(pc);
-
-	{
 		Vector2 *w = path.ptrw();
 
-		p = end_point;
+		p = end_state;
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+		while (p != begin_state) {
+			w[idx--] = _get_state_point(*context, p)->pos;
+			p = p->prev_state;
 		}
 
-		w[0] = p->pos;
+		w[0] = a->pos;
 	}
 
+	_release_solve_context(context);
 	return path;
 }
 
@@ -625,43 +668,42 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	SolveContext *context = _acquire_solve_context();
 
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return TypedArray<Vector2i>();
+	TypedArray<Vector2i> path;
+	PointState *end_state = _find_path_end(*context, a, b, p_allow_partial_path);
+	if (end_state) {
+		PointState *begin_state = _get_state(*context, a);
+
+		PointState *p = end_state;
+		int32_t pc = 1;
+		while (p != begin_state) {
+			pc++;
+			p = p->prev_state;
 		}
 
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
+		path.resize(pc);
 
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
-	TypedArray<Vector2i> path;
-	path.resize(pc);
-
-	{
-		p = end_point;
+		p = end_state;
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
+		while (p != begin_state) {
+			path[idx--] = _get_state_point(*context, p)->id;
+			p = p->prev_state;
 		}
 
-		path[0] = p->id;
+		path[0] = a->id;
 	}
 
+	_release_solve_context(context);
 	return path;
 }
 
+AStarGrid2D::~AStarGrid2D() {
+	for (SolveContext *context : free_solve_contexts) {
+		memdelete(context);
+	}
+}
+
 void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_region", "region"), &AStarGrid2D::set_region);
 	ClassDB::bind_method(D_METHOD("get_region"), &AStarGrid2D::get_region);
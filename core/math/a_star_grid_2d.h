@@ -33,6 +33,7 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
 
@@ -82,25 +83,23 @@ private:
 		Vector2 pos;
 		real_t weight_scale = 1.0;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
-		real_t g_score = 0;
-		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
-
-		// Used for getting last_closest_point.
-		real_t abs_g_score = 0;
-		real_t abs_f_score = 0;
-
 		Point() {}
 
 		Point(const Vector2i &p_id, const Vector2 &p_pos) :
 				id(p_id), pos(p_pos) {}
 	};
 
+	// Pathfinding state of a point, stored per query so the grid itself is only read while solving.
+	struct PointState {
+		PointState *prev_state = nullptr;
+		real_t g_score = 0;
+		real_t f_score = 0;
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
+	};
+
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
+		_FORCE_INLINE_ bool operator()(const PointState *A, const PointState *B) const { // Returns true when the Point A is worse than Point B.
 			if (A->f_score > B->f_score) {
 				return true;
 			} else if (A->f_score < B->f_score) {
@@ -111,11 +110,20 @@ private:
 		}
 	};
 
+	// Everything a single path query writes to. Contexts are pooled and reused,
+	// so queries on the same grid can run from several threads at once.
+	struct SolveContext {
+		LocalVector<PointState> states; // One per point, in row order.
+		LocalVector<PointState *> open_list;
+		LocalVector<Point *> nbors;
+		uint32_t pass = 0;
+		PointState *last_closest_state = nullptr;
+	};
+
 	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
 
-	uint64_t pass = 1;
+	Mutex solve_contexts_mutex;
+	LocalVector<SolveContext *> free_solve_contexts;
 
 private: // Internal routines.
 	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
@@ -144,9 +152,22 @@ private: // Internal routines.
 		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
 	}
 
+	_FORCE_INLINE_ PointState *_get_state(SolveContext &r_context, const Point *p_point) const {
+		return &r_context.states[(p_point->id.y - region.position.y) * region.size.x + (p_point->id.x - region.position.x)];
+	}
+
+	_FORCE_INLINE_ Point *_get_state_point(SolveContext &r_context, const PointState *p_state) {
+		const int32_t index = p_state - r_context.states.ptr();
+		return &points[index / region.size.x][index % region.size.x];
+	}
+
+	SolveContext *_acquire_solve_context();
+	void _release_solve_context(SolveContext *p_context);
+
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point);
+	Point *_jump(Point *p_from, Point *p_to, const Point *p_end);
+	bool _solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point);
+	PointState *_find_path_end(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
 
 protected:
 	static void _bind_methods();
@@ -211,6 +232,8 @@ public:
 	Vector2 get_point_position(const Vector2i &p_id) const;
 	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
 	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
+
+	~AStarGrid2D();
 };
 
 VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -306,6 +307,22 @@ public:
 #endif
 	}
 
+	// Same as update(), but the overlap tests for pairing are spread over WorkerThreadPool tasks.
+	// Pair and unpair callbacks are still sent from the calling thread, in the order of the changed items,
+	// so the outcome doesn't depend on the number of threads.
+	void update_threaded() {
+		BVH_LOCKED_FUNCTION
+		tree.update();
+		if (changed_items.size() < THREADED_PAIRING_MIN_ITEMS) {
+			_check_for_collisions();
+		} else {
+			_check_for_collisions_threaded();
+		}
+#ifdef BVH_INTEGRITY_CHECKS
+		tree._integrity_check_all();
+#endif
+	}
+
 	// this can be called more frequently than per frame if necessary
 	void update_collisions() {
 		BVH_LOCKED_FUNCTION
@@ -480,6 +497,80 @@ private:
 		_reset();
 	}
 
+	// Below this, the cost of dispatching tasks outweighs the gain.
+	static const uint32_t THREADED_PAIRING_MIN_ITEMS = 64;
+
+	struct ThreadedPairingResult {
+		LocalVector<BVHHandle> leavers;
+		LocalVector<uint32_t, uint32_t, true> enterers;
+	};
+	LocalVector<ThreadedPairingResult> _threaded_pairing_results;
+
+	// Only reads the tree, so it can run for several changed items at once.
+	void _threaded_pairing_process(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+		ThreadedPairingResult &result = _threaded_pairing_results[p_index];
+
+		BVHABB_CLASS abb;
+		abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		result.leavers.clear();
+		const typename BVHTREE_CLASS::ItemPairs &pairs = tree._pairs[h.id()];
+		for (unsigned int n = 0; n < pairs.extended_pairs.size(); n++) {
+			BVHHandle h_to = pairs.extended_pairs[n].handle;
+			if (_is_leaver(abb, h, h_to, false)) {
+				result.leavers.push_back(h_to);
+			}
+		}
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &result.enterers;
+		tree.item_fill_cullparams(h, params);
+		params.abb = abb;
+		tree.cull_aabb(params, false);
+	}
+
+	void _check_for_collisions_threaded() {
+		uint32_t item_count = changed_items.size();
+		if (_threaded_pairing_results.size() < item_count) {
+			_threaded_pairing_results.resize(item_count);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_threaded_pairing_process, (void *)nullptr, item_count, -1, true, SNAME("BVHPairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Leavers first. A pair may have been reported by both of its items, or already
+		// removed while processing an earlier item, so check it's still there.
+		for (uint32_t i = 0; i < item_count; i++) {
+			const BVHHandle &h = changed_items[i];
+			for (const BVHHandle &h_to : _threaded_pairing_results[i].leavers) {
+				if (tree._pairs[h.id()].contains_pair_to(h_to)) {
+					_unpair(h, h_to);
+				}
+			}
+		}
+
+		// Then enterers. _collide() skips pairs that already exist.
+		for (uint32_t i = 0; i < item_count; i++) {
+			const BVHHandle &h = changed_items[i];
+			for (const uint32_t ref_id : _threaded_pairing_results[i].enterers) {
+				// don't collide against ourself
+				if (ref_id == h.id()) {
+					continue;
+				}
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -540,8 +631,8 @@ private:
 		return p_pair_data;
 	}
 
-	// returns true if unpair
-	bool _find_leavers_process_pair(typename BVHTREE_CLASS::ItemPairs &p_pairs_from, const BVHABB_CLASS &p_abb_from, BVHHandle p_from, BVHHandle p_to, bool p_full_check) {
+	// returns true if the pair should be removed, doesn't modify anything
+	bool _is_leaver(const BVHABB_CLASS &p_abb_from, BVHHandle p_from, BVHHandle p_to, bool p_full_check) {
 		BVHABB_CLASS abb_to;
 		tree.item_get_ABB(p_to, abb_to);
 
@@ -568,6 +659,15 @@ private:
 			}
 		}
 
+		return true;
+	}
+
+	// returns true if unpair
+	bool _find_leavers_process_pair(typename BVHTREE_CLASS::ItemPairs &p_pairs_from, const BVHABB_CLASS &p_abb_from, BVHHandle p_from, BVHHandle p_to, bool p_full_check) {
+		if (!_is_leaver(p_abb_from, p_from, p_to, p_full_check)) {
+			return false;
+		}
+
 		_unpair(p_from, p_to);
 		return true;
 	}
@@ -47,6 +47,8 @@ WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 thread_local CommandQueueMT *WorkerThreadPool::flushing_cmd_queue = nullptr;
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	LocalVector<Task *> released; // Dependents that became ready, posted once this task is done.
+
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
@@ -74,7 +76,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	if (p_task->group) {
 		// Handling a group
-		bool do_post = false;
+		bool do_post = p_task->group->max == 0; // Only happens for empty groups that had to wait for dependencies.
 
 		while (true) {
 			uint32_t work_index = p_task->group->index.postincrement();
@@ -105,6 +107,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (do_post) {
 			p_task->group->done_semaphore.post();
 			p_task->group->completed.set_to(true);
+
+			// The group is still alive, as this task hasn't been counted as finished yet.
+			task_mutex.lock();
+			_release_dependents(p_task->group->dependents, released);
+			task_mutex.unlock();
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -133,6 +140,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		_release_dependents(p_task->dependents, released);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -163,13 +171,19 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 #endif
+
+	if (!released.is_empty()) {
+		_post_released_tasks(released);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+
+		// Tasks spawned by this thread are taken first and without locking.
+		if (!thread_data->local_queue.pop(task_to_process)) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -180,8 +194,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				// Local queues are only pushed to with the mutex held, so nothing can be missed
+				// between an unsuccessful steal here and starting to wait.
+				task_to_process = singleton->_steal_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+					DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				}
 			}
 		}
 
@@ -211,7 +230,10 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && caller_pool_thread && caller_pool_thread->local_queue.push(p_tasks[i])) {
+			// Subtasks spawned from a pool thread stay on it, unless idle threads steal them.
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -241,6 +263,11 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	// which helps reducing sync traffic.
 
 	uint32_t thread_count = threads.size();
+	if (unlikely(thread_count == 0)) {
+		return;
+	}
+	// The rotation may have been left past the end by a pool that had more threads.
+	notify_index %= thread_count;
 
 	// First round:
 	// 1. For processing: notify threads that are not running tasks, to keep the stacks as shallow as possible.
@@ -305,11 +332,97 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	bool retry = true;
+	while (retry) {
+		retry = false;
+		// Start right after the thief so that thieves spread across victims.
+		for (uint32_t i = 1; i < thread_count; i++) {
+			ThreadData &victim = threads[(p_thief->index + i) % thread_count];
+			Task *task = nullptr;
+			switch (victim.local_queue.steal(task)) {
+				case WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE>::STEAL_SUCCESS: {
+					return task;
+				} break;
+				case WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE>::STEAL_ABORT: {
+					// Lost a race, but the victim may still have work.
+					retry = true;
+				} break;
+				case WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE>::STEAL_EMPTY: {
+				} break;
+			}
+		}
+	}
+	return nullptr;
+}
+
+uint32_t WorkerThreadPool::_add_dependent(int64_t p_dependent_id, const Vector<int64_t> &p_dependencies) {
+	uint32_t pending = 0;
+	for (const int64_t &dependency : p_dependencies) {
+		ERR_CONTINUE_MSG(dependency < 0 || (uint64_t)dependency >= last_task || dependency == p_dependent_id, vformat("Invalid dependency ID: %d.", dependency));
+		Task **taskp = tasks.getptr(dependency);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				(*taskp)->dependents.push_back(p_dependent_id);
+				pending++;
+			}
+			continue;
+		}
+		Group **groupp = groups.getptr(dependency);
+		if (groupp) {
+			// Groups flag completion before releasing their dependents under the mutex, so none can be missed.
+			if (!(*groupp)->completed.is_set()) {
+				(*groupp)->dependents.push_back(p_dependent_id);
+				pending++;
+			}
+			continue;
+		}
+		// Otherwise, it's already completed and waited for, so there is nothing to wait for.
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(LocalVector<int64_t> &p_dependents, LocalVector<Task *> &r_released) {
+	for (const int64_t &dependent : p_dependents) {
+		Task **taskp = tasks.getptr(dependent);
+		if (taskp) {
+			Task *task = *taskp;
+			DEV_ASSERT(task->pending_dependencies > 0);
+			task->pending_dependencies--;
+			if (task->pending_dependencies == 0) {
+				r_released.push_back(task);
+			}
+			continue;
+		}
+		Group **groupp = groups.getptr(dependent);
+		ERR_CONTINUE(!groupp);
+		Group *group = *groupp;
+		DEV_ASSERT(group->pending_dependencies > 0);
+		group->pending_dependencies--;
+		if (group->pending_dependencies == 0) {
+			for (Task *task : group->held_tasks) {
+				r_released.push_back(task);
+			}
+			group->held_tasks.clear();
+		}
+	}
+	p_dependents.clear();
+}
+
+void WorkerThreadPool::_post_released_tasks(const LocalVector<Task *> &p_released) {
+	for (Task *task : p_released) {
+		// Priority was stored when the task was held.
+		task_mutex.lock();
+		_post_tasks_and_unlock(&task, 1, !task->low_priority);
+	}
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<int64_t> &p_dependencies) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -322,6 +435,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->template_userdata = p_template_userdata;
 	tasks.insert(id, task);
 
+	task->pending_dependencies = _add_dependent(id, p_dependencies);
+	if (task->pending_dependencies) {
+		// Held until the last dependency completes.
+		task->low_priority = !p_high_priority;
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
 	return id;
@@ -331,6 +452,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const Vector<int64_t> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const Vector<int64_t> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -428,9 +557,14 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 						}
 					}
 
-					if (singleton->task_queue.first()) {
-						task_to_process = task_queue.first()->self();
-						task_queue.remove(task_queue.first());
+					// Own local tasks first, since the awaited one is likely among them.
+					if (!caller_pool_thread->local_queue.pop(task_to_process)) {
+						if (singleton->task_queue.first()) {
+							task_to_process = task_queue.first()->self();
+							task_queue.remove(task_queue.first());
+						} else {
+							task_to_process = _steal_task(caller_pool_thread);
+						}
 					}
 
 					if (!task_to_process) {
@@ -468,7 +602,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	return OK;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<int64_t> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -479,9 +613,10 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->pending_dependencies = _add_dependent(id, p_dependencies);
 
 	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
+	if (p_elements == 0 && group->pending_dependencies == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
 		group->completed.set_to(true);
 		group->done_semaphore.post();
@@ -492,6 +627,10 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		}
 
 	} else {
+		if (p_elements == 0) {
+			// Still has to wait for its dependencies, so a single task will complete it.
+			p_tasks = 1;
+		}
 		group->tasks_used = p_tasks;
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
@@ -509,6 +648,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (group->pending_dependencies) {
+		// Held until the last dependency completes.
+		for (int i = 0; i < p_tasks; i++) {
+			tasks_posted[i]->low_priority = !p_high_priority;
+			group->held_tasks.push_back(tasks_posted[i]);
+		}
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
@@ -522,6 +671,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, const Vector<int64_t> &p_dependencies, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, const Vector<int64_t> &p_dependencies, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	task_mutex.lock();
 	const Group *const *groupp = groups.getptr(p_group);
@@ -549,13 +706,14 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
+	// The table may be reallocated by other threads once unlocked.
+	Group *group = groupp ? *groupp : nullptr;
 	task_mutex.unlock();
-	if (!groupp) {
+	if (!group) {
 		ERR_FAIL_MSG("Invalid Group ID.");
 	}
 
 	{
-		Group *group = *groupp;
 
 		if (flushing_cmd_queue) {
 			flushing_cmd_queue->unlock();
@@ -606,6 +764,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
 
 	threads.resize(p_thread_count);
+	thread_ids.reserve(p_thread_count);
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
@@ -642,19 +801,57 @@ void WorkerThreadPool::finish() {
 	{
 		MutexLock lock(task_mutex);
 		for (KeyValue<TaskID, Task *> &E : tasks) {
+			if (E.value->pending_dependencies) {
+				print_error("Task was still waiting for its dependencies: " + E.value->description);
+				if (E.value->template_userdata) {
+					memdelete(E.value->template_userdata);
+				}
+			}
 			task_allocator.free(E.value);
 		}
+		tasks.clear();
+
+		// Held group tasks are not in the task table, and their groups are never waited for.
+		LocalVector<GroupID> held_groups;
+		for (KeyValue<GroupID, Group *> &E : groups) {
+			Group *group = E.value;
+			if (!group->pending_dependencies) {
+				continue;
+			}
+			ERR_CONTINUE(group->held_tasks.is_empty());
+			print_error("Group task was still waiting for its dependencies: " + group->held_tasks[0]->description);
+			// All tasks of a group share the same userdata.
+			if (group->held_tasks[0]->template_userdata) {
+				memdelete(group->held_tasks[0]->template_userdata);
+			}
+			for (Task *task : group->held_tasks) {
+				task_allocator.free(task);
+			}
+			group_allocator.free(group);
+			held_groups.push_back(E.key);
+		}
+		for (const GroupID &id : held_groups) {
+			groups.erase(id);
+		}
 	}
 
 	threads.clear();
+	thread_ids.clear();
+
+	// Allow init() to be called again, e.g. with a different thread count.
+	exit_threads = false;
+	low_priority_threads_used = 0;
+	notify_index = 0;
 }
 
 void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "action", "dependencies", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
@@ -36,10 +36,12 @@
 #include "core/os/os.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/templates/dense_hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class CommandQueueMT;
 
@@ -71,6 +73,9 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		uint32_t pending_dependencies = 0;
+		LocalVector<Task *> held_tasks; // Posted once there are no pending dependencies.
+		LocalVector<int64_t> dependents; // Tasks and groups waiting for this one to complete.
 	};
 
 	struct Task {
@@ -89,6 +94,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0; // Not posted until this reaches zero.
+		LocalVector<int64_t> dependents; // Tasks and groups waiting for this one to complete.
 
 		void free_template_userdata();
 		Task() :
@@ -97,6 +104,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 1024;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -114,26 +122,17 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable. Special value for idle-waiting.
 		ConditionVariable cond_var;
+		// High priority tasks posted from this thread. Only this thread pushes and pops; other threads steal.
+		WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE> local_queue;
 	};
 
 	TightLocalVector<ThreadData> threads;
 	bool exit_threads = false;
 
-	HashMap<Thread::ID, int> thread_ids;
-	HashMap<
-			TaskID,
-			Task *,
-			HashMapHasherDefault,
-			HashMapComparatorDefault<TaskID>,
-			PagedAllocator<HashMapElement<TaskID, Task *>, false, TASKS_PAGE_SIZE>>
-			tasks;
-	HashMap<
-			GroupID,
-			Group *,
-			HashMapHasherDefault,
-			HashMapComparatorDefault<GroupID>,
-			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
-			groups;
+	// Hot lookup tables, looked up, inserted into and erased from for every task.
+	DenseHashMap<Thread::ID, int> thread_ids;
+	DenseHashMap<TaskID, Task *> tasks;
+	DenseHashMap<GroupID, Group *> groups;
 
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
@@ -149,13 +148,18 @@ private:
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
+	Task *_steal_task(const ThreadData *p_thief);
+
+	uint32_t _add_dependent(int64_t p_dependent_id, const Vector<int64_t> &p_dependencies);
+	void _release_dependents(LocalVector<int64_t> &p_dependents, LocalVector<Task *> &r_released);
+	void _post_released_tasks(const LocalVector<Task *> &p_released);
 
 	static WorkerThreadPool *singleton;
 
 	static thread_local CommandQueueMT *flushing_cmd_queue;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<int64_t> &p_dependencies = Vector<int64_t>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<int64_t> &p_dependencies = Vector<int64_t>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -193,6 +197,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependencies can be task and group IDs. The new task is posted once all of them are completed,
+	// so chains of work need only one wait at the end (IDs still have to be waited for to be released).
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_with_dependencies(C *p_instance, M p_method, U p_userdata, const Vector<int64_t> &p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
+	}
+	TaskID add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const Vector<int64_t> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_with_dependencies(const Callable &p_action, const Vector<int64_t> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -207,6 +225,18 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	template <typename C, typename M, typename U>
+	GroupID add_template_group_task_with_dependencies(C *p_instance, M p_method, U p_userdata, const Vector<int64_t> &p_dependencies, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, const Vector<int64_t> &p_dependencies, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_with_dependencies(const Callable &p_action, const Vector<int64_t> &p_dependencies, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
@@ -0,0 +1,231 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/error/error_macros.h"
+
+#include <string.h>
+
+namespace {
+
+struct Chunk {
+	Chunk *prev = nullptr;
+	size_t size = 0; // Usable bytes after the chunk header.
+};
+
+struct ThreadArena;
+
+struct AllocationHeader {
+	ThreadArena *arena = nullptr;
+	size_t size = 0;
+};
+
+constexpr size_t _align_up(size_t p_size) {
+	return (p_size + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t);
+}
+
+constexpr size_t CHUNK_HEADER_SIZE = _align_up(sizeof(Chunk));
+constexpr size_t HEADER_SIZE = _align_up(sizeof(AllocationHeader));
+constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+struct ThreadArena {
+	Chunk *chunk = nullptr;
+	uint8_t *top = nullptr;
+	uint8_t *end = nullptr;
+	uint32_t live_count = 0;
+	uint64_t frame = 0;
+	size_t used = 0; // Bytes bumped since the last rewind, over all chunks.
+	size_t frame_peak = 0;
+	size_t reserved = 0;
+
+	void release_chunks(Chunk *p_chunk) {
+		while (p_chunk) {
+			Chunk *prev = p_chunk->prev;
+			reserved -= p_chunk->size;
+			memfree(p_chunk);
+			p_chunk = prev;
+		}
+	}
+
+	void rewind() {
+		if (!chunk) {
+			return;
+		}
+
+		uint64_t current_frame = FrameArena::get_frame();
+		if (frame != current_frame) {
+			// Give back memory the previous frame did not need, keeping some headroom.
+			if (chunk->size > MIN_CHUNK_SIZE && frame_peak * 4 < chunk->size) {
+				release_chunks(chunk);
+				chunk = nullptr;
+				top = nullptr;
+				end = nullptr;
+			}
+			frame = current_frame;
+			frame_peak = 0;
+		}
+
+		if (chunk) {
+			// Chunks grow geometrically, so the current one is the largest.
+			release_chunks(chunk->prev);
+			chunk->prev = nullptr;
+			top = (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+			end = top + chunk->size;
+		}
+		used = 0;
+	}
+
+	bool grow(size_t p_bytes) {
+		size_t size = MAX(MIN_CHUNK_SIZE, p_bytes);
+		if (chunk) {
+			size = MAX(size, chunk->size * 2);
+		}
+		Chunk *new_chunk = (Chunk *)memalloc(CHUNK_HEADER_SIZE + size);
+		if (!new_chunk) {
+			return false;
+		}
+		new_chunk->prev = chunk;
+		new_chunk->size = size;
+		chunk = new_chunk;
+		top = (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+		end = top + size;
+		reserved += size;
+		return true;
+	}
+
+	~ThreadArena() {
+		// Leaked allocations would be left dangling, keep their memory instead.
+		if (live_count == 0) {
+			release_chunks(chunk);
+		}
+	}
+};
+
+thread_local ThreadArena thread_arena;
+
+_FORCE_INLINE_ AllocationHeader *_get_header(void *p_memory) {
+	return (AllocationHeader *)((uint8_t *)p_memory - HEADER_SIZE);
+}
+
+_FORCE_INLINE_ size_t _get_footprint(size_t p_bytes) {
+	return HEADER_SIZE + _align_up(p_bytes);
+}
+
+} // namespace
+
+SafeNumeric<uint64_t> FrameArena::frame;
+
+void *FrameArena::alloc(size_t p_bytes) {
+	ThreadArena &arena = thread_arena;
+	if (arena.live_count == 0) {
+		arena.rewind();
+	}
+
+	size_t footprint = _get_footprint(p_bytes);
+	if (unlikely((size_t)(arena.end - arena.top) < footprint)) {
+		if (!arena.grow(footprint)) {
+			return nullptr;
+		}
+	}
+
+	AllocationHeader *header = (AllocationHeader *)arena.top;
+	header->arena = &arena;
+	header->size = p_bytes;
+	arena.top += footprint;
+	arena.used += footprint;
+	arena.frame_peak = MAX(arena.frame_peak, arena.used);
+	arena.live_count++;
+
+	return (uint8_t *)header + HEADER_SIZE;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	ThreadArena &arena = thread_arena;
+	AllocationHeader *header = _get_header(p_memory);
+	ERR_FAIL_COND_V_MSG(header->arena != &arena, nullptr, "Frame arena memory must be reallocated by the thread that allocated it.");
+
+	size_t old_footprint = _get_footprint(header->size);
+	size_t new_footprint = _get_footprint(p_bytes);
+
+	// The most recent allocation can be resized in place.
+	if ((uint8_t *)header + old_footprint == arena.top && (size_t)(arena.end - (uint8_t *)header) >= new_footprint) {
+		arena.top = (uint8_t *)header + new_footprint;
+		arena.used = arena.used - old_footprint + new_footprint;
+		arena.frame_peak = MAX(arena.frame_peak, arena.used);
+		header->size = p_bytes;
+		return p_memory;
+	}
+
+	if (p_bytes <= header->size) {
+		return p_memory;
+	}
+
+	void *new_memory = alloc(p_bytes);
+	if (!new_memory) {
+		return nullptr;
+	}
+	memcpy(new_memory, p_memory, header->size);
+	free(p_memory);
+	return new_memory;
+}
+
+void FrameArena::free(void *p_memory) {
+	if (p_memory == nullptr) {
+		return;
+	}
+
+	ThreadArena &arena = thread_arena;
+	AllocationHeader *header = _get_header(p_memory);
+	ERR_FAIL_COND_MSG(header->arena != &arena, "Frame arena memory must be freed by the thread that allocated it.");
+
+	size_t footprint = _get_footprint(header->size);
+	if ((uint8_t *)header + footprint == arena.top) {
+		arena.top = (uint8_t *)header;
+		arena.used -= footprint;
+	}
+	arena.live_count--;
+}
+
+void FrameArena::begin_frame() {
+	frame.increment();
+}
+
+uint64_t FrameArena::get_thread_reserved() {
+	return thread_arena.reserved;
+}
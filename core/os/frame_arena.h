@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Per-thread linear allocator for short-lived buffers, such as the scratch
+// lists built while culling or stepping physics.
+//
+// Allocations are bumped out of a chunk owned by the calling thread and must
+// be freed on that same thread. Freeing the most recent allocation gives its
+// space back immediately, and once every allocation of the thread is freed the
+// arena rewinds to the start of its chunk. At the first rewind of each frame
+// (see begin_frame()) the chunk is also resized to what the previous frame
+// actually needed.
+//
+// Memory should not be kept across frames. It stays valid until freed, but a
+// thread that never drops to zero live allocations never rewinds either.
+
+class FrameArena {
+	static SafeNumeric<uint64_t> frame;
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Called by the main loop at the start of each frame.
+	static void begin_frame();
+	static uint64_t get_frame() { return frame.get(); }
+
+	// Bytes reserved by the arena of the calling thread.
+	static uint64_t get_thread_reserved();
+};
+
+class FrameArenaAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return FrameArena::realloc(p_ptr, p_memory); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { FrameArena::free(p_ptr); }
+};
+
+template <typename T>
+class FrameArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArena::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			p_allocation->~T();
+		}
+		FrameArena::free(p_allocation);
+	}
+	_FORCE_INLINE_ void *alloc_storage(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ void free_storage(void *p_ptr) { FrameArena::free(p_ptr); }
+};
+
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArenaAllocator>;
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameArenaTypedAllocator<HashMapElement<TKey, TValue>>>;
+
+#endif // FRAME_ARENA_H
@@ -31,6 +31,7 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/small_allocator.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
@@ -65,6 +66,31 @@ SafeNumeric<uint64_t> Memory::max_usage;
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
+// Backing allocator, selected with the `small_allocator` build option.
+static _FORCE_INLINE_ void *_raw_alloc(size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	return SmallAllocator::alloc(p_bytes);
+#else
+	return malloc(p_bytes);
+#endif
+}
+
+static _FORCE_INLINE_ void *_raw_realloc(void *p_memory, size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	return SmallAllocator::realloc(p_memory, p_bytes);
+#else
+	return realloc(p_memory, p_bytes);
+#endif
+}
+
+static _FORCE_INLINE_ void _raw_free(void *p_memory) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	SmallAllocator::free(p_memory);
+#else
+	free(p_memory);
+#endif
+}
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
@@ -72,7 +98,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+	void *mem = _raw_alloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
@@ -121,12 +147,12 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_raw_free(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_raw_realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -136,7 +162,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + DATA_OFFSET;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_raw_realloc(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -165,9 +191,9 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		_raw_free(mem);
 	} else {
-		free(mem);
+		_raw_free(mem);
 	}
 }
 
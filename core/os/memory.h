@@ -70,6 +70,7 @@ public:
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return Memory::realloc_static(p_ptr, p_memory, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
@@ -219,6 +220,9 @@ public:
 	template <typename... Args>
 	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew(T(p_args...)); }
 	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete(p_allocation); }
+	// Untyped storage for the container itself, such as bucket arrays.
+	_FORCE_INLINE_ void *alloc_storage(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ void free_storage(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
 #endif // MEMORY_H
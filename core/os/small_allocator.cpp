@@ -0,0 +1,518 @@
+/**************************************************************************/
+/*  small_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_allocator.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+namespace {
+
+struct ThreadCache;
+
+// Every block is preceded by a header pointing to the slab it was carved from,
+// or to nullptr when it was allocated directly from the system. The header is
+// padded to alignof(max_align_t) to keep blocks aligned, so it takes 16 bytes
+// on most 64-bit platforms, and a 16 byte block really uses 32 bytes of slab.
+struct Slab {
+	std::atomic<ThreadCache *> owner = { nullptr };
+	std::atomic<void *> remote_free = { nullptr }; // Blocks freed by threads other than the owner.
+	void *local_free = nullptr;
+	Slab *prev = nullptr;
+	Slab *next = nullptr;
+	uint32_t class_index = 0;
+	uint32_t block_count = 0;
+	uint32_t free_count = 0; // Blocks in `local_free` plus the ones never carved.
+	uint32_t carved_count = 0;
+};
+
+struct SizeClass {
+	Slab *current = nullptr; // Ring of the slabs owned for this class.
+};
+
+struct ThreadCache {
+	SizeClass classes[SmallAllocator::CLASS_COUNT];
+	// Only ever written by the owning thread, read by the statistics getters.
+	std::atomic<uint64_t> alloc_count[SmallAllocator::CLASS_COUNT] = {};
+	std::atomic<uint64_t> free_count[SmallAllocator::CLASS_COUNT] = {};
+	ThreadCache *prev = nullptr;
+	ThreadCache *next = nullptr;
+};
+
+constexpr size_t _align_up(size_t p_size) {
+	return (p_size + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t);
+}
+
+constexpr size_t HEADER_SIZE = _align_up(sizeof(Slab *));
+constexpr size_t SLAB_HEADER_SIZE = _align_up(sizeof(Slab));
+
+// Registry of the live thread caches, the counters of the ones that exited and
+// the slabs they left behind. Must stay constant-initialized, since allocations
+// happen before and after static initialization of this file.
+SpinLock registry_lock;
+ThreadCache *thread_caches = nullptr;
+uint64_t retired_alloc_count[SmallAllocator::CLASS_COUNT] = {};
+uint64_t retired_free_count[SmallAllocator::CLASS_COUNT] = {};
+Slab *orphan_slabs[SmallAllocator::CLASS_COUNT] = {};
+std::atomic<uint32_t> orphan_slab_count[SmallAllocator::CLASS_COUNT] = {};
+std::atomic<uint64_t> stray_free_count[SmallAllocator::CLASS_COUNT] = {};
+std::atomic<uint64_t> slab_count[SmallAllocator::CLASS_COUNT] = {};
+
+void _retire_thread_cache();
+
+struct ThreadCacheRetirer {
+	bool active = false;
+
+	~ThreadCacheRetirer() {
+		if (active) {
+			_retire_thread_cache();
+		}
+	}
+};
+
+thread_local ThreadCache *thread_cache = nullptr;
+thread_local bool thread_cache_retired = false;
+thread_local ThreadCacheRetirer thread_cache_retirer;
+
+_FORCE_INLINE_ uint32_t _get_class_index(size_t p_bytes) {
+	uint32_t index = 0;
+	size_t size = SmallAllocator::MIN_SMALL_SIZE;
+	while (size < p_bytes) {
+		size <<= 1;
+		index++;
+	}
+	return index;
+}
+
+_FORCE_INLINE_ size_t _get_block_stride(uint32_t p_class) {
+	return ((size_t)SmallAllocator::MIN_SMALL_SIZE << p_class) + HEADER_SIZE;
+}
+
+_FORCE_INLINE_ Slab *&_get_block_slab(void *p_block) {
+	return *(Slab **)((uint8_t *)p_block - HEADER_SIZE);
+}
+
+_FORCE_INLINE_ void *&_get_next_free(void *p_block) {
+	return *(void **)p_block;
+}
+
+_FORCE_INLINE_ void _increment_owned(std::atomic<uint64_t> &p_counter) {
+	// Single writer, so a plain store avoids a locked instruction.
+	p_counter.store(p_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void _drain_remote_free(Slab *p_slab) {
+	void *block = p_slab->remote_free.exchange(nullptr, std::memory_order_acquire);
+	while (block) {
+		void *next = _get_next_free(block);
+		_get_next_free(block) = p_slab->local_free;
+		p_slab->local_free = block;
+		p_slab->free_count++;
+		block = next;
+	}
+}
+
+_FORCE_INLINE_ bool _slab_has_free(const Slab *p_slab) {
+	return p_slab->free_count > 0;
+}
+
+void _link_slab(SizeClass &p_size_class, Slab *p_slab) {
+	Slab *current = p_size_class.current;
+	if (current) {
+		p_slab->prev = current;
+		p_slab->next = current->next;
+		current->next->prev = p_slab;
+		current->next = p_slab;
+	} else {
+		p_slab->prev = p_slab;
+		p_slab->next = p_slab;
+	}
+	p_size_class.current = p_slab;
+}
+
+void _unlink_slab(SizeClass &p_size_class, Slab *p_slab) {
+	if (p_slab->next == p_slab) {
+		p_size_class.current = nullptr;
+	} else {
+		p_slab->prev->next = p_slab->next;
+		p_slab->next->prev = p_slab->prev;
+		if (p_size_class.current == p_slab) {
+			p_size_class.current = p_slab->next;
+		}
+	}
+}
+
+Slab *_create_slab(ThreadCache *p_cache, uint32_t p_class) {
+	void *mem = ::malloc(SmallAllocator::SLAB_SIZE);
+	if (!mem) {
+		return nullptr;
+	}
+	Slab *slab = memnew_placement(mem, Slab);
+	slab->class_index = p_class;
+	slab->block_count = (SmallAllocator::SLAB_SIZE - SLAB_HEADER_SIZE) / _get_block_stride(p_class);
+	slab->free_count = slab->block_count;
+	slab->owner.store(p_cache, std::memory_order_relaxed);
+	slab_count[p_class].fetch_add(1, std::memory_order_relaxed);
+	return slab;
+}
+
+void _destroy_slab(Slab *p_slab) {
+	slab_count[p_slab->class_index].fetch_sub(1, std::memory_order_relaxed);
+	p_slab->~Slab();
+	::free(p_slab);
+}
+
+Slab *_adopt_orphan_slab(ThreadCache *p_cache, uint32_t p_class) {
+	if (orphan_slab_count[p_class].load(std::memory_order_relaxed) == 0) {
+		return nullptr;
+	}
+
+	registry_lock.lock();
+	Slab *slab = orphan_slabs[p_class];
+	if (slab) {
+		orphan_slabs[p_class] = slab->next;
+		orphan_slab_count[p_class].fetch_sub(1, std::memory_order_relaxed);
+	}
+	registry_lock.unlock();
+
+	if (slab) {
+		slab->owner.store(p_cache, std::memory_order_release);
+		_drain_remote_free(slab);
+	}
+	return slab;
+}
+
+// Releases orphaned slabs whose blocks have all been freed by other threads
+// in the meantime. Orphans are only reachable through the registry, so they
+// can be drained by whoever holds the lock.
+void _trim_orphan_slabs() {
+	Slab *released = nullptr;
+
+	registry_lock.lock();
+	for (uint32_t i = 0; i < SmallAllocator::CLASS_COUNT; i++) {
+		Slab **prev_next = &orphan_slabs[i];
+		while (*prev_next) {
+			Slab *slab = *prev_next;
+			_drain_remote_free(slab);
+			if (slab->free_count == slab->block_count) {
+				*prev_next = slab->next;
+				orphan_slab_count[i].fetch_sub(1, std::memory_order_relaxed);
+				slab->next = released;
+				released = slab;
+			} else {
+				prev_next = &slab->next;
+			}
+		}
+	}
+	registry_lock.unlock();
+
+	while (released) {
+		Slab *next = released->next;
+		_destroy_slab(released);
+		released = next;
+	}
+}
+
+// Called when the current slab of the class is exhausted. Reclaims blocks
+// freed by other threads, then moves on to other owned slabs, orphaned slabs
+// and finally a fresh one.
+Slab *_find_slab(ThreadCache *p_cache, uint32_t p_class) {
+	SizeClass &size_class = p_cache->classes[p_class];
+	Slab *current = size_class.current;
+
+	if (current) {
+		Slab *slab = current;
+		do {
+			if (slab->remote_free.load(std::memory_order_relaxed)) {
+				_drain_remote_free(slab);
+			}
+			if (_slab_has_free(slab)) {
+				size_class.current = slab;
+				return slab;
+			}
+			slab = slab->next;
+		} while (slab != current);
+	}
+
+	while (true) {
+		Slab *slab = _adopt_orphan_slab(p_cache, p_class);
+		if (!slab) {
+			slab = _create_slab(p_cache, p_class);
+			if (!slab) {
+				return nullptr;
+			}
+		}
+		// Orphans may still be full, they join the ring either way.
+		_link_slab(size_class, slab);
+		if (_slab_has_free(slab)) {
+			return slab;
+		}
+	}
+}
+
+ThreadCache *_create_thread_cache() {
+	if (thread_cache_retired) {
+		// Thread is shutting down, let the remaining allocations go to the system.
+		return nullptr;
+	}
+
+	void *mem = ::malloc(sizeof(ThreadCache));
+	if (!mem) {
+		return nullptr;
+	}
+	ThreadCache *cache = memnew_placement(mem, ThreadCache);
+
+	registry_lock.lock();
+	cache->next = thread_caches;
+	if (thread_caches) {
+		thread_caches->prev = cache;
+	}
+	thread_caches = cache;
+	registry_lock.unlock();
+
+	thread_cache = cache;
+	thread_cache_retirer.active = true;
+	return cache;
+}
+
+void _retire_thread_cache() {
+	ThreadCache *cache = thread_cache;
+	thread_cache = nullptr;
+	thread_cache_retired = true;
+	if (!cache) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < SmallAllocator::CLASS_COUNT; i++) {
+		Slab *first = cache->classes[i].current;
+		if (!first) {
+			continue;
+		}
+		Slab *slab = first;
+		do {
+			Slab *next = slab->next;
+			// From now on, every free to this slab goes through the remote queue.
+			slab->owner.store(nullptr, std::memory_order_release);
+			_drain_remote_free(slab);
+			if (slab->free_count == slab->block_count) {
+				_destroy_slab(slab);
+			} else {
+				registry_lock.lock();
+				slab->next = orphan_slabs[i];
+				orphan_slabs[i] = slab;
+				orphan_slab_count[i].fetch_add(1, std::memory_order_relaxed);
+				registry_lock.unlock();
+			}
+			slab = next;
+		} while (slab != first);
+	}
+
+	registry_lock.lock();
+	if (cache->prev) {
+		cache->prev->next = cache->next;
+	} else {
+		thread_caches = cache->next;
+	}
+	if (cache->next) {
+		cache->next->prev = cache->prev;
+	}
+	for (uint32_t i = 0; i < SmallAllocator::CLASS_COUNT; i++) {
+		retired_alloc_count[i] += cache->alloc_count[i].load(std::memory_order_relaxed);
+		retired_free_count[i] += cache->free_count[i].load(std::memory_order_relaxed);
+	}
+	registry_lock.unlock();
+
+	cache->~ThreadCache();
+	::free(cache);
+
+	_trim_orphan_slabs();
+}
+
+void *_alloc_large(size_t p_bytes) {
+	uint8_t *mem = (uint8_t *)::malloc(p_bytes + HEADER_SIZE);
+	if (!mem) {
+		return nullptr;
+	}
+	*(Slab **)mem = nullptr;
+	return mem + HEADER_SIZE;
+}
+
+} // namespace
+
+void *SmallAllocator::alloc(size_t p_bytes) {
+	if (p_bytes > MAX_SMALL_SIZE) {
+		return _alloc_large(p_bytes);
+	}
+
+	ThreadCache *cache = thread_cache;
+	if (unlikely(!cache)) {
+		cache = _create_thread_cache();
+		if (!cache) {
+			return _alloc_large(p_bytes);
+		}
+	}
+
+	uint32_t class_index = _get_class_index(p_bytes);
+	Slab *slab = cache->classes[class_index].current;
+	if (unlikely(!slab || !_slab_has_free(slab))) {
+		slab = _find_slab(cache, class_index);
+		if (!slab) {
+			return nullptr;
+		}
+	}
+
+	void *block = slab->local_free;
+	if (block) {
+		slab->local_free = _get_next_free(block);
+	} else {
+		block = (uint8_t *)slab + SLAB_HEADER_SIZE + slab->carved_count * _get_block_stride(class_index) + HEADER_SIZE;
+		_get_block_slab(block) = slab;
+		slab->carved_count++;
+	}
+	slab->free_count--;
+
+	_increment_owned(cache->alloc_count[class_index]);
+	return block;
+}
+
+void *SmallAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	Slab *slab = _get_block_slab(p_memory);
+	if (!slab) {
+		uint8_t *mem = (uint8_t *)::realloc((uint8_t *)p_memory - HEADER_SIZE, p_bytes + HEADER_SIZE);
+		if (!mem) {
+			return nullptr;
+		}
+		return mem + HEADER_SIZE;
+	}
+
+	uint32_t class_index = slab->class_index;
+	if (p_bytes <= MAX_SMALL_SIZE && _get_class_index(p_bytes) == class_index) {
+		return p_memory;
+	}
+
+	void *new_memory = alloc(p_bytes);
+	if (!new_memory) {
+		return nullptr;
+	}
+	memcpy(new_memory, p_memory, MIN(p_bytes, get_class_size(class_index)));
+	free(p_memory);
+	return new_memory;
+}
+
+void SmallAllocator::free(void *p_memory) {
+	if (p_memory == nullptr) {
+		return;
+	}
+
+	Slab *slab = _get_block_slab(p_memory);
+	if (!slab) {
+		::free((uint8_t *)p_memory - HEADER_SIZE);
+		return;
+	}
+
+	uint32_t class_index = slab->class_index;
+	ThreadCache *cache = thread_cache;
+
+	if (cache && slab->owner.load(std::memory_order_acquire) == cache) {
+		_increment_owned(cache->free_count[class_index]);
+
+		_get_next_free(p_memory) = slab->local_free;
+		slab->local_free = p_memory;
+		slab->free_count++;
+
+		SizeClass &size_class = cache->classes[class_index];
+		if (slab->free_count == slab->block_count && slab != size_class.current) {
+			_unlink_slab(size_class, slab);
+			_destroy_slab(slab);
+		}
+		return;
+	}
+
+	if (cache) {
+		_increment_owned(cache->free_count[class_index]);
+	} else {
+		stray_free_count[class_index].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// The slab may be released by its owner as soon as the block is pushed,
+	// so it must not be touched after this.
+	void *head = slab->remote_free.load(std::memory_order_relaxed);
+	do {
+		_get_next_free(p_memory) = head;
+	} while (!slab->remote_free.compare_exchange_weak(head, p_memory, std::memory_order_release, std::memory_order_relaxed));
+}
+
+uint32_t SmallAllocator::get_class_size(uint32_t p_class) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_class, CLASS_COUNT, 0);
+	return MIN_SMALL_SIZE << p_class;
+}
+
+uint64_t SmallAllocator::get_class_usage(uint32_t p_class) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_class, CLASS_COUNT, 0);
+
+	registry_lock.lock();
+	uint64_t allocs = retired_alloc_count[p_class];
+	uint64_t frees = retired_free_count[p_class];
+	for (ThreadCache *cache = thread_caches; cache; cache = cache->next) {
+		allocs += cache->alloc_count[p_class].load(std::memory_order_relaxed);
+		frees += cache->free_count[p_class].load(std::memory_order_relaxed);
+	}
+	registry_lock.unlock();
+	frees += stray_free_count[p_class].load(std::memory_order_relaxed);
+
+	// Counters of other threads may be observed out of order.
+	return allocs > frees ? (allocs - frees) * get_class_size(p_class) : 0;
+}
+
+uint64_t SmallAllocator::get_class_reserved(uint32_t p_class) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_class, CLASS_COUNT, 0);
+	return slab_count[p_class].load(std::memory_order_relaxed) * SLAB_SIZE;
+}
+
+uint64_t SmallAllocator::get_reserved() {
+	uint64_t reserved = 0;
+	for (uint32_t i = 0; i < CLASS_COUNT; i++) {
+		reserved += get_class_reserved(i);
+	}
+	return reserved;
+}
@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  small_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_ALLOCATOR_H
+#define SMALL_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+// Size-class allocator with per-thread caches, used underneath Memory when the
+// engine is built with `small_allocator=yes`.
+//
+// Requests up to MAX_SMALL_SIZE bytes are rounded up to a power of two and
+// carved out of fixed-size slabs. Every slab is owned by one thread, which
+// allocates and frees its blocks without any synchronization. Blocks freed by
+// other threads are pushed onto a lock-free queue of the slab and reclaimed by
+// the owner the next time it runs out of blocks. Slabs left behind by exited
+// threads are adopted by the next thread that needs one of the same class.
+// Larger requests go straight to the system allocator.
+
+class SmallAllocator {
+public:
+	static constexpr uint32_t MIN_SMALL_SIZE = 16;
+	static constexpr uint32_t MAX_SMALL_SIZE = 1024;
+	static constexpr uint32_t CLASS_COUNT = 7; // 16, 32, ..., 1024.
+	static constexpr uint32_t SLAB_SIZE = 64 * 1024;
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	static uint32_t get_class_size(uint32_t p_class);
+	// Bytes handed out in blocks of the given class which are still alive.
+	static uint64_t get_class_usage(uint32_t p_class);
+	// Bytes of system memory currently held in slabs of the given class.
+	static uint64_t get_class_reserved(uint32_t p_class);
+	static uint64_t get_reserved();
+};
+
+#endif // SMALL_ALLOCATOR_H
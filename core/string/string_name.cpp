@@ -47,6 +47,7 @@ StringName _scs_create(const char *p_chr, bool p_static) {
 
 bool StringName::configured = false;
 Mutex StringName::mutex;
+StringName::TableShard StringName::_table_shards[STRING_TABLE_SHARD_COUNT];
 
 #ifdef DEBUG_ENABLED
 bool StringName::debug_stringname = false;
@@ -120,8 +121,8 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
-
+		// Nothing can reference the data anymore, since lookups fail to revive a zero refcount.
+		// Report before locking, as error handlers may create string names themselves.
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->cname));
@@ -129,6 +130,9 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+
+		MutexLock lock(_get_table_mutex(_data->idx));
+
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
@@ -216,12 +220,11 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -275,12 +278,11 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
-
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -335,11 +337,11 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_data = _table[idx];
 
 	while (_data) {
@@ -393,11 +395,11 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -429,12 +431,11 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -455,12 +456,11 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
-
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
+	MutexLock lock(_get_table_mutex(idx));
+
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -48,7 +48,10 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARD_COUNT = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARD_COUNT - 1
 	};
 
 	struct _Data {
@@ -75,7 +78,16 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
+	static Mutex mutex; // Guards static class name assignment, the table itself uses the shard mutexes.
+
+	// Each bucket of the table is guarded by one of these, so threads interning
+	// different names rarely wait on each other.
+	struct alignas(64) TableShard {
+		Mutex mutex;
+	};
+	static TableShard _table_shards[STRING_TABLE_SHARD_COUNT];
+	_FORCE_INLINE_ static Mutex &_get_table_mutex(uint32_t p_idx) { return _table_shards[p_idx & STRING_TABLE_SHARD_MASK].mutex; }
+
 	static void setup();
 	static void cleanup();
 	static bool configured;
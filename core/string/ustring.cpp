@@ -34,6 +34,7 @@
 #include "core/math/color.h"
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/string/string_name.h"
 #include "core/string/translation.h"
@@ -286,6 +287,26 @@ Error String::parse_url(String &r_scheme, String &r_host, int &r_port, String &r
 	return OK;
 }
 
+// Strings of a single Latin-1 character are created constantly (parsers,
+// separators, text editing), so they all share one buffer per character
+// instead of allocating their own. Writers get a private copy through the
+// usual copy-on-write. Never freed, strings may still be built at exit.
+// Only used on the main thread, so worker threads don't all contend on the
+// reference count of the same few buffers.
+static const String *_get_single_char_strings() {
+	static const String *strings = []() {
+		String *table = memnew_arr(String, 256);
+		for (int i = 1; i < 256; i++) {
+			table[i].resize(2);
+			char32_t *dst = table[i].ptrw();
+			dst[0] = i;
+			dst[1] = 0;
+		}
+		return table;
+	}();
+	return strings;
+}
+
 void String::copy_from(const char *p_cstr) {
 	// copy Latin-1 encoded c-string directly
 	if (!p_cstr) {
@@ -300,6 +321,11 @@ void String::copy_from(const char *p_cstr) {
 		return;
 	}
 
+	if (len == 1 && Thread::is_main_thread()) {
+		*this = _get_single_char_strings()[(uint8_t)p_cstr[0]];
+		return;
+	}
+
 	resize(len + 1); // include 0
 
 	char32_t *dst = ptrw();
@@ -337,6 +363,11 @@ void String::copy_from(const char *p_cstr, const int p_clip_to) {
 		return;
 	}
 
+	if (len == 1 && Thread::is_main_thread()) {
+		*this = _get_single_char_strings()[(uint8_t)p_cstr[0]];
+		return;
+	}
+
 	resize(len + 1); // include 0
 
 	char32_t *dst = ptrw();
@@ -383,6 +414,11 @@ void String::copy_from(const char32_t &p_char) {
 		return;
 	}
 
+	if (p_char < 256 && Thread::is_main_thread()) {
+		*this = _get_single_char_strings()[p_char];
+		return;
+	}
+
 	resize(2);
 
 	char32_t *dst = ptrw();
@@ -445,6 +481,11 @@ void String::copy_from(const char32_t *p_cstr, const int p_clip_to) {
 // p_length > 0
 // p_length <= p_char strlen
 void String::copy_from_unchecked(const char32_t *p_char, const int p_length) {
+	if (p_length == 1 && p_char[0] != 0 && p_char[0] < 256 && Thread::is_main_thread()) {
+		*this = _get_single_char_strings()[p_char[0]];
+		return;
+	}
+
 	resize(p_length + 1);
 	char32_t *dst = ptrw();
 	dst[p_length] = 0;
@@ -591,6 +632,11 @@ String &String::operator+=(char32_t p_char) {
 	}
 
 	const int lhs_len = length();
+	if (lhs_len == 0 && p_char < 256 && Thread::is_main_thread()) {
+		*this = _get_single_char_strings()[p_char];
+		return *this;
+	}
+
 	resize(lhs_len + 2);
 	char32_t *dst = ptrw();
 
@@ -0,0 +1,666 @@
+/**************************************************************************/
+/*  dense_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef DENSE_HASH_MAP_H
+#define DENSE_HASH_MAP_H
+
+#include "core/math/math_funcs.h"
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+/**
+ * An insertion ordered HashMap that stores its pairs contiguously.
+ *
+ * Keys and values live in pages of growing size that never move, so inserting
+ * rarely allocates and, like with HashMap, pointers and references to keys and
+ * values stay valid until their pair is erased. An array of pointers to the
+ * pairs keeps them in insertion order, so iterating is a linear scan. A
+ * separate open addressed index with Robin Hood hashing and backward shift
+ * deletion (like HashMap) maps hashes to positions in that array.
+ *
+ * Erasing leaves a hole in the order array, which keeps the order of the
+ * remaining pairs and keeps iterators valid. Holes are skipped when iterating
+ * and are compacted away when the array runs out of room. The memory of the
+ * erased pair is reused by the next insertion.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class DenseHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY_INDEX = 2; // Use a prime.
+	static constexpr float MAX_OCCUPANCY = 0.75;
+	static constexpr uint32_t EMPTY_HASH = 0;
+	static constexpr uint32_t MIN_PAGE_SIZE = 4;
+	static constexpr uint32_t MAX_PAGE_SIZE = 256;
+
+private:
+	// Pairs in pages that never move, filled in order, and erased pairs to reuse.
+	KeyValue<TKey, TValue> **pages = nullptr;
+	uint32_t page_count = 0;
+	uint32_t page_index = 0; // Page being filled.
+	uint32_t page_used = 0;
+	KeyValue<TKey, TValue> **free_pairs = nullptr;
+	uint32_t free_pair_count = 0;
+	uint32_t pair_capacity = 0;
+
+	// Pairs in insertion order, holes are marked with EMPTY_HASH in element_hashes.
+	KeyValue<TKey, TValue> **elements = nullptr;
+	uint32_t *element_hashes = nullptr;
+	uint32_t element_capacity = 0;
+	uint32_t element_count = 0; // Including holes.
+
+	// Index from hashes to positions in the order array.
+	uint32_t *hashes = nullptr;
+	uint32_t *indices = nullptr;
+
+	uint32_t capacity_index = 0;
+	uint32_t num_elements = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_page_size(uint32_t p_page) {
+		return p_page >= 6 ? MAX_PAGE_SIZE : MIN_PAGE_SIZE << p_page;
+	}
+
+	KeyValue<TKey, TValue> *_alloc_pair() {
+		if (free_pair_count > 0) {
+			return free_pairs[--free_pair_count];
+		}
+		if (page_count > 0 && page_used == _get_page_size(page_index)) {
+			page_index++;
+			page_used = 0;
+		}
+		if (page_index == page_count) {
+			const uint32_t page_size = _get_page_size(page_count);
+			pages = reinterpret_cast<KeyValue<TKey, TValue> **>(Memory::realloc_static(pages, sizeof(KeyValue<TKey, TValue> *) * (page_count + 1)));
+			pages[page_count] = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::alloc_static(sizeof(KeyValue<TKey, TValue>) * page_size));
+			page_count++;
+			pair_capacity += page_size;
+			free_pairs = reinterpret_cast<KeyValue<TKey, TValue> **>(Memory::realloc_static(free_pairs, sizeof(KeyValue<TKey, TValue> *) * pair_capacity));
+		}
+		return &pages[page_index][page_used++];
+	}
+
+	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_probe_length(const uint32_t p_pos, const uint32_t p_hash, const uint32_t p_capacity, const uint64_t p_capacity_inv) {
+		const uint32_t original_pos = fastmod(p_hash, p_capacity_inv, p_capacity);
+		return fastmod(p_pos - original_pos + p_capacity, p_capacity_inv, p_capacity);
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (hashes == nullptr || num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t hash = _hash(p_key);
+		uint32_t pos = fastmod(hash, capacity_inv, capacity);
+		uint32_t distance = 0;
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				return false;
+			}
+
+			if (distance > _get_probe_length(pos, hashes[pos], capacity, capacity_inv)) {
+				return false;
+			}
+
+			if (hashes[pos] == hash && Comparator::compare(elements[indices[pos]]->key, p_key)) {
+				r_pos = pos;
+				return true;
+			}
+
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+			distance++;
+		}
+	}
+
+	void _insert_with_hash(uint32_t p_hash, uint32_t p_index) {
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t hash = p_hash;
+		uint32_t index = p_index;
+		uint32_t distance = 0;
+		uint32_t pos = fastmod(hash, capacity_inv, capacity);
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				indices[pos] = index;
+				hashes[pos] = hash;
+				return;
+			}
+
+			// Not an empty slot, let's check the probing length of the existing one.
+			uint32_t existing_probe_len = _get_probe_length(pos, hashes[pos], capacity, capacity_inv);
+			if (existing_probe_len < distance) {
+				SWAP(hash, hashes[pos]);
+				SWAP(index, indices[pos]);
+				distance = existing_probe_len;
+			}
+
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+			distance++;
+		}
+	}
+
+	// Rebuilds the index from the hashes kept next to the pairs.
+	void _resize_and_rehash(uint32_t p_new_capacity_index) {
+		// Capacity can't be 0.
+		p_new_capacity_index = MAX((uint32_t)MIN_CAPACITY_INDEX, p_new_capacity_index);
+
+		if (hashes == nullptr || p_new_capacity_index != capacity_index) {
+			if (hashes != nullptr) {
+				Memory::free_static(hashes);
+				Memory::free_static(indices);
+			}
+			capacity_index = p_new_capacity_index;
+			hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * hash_table_size_primes[capacity_index]));
+			indices = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * hash_table_size_primes[capacity_index]));
+		}
+
+		uint32_t capacity = hash_table_size_primes[capacity_index];
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+
+		for (uint32_t i = 0; i < element_count; i++) {
+			if (element_hashes[i] != EMPTY_HASH) {
+				_insert_with_hash(element_hashes[i], i);
+			}
+		}
+	}
+
+	// Makes room for one more pair at the end of elements, either by closing holes or by growing.
+	void _make_room() {
+		if (element_count - num_elements > 0 && element_count - num_elements >= element_capacity / 4) {
+			uint32_t count = 0;
+			for (uint32_t i = 0; i < element_count; i++) {
+				if (element_hashes[i] == EMPTY_HASH) {
+					continue;
+				}
+				if (i != count) {
+					// Only the order moves, the pairs stay in their pages.
+					elements[count] = elements[i];
+					element_hashes[count] = element_hashes[i];
+				}
+				count++;
+			}
+			element_count = count;
+			_resize_and_rehash(capacity_index);
+			return;
+		}
+
+		element_capacity = MAX(element_capacity * 2, (uint32_t)(hash_table_size_primes[capacity_index] * MAX_OCCUPANCY));
+		elements = reinterpret_cast<KeyValue<TKey, TValue> **>(Memory::realloc_static(elements, sizeof(KeyValue<TKey, TValue> *) * element_capacity));
+		element_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(element_hashes, sizeof(uint32_t) * element_capacity));
+	}
+
+	uint32_t _insert_new(const TKey &p_key, const TValue &p_value) {
+		uint32_t hash = _hash(p_key);
+		typedef KeyValue<TKey, TValue> Element;
+		elements[element_count] = _alloc_pair();
+		memnew_placement(elements[element_count], Element(p_key, p_value));
+		element_hashes[element_count] = hash;
+		_insert_with_hash(hash, element_count);
+		num_elements++;
+		return element_count++;
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			elements[indices[pos]]->value = p_value;
+			return indices[pos];
+		}
+
+		if (unlikely(hashes == nullptr)) {
+			// Allocate on demand to save memory.
+			_resize_and_rehash(capacity_index);
+		}
+
+		if (num_elements + 1 > MAX_OCCUPANCY * hash_table_size_primes[capacity_index]) {
+			ERR_FAIL_COND_V_MSG(capacity_index + 1 == HASH_TABLE_SIZE_MAX, UINT32_MAX, "Hash table maximum capacity reached, aborting insertion.");
+			_resize_and_rehash(capacity_index + 1);
+		}
+
+		if (element_count == element_capacity) {
+			_make_room();
+		}
+
+		return _insert_new(p_key, p_value);
+	}
+
+	_FORCE_INLINE_ uint32_t _first_index(uint32_t p_from) const {
+		while (p_from < element_count && element_hashes[p_from] == EMPTY_HASH) {
+			p_from++;
+		}
+		return p_from;
+	}
+
+	_FORCE_INLINE_ uint32_t _last_index(uint32_t p_from) const {
+		while (p_from < element_count && element_hashes[p_from] == EMPTY_HASH) {
+			p_from--; // Wraps past the first pair, which is then out of range.
+		}
+		return p_from;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return hash_table_size_primes[capacity_index]; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		// The pages are kept, and filled again from the first one.
+		page_index = 0;
+		page_used = 0;
+		free_pair_count = 0;
+
+		if (num_elements == 0) {
+			element_count = 0;
+			return;
+		}
+
+		for (uint32_t i = 0; i < element_count; i++) {
+			if (element_hashes[i] != EMPTY_HASH) {
+				elements[i]->~KeyValue<TKey, TValue>();
+			}
+		}
+
+		uint32_t capacity = hash_table_size_primes[capacity_index];
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+
+		element_count = 0;
+		num_elements = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "DenseHashMap key not found.");
+		return elements[indices[pos]]->value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "DenseHashMap key not found.");
+		return elements[indices[pos]]->value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[indices[pos]]->value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[indices[pos]]->value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		const uint32_t index = indices[pos];
+
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t next_pos = fastmod((pos + 1), capacity_inv, capacity);
+		while (hashes[next_pos] != EMPTY_HASH && _get_probe_length(next_pos, hashes[next_pos], capacity, capacity_inv) != 0) {
+			SWAP(hashes[next_pos], hashes[pos]);
+			SWAP(indices[next_pos], indices[pos]);
+			pos = next_pos;
+			next_pos = fastmod((pos + 1), capacity_inv, capacity);
+		}
+
+		hashes[pos] = EMPTY_HASH;
+
+		elements[index]->~KeyValue<TKey, TValue>();
+		free_pairs[free_pair_count++] = elements[index];
+		element_hashes[index] = EMPTY_HASH;
+		num_elements--;
+
+		// Holes at the end can be reused right away.
+		while (element_count > 0 && element_hashes[element_count - 1] == EMPTY_HASH) {
+			element_count--;
+		}
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		if (p_new_capacity > element_capacity) {
+			element_capacity = p_new_capacity;
+			elements = reinterpret_cast<KeyValue<TKey, TValue> **>(Memory::realloc_static(elements, sizeof(KeyValue<TKey, TValue> *) * element_capacity));
+			element_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(element_hashes, sizeof(uint32_t) * element_capacity));
+		}
+
+		uint32_t new_index = capacity_index;
+
+		while (hash_table_size_primes[new_index] * MAX_OCCUPANCY < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_index + 1 == (uint32_t)HASH_TABLE_SIZE_MAX, nullptr);
+			new_index++;
+		}
+
+		if (new_index == capacity_index) {
+			return;
+		}
+
+		if (hashes == nullptr) {
+			capacity_index = new_index;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_index);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return *map->elements[index];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return map->elements[index]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (map) {
+				index = map->_first_index(index + 1);
+				if (index >= map->element_count) {
+					map = nullptr;
+					index = 0;
+				}
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			if (map) {
+				index = map->_last_index(index - 1);
+				if (index >= map->element_count) {
+					map = nullptr;
+					index = 0;
+				}
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return map == b.map && index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return map != b.map || index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const DenseHashMap *p_map, uint32_t p_index) {
+			if (p_map && p_index < p_map->element_count) {
+				map = p_map;
+				index = p_index;
+			}
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+
+	private:
+		const DenseHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return *map->elements[index];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return map->elements[index]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (map) {
+				index = map->_first_index(index + 1);
+				if (index >= map->element_count) {
+					map = nullptr;
+					index = 0;
+				}
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			if (map) {
+				index = map->_last_index(index - 1);
+				if (index >= map->element_count) {
+					map = nullptr;
+					index = 0;
+				}
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return map == b.map && index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return map != b.map || index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr;
+		}
+
+		_FORCE_INLINE_ Iterator(DenseHashMap *p_map, uint32_t p_index) {
+			if (p_map && p_index < p_map->element_count) {
+				map = p_map;
+				index = p_index;
+			}
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, index);
+		}
+
+	private:
+		DenseHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _first_index(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator();
+	}
+	_FORCE_INLINE_ Iterator last() {
+		return Iterator(this, element_count - 1);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(this, indices[pos]);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _first_index(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator();
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		return ConstIterator(this, element_count - 1);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(this, indices[pos]);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return elements[indices[pos]]->value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			const uint32_t index = _insert(p_key, TValue());
+			return elements[index]->value;
+		} else {
+			return elements[indices[pos]]->value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		return Iterator(this, _insert(p_key, p_value));
+	}
+
+	/* Constructors */
+
+	DenseHashMap(const DenseHashMap &p_other) {
+		capacity_index = MIN_CAPACITY_INDEX;
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const DenseHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	DenseHashMap(uint32_t p_initial_capacity) {
+		// Capacity can't be 0.
+		capacity_index = MIN_CAPACITY_INDEX;
+		reserve(p_initial_capacity);
+	}
+	DenseHashMap() {
+		capacity_index = MIN_CAPACITY_INDEX;
+	}
+
+	~DenseHashMap() {
+		clear();
+
+		if (elements != nullptr) {
+			Memory::free_static(elements);
+			Memory::free_static(element_hashes);
+		}
+		for (uint32_t i = 0; i < page_count; i++) {
+			Memory::free_static(pages[i]);
+		}
+		if (pages != nullptr) {
+			Memory::free_static(pages);
+			Memory::free_static(free_pairs);
+		}
+		if (hashes != nullptr) {
+			Memory::free_static(hashes);
+			Memory::free_static(indices);
+		}
+	}
+};
+
+#endif // DENSE_HASH_MAP_H
@@ -169,8 +169,8 @@ private:
 		uint32_t *old_hashes = hashes;
 
 		num_elements = 0;
-		hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
-		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+		hashes = reinterpret_cast<uint32_t *>(element_alloc.alloc_storage(sizeof(uint32_t) * capacity));
+		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(element_alloc.alloc_storage(sizeof(HashMapElement<TKey, TValue> *) * capacity));
 
 		for (uint32_t i = 0; i < capacity; i++) {
 			hashes[i] = 0;
@@ -190,8 +190,8 @@ private:
 			_insert_with_hash(old_hashes[i], old_elements[i]);
 		}
 
-		Memory::free_static(old_elements);
-		Memory::free_static(old_hashes);
+		element_alloc.free_storage(old_elements);
+		element_alloc.free_storage(old_hashes);
 	}
 
 	_FORCE_INLINE_ HashMapElement<TKey, TValue> *_insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
@@ -199,8 +199,8 @@ private:
 		if (unlikely(elements == nullptr)) {
 			// Allocate on demand to save memory.
 
-			hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
-			elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+			hashes = reinterpret_cast<uint32_t *>(element_alloc.alloc_storage(sizeof(uint32_t) * capacity));
+			elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(element_alloc.alloc_storage(sizeof(HashMapElement<TKey, TValue> *) * capacity));
 
 			for (uint32_t i = 0; i < capacity; i++) {
 				hashes[i] = EMPTY_HASH;
@@ -616,8 +616,8 @@ public:
 		clear();
 
 		if (elements != nullptr) {
-			Memory::free_static(elements);
-			Memory::free_static(hashes);
+			element_alloc.free_storage(elements);
+			element_alloc.free_storage(hashes);
 		}
 	}
 };
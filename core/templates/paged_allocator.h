@@ -98,6 +98,9 @@ public:
 	template <typename... Args>
 	T *new_allocation(Args &&...p_args) { return alloc(p_args...); }
 	void delete_allocation(T *p_mem) { free(p_mem); }
+	// Untyped storage for the container itself, such as bucket arrays.
+	void *alloc_storage(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	void free_storage(void *p_ptr) { Memory::free_static(p_ptr, false); }
 
 private:
 	void _reset(bool p_allow_unfreed) {
@@ -47,6 +47,7 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -3906,6 +3907,8 @@ static uint64_t navigation_process_max = 0;
 bool Main::iteration() {
 	iterating++;
 
+	FrameArena::begin_frame();
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
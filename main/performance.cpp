@@ -31,6 +31,7 @@
 #include "performance.h"
 
 #include "core/os/os.h"
+#include "core/os/small_allocator.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
@@ -89,6 +90,14 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_16);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_32);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_64);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_128);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_256);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_512);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_1024);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_RESERVED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -139,6 +148,14 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"memory/small_alloc_16",
+		"memory/small_alloc_32",
+		"memory/small_alloc_64",
+		"memory/small_alloc_128",
+		"memory/small_alloc_256",
+		"memory/small_alloc_512",
+		"memory/small_alloc_1024",
+		"memory/small_alloc_reserved",
 
 	};
 
@@ -223,6 +240,16 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MEMORY_SMALL_ALLOC_16:
+		case MEMORY_SMALL_ALLOC_32:
+		case MEMORY_SMALL_ALLOC_64:
+		case MEMORY_SMALL_ALLOC_128:
+		case MEMORY_SMALL_ALLOC_256:
+		case MEMORY_SMALL_ALLOC_512:
+		case MEMORY_SMALL_ALLOC_1024:
+			return SmallAllocator::get_class_usage(p_monitor - MEMORY_SMALL_ALLOC_16);
+		case MEMORY_SMALL_ALLOC_RESERVED:
+			return SmallAllocator::get_reserved();
 
 		default: {
 		}
@@ -270,6 +297,14 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
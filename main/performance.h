@@ -100,6 +100,14 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MEMORY_SMALL_ALLOC_16,
+		MEMORY_SMALL_ALLOC_32,
+		MEMORY_SMALL_ALLOC_64,
+		MEMORY_SMALL_ALLOC_128,
+		MEMORY_SMALL_ALLOC_256,
+		MEMORY_SMALL_ALLOC_512,
+		MEMORY_SMALL_ALLOC_1024,
+		MEMORY_SMALL_ALLOC_RESERVED,
 		MONITOR_MAX
 	};
 
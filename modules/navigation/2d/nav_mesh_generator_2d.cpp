@@ -228,108 +228,245 @@ void NavMeshGenerator2D::generator_thread_bake(void *p_arg) {
 	generator_task->status = NavMeshGeneratorTask2D::TaskStatus::BAKING_FINISHED;
 }
 
-void NavMeshGenerator2D::generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node, bool p_recurse_children) {
-	generator_parse_meshinstance2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_multimeshinstance2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_polygon2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_staticbody2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_tilemap_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_navigationobstacle_node(p_navigation_mesh, p_source_geometry_data, p_node);
+void NavMeshGenerator2D::generator_thread_parse_chunk(void *p_arg, uint32_t p_index) {
+	NavMeshGeometryParseData2D *parse_data = static_cast<NavMeshGeometryParseData2D *>(p_arg);
+	const Ref<NavigationMeshSourceGeometryData2D> &chunk = parse_data->chunks[p_index];
 
-	if (p_recurse_children) {
-		for (int i = 0; i < p_node->get_child_count(); i++) {
-			generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, p_node->get_child(i), p_recurse_children);
-		}
-	}
-}
+	const uint32_t item_count = parse_data->items.size();
+	const uint32_t chunk_count = parse_data->chunks.size();
+	const uint32_t from = item_count * p_index / chunk_count;
+	const uint32_t to = item_count * (p_index + 1) / chunk_count;
 
-void NavMeshGenerator2D::generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
-	MeshInstance2D *mesh_instance = Object::cast_to<MeshInstance2D>(p_node);
+	for (uint32_t item_index = from; item_index < to; item_index++) {
+		const NavMeshGeometryParseItem2D &item = parse_data->items[item_index];
 
-	if (mesh_instance == nullptr) {
-		return;
-	}
+		switch (item.type) {
+			case NavMeshGeometryParseItem2D::ITEM_TYPE_OBSTRUCTION_OUTLINE:
+			case NavMeshGeometryParseItem2D::ITEM_TYPE_TRAVERSABLE_OUTLINE: {
+				const Transform2D &outline_xform = item.transforms[0];
 
-	NavigationPolygon::ParsedGeometryType parsed_geometry_type = p_navigation_mesh->get_parsed_geometry_type();
+				Vector<Vector2> shape_outline;
+				shape_outline.resize(item.outline.size());
 
-	if (!(parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_BOTH)) {
-		return;
-	}
+				const Vector2 *outline_ptr = item.outline.ptr();
+				Vector2 *shape_outline_ptrw = shape_outline.ptrw();
 
-	Ref<Mesh> mesh = mesh_instance->get_mesh();
-	if (!mesh.is_valid()) {
-		return;
+				for (int i = 0; i < shape_outline.size(); i++) {
+					shape_outline_ptrw[i] = outline_xform.xform(outline_ptr[i]);
+				}
+
+				if (item.type == NavMeshGeometryParseItem2D::ITEM_TYPE_TRAVERSABLE_OUTLINE) {
+					chunk->_add_traversable_outline(shape_outline);
+				} else {
+					chunk->_add_obstruction_outline(shape_outline);
+				}
+			} break;
+			case NavMeshGeometryParseItem2D::ITEM_TYPE_SHAPE: {
+				const Transform2D &static_body_xform = item.transforms[0];
+
+				RectangleShape2D *rectangle_shape = Object::cast_to<RectangleShape2D>(*item.shape);
+				if (rectangle_shape) {
+					Vector<Vector2> shape_outline;
+
+					const Vector2 &rectangle_size = rectangle_shape->get_size();
+
+					shape_outline.resize(5);
+					shape_outline.write[0] = static_body_xform.xform(-rectangle_size * 0.5);
+					shape_outline.write[1] = static_body_xform.xform(Vector2(rectangle_size.x, -rectangle_size.y) * 0.5);
+					shape_outline.write[2] = static_body_xform.xform(rectangle_size * 0.5);
+					shape_outline.write[3] = static_body_xform.xform(Vector2(-rectangle_size.x, rectangle_size.y) * 0.5);
+					shape_outline.write[4] = static_body_xform.xform(-rectangle_size * 0.5);
+
+					chunk->_add_obstruction_outline(shape_outline);
+				}
+
+				CapsuleShape2D *capsule_shape = Object::cast_to<CapsuleShape2D>(*item.shape);
+				if (capsule_shape) {
+					const real_t capsule_height = capsule_shape->get_height();
+					const real_t capsule_radius = capsule_shape->get_radius();
+
+					Vector<Vector2> shape_outline;
+					const real_t turn_step = Math_TAU / 12.0;
+					shape_outline.resize(14);
+					int shape_outline_inx = 0;
+					for (int i = 0; i < 12; i++) {
+						Vector2 ofs = Vector2(0, (i > 3 && i <= 9) ? -capsule_height * 0.5 + capsule_radius : capsule_height * 0.5 - capsule_radius);
+
+						shape_outline.write[shape_outline_inx] = static_body_xform.xform(Vector2(Math::sin(i * turn_step), Math::cos(i * turn_step)) * capsule_radius + ofs);
+						shape_outline_inx += 1;
+						if (i == 3 || i == 9) {
+							shape_outline.write[shape_outline_inx] = static_body_xform.xform(Vector2(Math::sin(i * turn_step), Math::cos(i * turn_step)) * capsule_radius - ofs);
+							shape_outline_inx += 1;
+						}
+					}
+
+					chunk->_add_obstruction_outline(shape_outline);
+				}
+
+				CircleShape2D *circle_shape = Object::cast_to<CircleShape2D>(*item.shape);
+				if (circle_shape) {
+					const real_t circle_radius = circle_shape->get_radius();
+
+					Vector<Vector2> shape_outline;
+					int circle_edge_count = 12;
+					shape_outline.resize(circle_edge_count);
+
+					const real_t turn_step = Math_TAU / real_t(circle_edge_count);
+					for (int i = 0; i < circle_edge_count; i++) {
+						shape_outline.write[i] = static_body_xform.xform(Vector2(Math::cos(i * turn_step), Math::sin(i * turn_step)) * circle_radius);
+					}
+
+					chunk->_add_obstruction_outline(shape_outline);
+				}
+
+				ConcavePolygonShape2D *concave_polygon_shape = Object::cast_to<ConcavePolygonShape2D>(*item.shape);
+				if (concave_polygon_shape) {
+					Vector<Vector2> shape_outline = concave_polygon_shape->get_segments();
+
+					for (int i = 0; i < shape_outline.size(); i++) {
+						shape_outline.write[i] = static_body_xform.xform(shape_outline[i]);
+					}
+
+					chunk->_add_obstruction_outline(shape_outline);
+				}
+
+				ConvexPolygonShape2D *convex_polygon_shape = Object::cast_to<ConvexPolygonShape2D>(*item.shape);
+				if (convex_polygon_shape) {
+					Vector<Vector2> shape_outline = convex_polygon_shape->get_points();
+
+					for (int i = 0; i < shape_outline.size(); i++) {
+						shape_outline.write[i] = static_body_xform.xform(shape_outline[i]);
+					}
+
+					chunk->_add_obstruction_outline(shape_outline);
+				}
+			} break;
+			case NavMeshGeometryParseItem2D::ITEM_TYPE_MESH: {
+				using namespace Clipper2Lib;
+
+				Paths64 subject_paths, dummy_clip_paths;
+
+				for (const Vector<Vector2> &mesh_surface : *item.mesh_surfaces) {
+					Path64 subject_path;
+					for (const Vector2 &vertex : mesh_surface) {
+						const Point64 &point = Point64(vertex.x, vertex.y);
+						subject_path.push_back(point);
+					}
+					subject_paths.push_back(subject_path);
+				}
+
+				Paths64 path_solution = Union(subject_paths, dummy_clip_paths, FillRule::NonZero);
+
+				//path_solution = RamerDouglasPeucker(path_solution, 0.025);
+
+				for (const Transform2D &mesh_instance_xform : item.transforms) {
+					for (const Path64 &scaled_path : path_solution) {
+						Vector<Vector2> shape_outline;
+						for (const Point64 &scaled_point : scaled_path) {
+							shape_outline.push_back(Point2(static_cast<real_t>(scaled_point.x), static_cast<real_t>(scaled_point.y)));
+						}
+
+						for (int i = 0; i < shape_outline.size(); i++) {
+							shape_outline.write[i] = mesh_instance_xform.xform(shape_outline[i]);
+						}
+
+						chunk->_add_obstruction_outline(shape_outline);
+					}
+				}
+			} break;
+		}
 	}
+}
 
-	const Transform2D mesh_instance_xform = p_source_geometry_data->root_node_transform * mesh_instance->get_global_transform();
+void NavMeshGenerator2D::generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node, bool p_recurse_children) {
+	generator_parse_meshinstance2d_node(p_navigation_mesh, r_parse_data, p_node);
+	generator_parse_multimeshinstance2d_node(p_navigation_mesh, r_parse_data, p_node);
+	generator_parse_polygon2d_node(p_navigation_mesh, r_parse_data, p_node);
+	generator_parse_staticbody2d_node(p_navigation_mesh, r_parse_data, p_node);
+	generator_parse_tilemap_node(p_navigation_mesh, r_parse_data, p_node);
+	generator_parse_navigationobstacle_node(p_navigation_mesh, r_parse_data, p_node);
 
-	using namespace Clipper2Lib;
+	if (p_recurse_children) {
+		for (int i = 0; i < p_node->get_child_count(); i++) {
+			generator_parse_geometry_node(p_navigation_mesh, r_parse_data, p_node->get_child(i), p_recurse_children);
+		}
+	}
+}
 
-	Paths64 subject_paths, dummy_clip_paths;
+const LocalVector<Vector<Vector2>> *NavMeshGenerator2D::generator_parse_mesh(NavMeshGeometryParseData2D &r_parse_data, const Ref<Mesh> &p_mesh) {
+	const LocalVector<Vector<Vector2>> *mesh_surfaces = r_parse_data.mesh_surfaces.getptr(p_mesh);
+	if (mesh_surfaces) {
+		return mesh_surfaces;
+	}
+
+	LocalVector<Vector<Vector2>> &surfaces = r_parse_data.mesh_surfaces[p_mesh];
 
-	for (int i = 0; i < mesh->get_surface_count(); i++) {
-		if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
+		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
 			continue;
 		}
 
-		if (!(mesh->surface_get_format(i) & Mesh::ARRAY_FLAG_USE_2D_VERTICES)) {
+		if (!(p_mesh->surface_get_format(i) & Mesh::ARRAY_FLAG_USE_2D_VERTICES)) {
 			continue;
 		}
 
-		Path64 subject_path;
-
 		int index_count = 0;
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			index_count = mesh->surface_get_array_index_len(i);
+		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
+			index_count = p_mesh->surface_get_array_index_len(i);
 		} else {
-			index_count = mesh->surface_get_array_len(i);
+			index_count = p_mesh->surface_get_array_len(i);
 		}
 
 		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
 
-		Array a = mesh->surface_get_arrays(i);
+		Array a = p_mesh->surface_get_arrays(i);
 
 		Vector<Vector2> mesh_vertices = a[Mesh::ARRAY_VERTEX];
 
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
+		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
 			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
-			for (int vertex_index : mesh_indices) {
-				const Vector2 &vertex = mesh_vertices[vertex_index];
-				const Point64 &point = Point64(vertex.x, vertex.y);
-				subject_path.push_back(point);
+
+			Vector<Vector2> surface_vertices;
+			surface_vertices.resize(mesh_indices.size());
+			Vector2 *surface_vertices_ptrw = surface_vertices.ptrw();
+			for (int j = 0; j < mesh_indices.size(); j++) {
+				surface_vertices_ptrw[j] = mesh_vertices[mesh_indices[j]];
 			}
+			surfaces.push_back(surface_vertices);
 		} else {
-			for (const Vector2 &vertex : mesh_vertices) {
-				const Point64 &point = Point64(vertex.x, vertex.y);
-				subject_path.push_back(point);
-			}
+			surfaces.push_back(mesh_vertices);
 		}
-		subject_paths.push_back(subject_path);
 	}
 
-	Paths64 path_solution;
-
-	path_solution = Union(subject_paths, dummy_clip_paths, FillRule::NonZero);
+	return &surfaces;
+}
 
-	//path_solution = RamerDouglasPeucker(path_solution, 0.025);
+void NavMeshGenerator2D::generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node) {
+	MeshInstance2D *mesh_instance = Object::cast_to<MeshInstance2D>(p_node);
 
-	Vector<Vector<Vector2>> polypaths;
+	if (mesh_instance == nullptr) {
+		return;
+	}
 
-	for (const Path64 &scaled_path : path_solution) {
-		Vector<Vector2> shape_outline;
-		for (const Point64 &scaled_point : scaled_path) {
-			shape_outline.push_back(Point2(static_cast<real_t>(scaled_point.x), static_cast<real_t>(scaled_point.y)));
-		}
+	NavigationPolygon::ParsedGeometryType parsed_geometry_type = p_navigation_mesh->get_parsed_geometry_type();
 
-		for (int i = 0; i < shape_outline.size(); i++) {
-			shape_outline.write[i] = mesh_instance_xform.xform(shape_outline[i]);
-		}
+	if (!(parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_BOTH)) {
+		return;
+	}
 
-		p_source_geometry_data->add_obstruction_outline(shape_outline);
+	Ref<Mesh> mesh = mesh_instance->get_mesh();
+	if (!mesh.is_valid()) {
+		return;
 	}
+
+	NavMeshGeometryParseItem2D item;
+	item.type = NavMeshGeometryParseItem2D::ITEM_TYPE_MESH;
+	item.transforms.push_back(r_parse_data.source_geometry_data->root_node_transform * mesh_instance->get_global_transform());
+	item.mesh_surfaces = generator_parse_mesh(r_parse_data, mesh);
+	r_parse_data.items.push_back(item);
 }
 
-void NavMeshGenerator2D::generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator2D::generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node) {
 	MultiMeshInstance2D *multimesh_instance = Object::cast_to<MultiMeshInstance2D>(p_node);
 
 	if (multimesh_instance == nullptr) {
@@ -351,80 +488,25 @@ void NavMeshGenerator2D::generator_parse_multimeshinstance2d_node(const Ref<Navi
 		return;
 	}
 
-	using namespace Clipper2Lib;
-
-	Paths64 mesh_subject_paths, dummy_clip_paths;
-
-	for (int i = 0; i < mesh->get_surface_count(); i++) {
-		if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
-			continue;
-		}
-
-		if (!(mesh->surface_get_format(i) & Mesh::ARRAY_FLAG_USE_2D_VERTICES)) {
-			continue;
-		}
-
-		Path64 subject_path;
-
-		int index_count = 0;
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			index_count = mesh->surface_get_array_index_len(i);
-		} else {
-			index_count = mesh->surface_get_array_len(i);
-		}
-
-		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
-
-		Array a = mesh->surface_get_arrays(i);
-
-		Vector<Vector2> mesh_vertices = a[Mesh::ARRAY_VERTEX];
-
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
-			for (int vertex_index : mesh_indices) {
-				const Vector2 &vertex = mesh_vertices[vertex_index];
-				const Point64 &point = Point64(vertex.x, vertex.y);
-				subject_path.push_back(point);
-			}
-		} else {
-			for (const Vector2 &vertex : mesh_vertices) {
-				const Point64 &point = Point64(vertex.x, vertex.y);
-				subject_path.push_back(point);
-			}
-		}
-		mesh_subject_paths.push_back(subject_path);
-	}
-
-	Paths64 mesh_path_solution = Union(mesh_subject_paths, dummy_clip_paths, FillRule::NonZero);
-
-	//path_solution = RamerDouglasPeucker(path_solution, 0.025);
-
 	int multimesh_instance_count = multimesh->get_visible_instance_count();
 	if (multimesh_instance_count == -1) {
 		multimesh_instance_count = multimesh->get_instance_count();
 	}
 
-	const Transform2D multimesh_instance_xform = p_source_geometry_data->root_node_transform * multimesh_instance->get_global_transform();
+	const Transform2D multimesh_instance_xform = r_parse_data.source_geometry_data->root_node_transform * multimesh_instance->get_global_transform();
 
+	// A single item for all instances, so the mesh outlines are only merged once.
+	NavMeshGeometryParseItem2D item;
+	item.type = NavMeshGeometryParseItem2D::ITEM_TYPE_MESH;
+	item.transforms.resize(multimesh_instance_count);
 	for (int i = 0; i < multimesh_instance_count; i++) {
-		const Transform2D multimesh_instance_mesh_instance_xform = multimesh_instance_xform * multimesh->get_instance_transform_2d(i);
-
-		for (const Path64 &mesh_path : mesh_path_solution) {
-			Vector<Vector2> shape_outline;
-
-			for (const Point64 &mesh_path_point : mesh_path) {
-				shape_outline.push_back(Point2(static_cast<real_t>(mesh_path_point.x), static_cast<real_t>(mesh_path_point.y)));
-			}
-
-			for (int j = 0; j < shape_outline.size(); j++) {
-				shape_outline.write[j] = multimesh_instance_mesh_instance_xform.xform(shape_outline[j]);
-			}
-			p_source_geometry_data->add_obstruction_outline(shape_outline);
-		}
+		item.transforms[i] = multimesh_instance_xform * multimesh->get_instance_transform_2d(i);
 	}
+	item.mesh_surfaces = generator_parse_mesh(r_parse_data, mesh);
+	r_parse_data.items.push_back(item);
 }
 
-void NavMeshGenerator2D::generator_parse_polygon2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator2D::generator_parse_polygon2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node) {
 	Polygon2D *polygon_2d = Object::cast_to<Polygon2D>(p_node);
 
 	if (polygon_2d == nullptr) {
@@ -434,18 +516,15 @@ void NavMeshGenerator2D::generator_parse_polygon2d_node(const Ref<NavigationPoly
 	NavigationPolygon::ParsedGeometryType parsed_geometry_type = p_navigation_mesh->get_parsed_geometry_type();
 
 	if (parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_BOTH) {
-		const Transform2D polygon_2d_xform = p_source_geometry_data->root_node_transform * polygon_2d->get_global_transform();
-
-		Vector<Vector2> shape_outline = polygon_2d->get_polygon();
-		for (int i = 0; i < shape_outline.size(); i++) {
-			shape_outline.write[i] = polygon_2d_xform.xform(shape_outline[i]);
-		}
-
-		p_source_geometry_data->add_obstruction_outline(shape_outline);
+		NavMeshGeometryParseItem2D item;
+		item.type = NavMeshGeometryParseItem2D::ITEM_TYPE_OBSTRUCTION_OUTLINE;
+		item.transforms.push_back(r_parse_data.source_geometry_data->root_node_transform * polygon_2d->get_global_transform());
+		item.outline = polygon_2d->get_polygon();
+		r_parse_data.items.push_back(item);
 	}
 }
 
-void NavMeshGenerator2D::generator_parse_staticbody2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator2D::generator_parse_staticbody2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node) {
 	StaticBody2D *static_body = Object::cast_to<StaticBody2D>(p_node);
 
 	if (static_body == nullptr) {
@@ -479,89 +558,16 @@ void NavMeshGenerator2D::generator_parse_staticbody2d_node(const Ref<NavigationP
 				continue;
 			}
 
-			const Transform2D static_body_xform = p_source_geometry_data->root_node_transform * static_body->get_global_transform() * static_body->shape_owner_get_transform(shape_owner);
-
-			RectangleShape2D *rectangle_shape = Object::cast_to<RectangleShape2D>(*s);
-			if (rectangle_shape) {
-				Vector<Vector2> shape_outline;
-
-				const Vector2 &rectangle_size = rectangle_shape->get_size();
-
-				shape_outline.resize(5);
-				shape_outline.write[0] = static_body_xform.xform(-rectangle_size * 0.5);
-				shape_outline.write[1] = static_body_xform.xform(Vector2(rectangle_size.x, -rectangle_size.y) * 0.5);
-				shape_outline.write[2] = static_body_xform.xform(rectangle_size * 0.5);
-				shape_outline.write[3] = static_body_xform.xform(Vector2(-rectangle_size.x, rectangle_size.y) * 0.5);
-				shape_outline.write[4] = static_body_xform.xform(-rectangle_size * 0.5);
-
-				p_source_geometry_data->add_obstruction_outline(shape_outline);
-			}
-
-			CapsuleShape2D *capsule_shape = Object::cast_to<CapsuleShape2D>(*s);
-			if (capsule_shape) {
-				const real_t capsule_height = capsule_shape->get_height();
-				const real_t capsule_radius = capsule_shape->get_radius();
-
-				Vector<Vector2> shape_outline;
-				const real_t turn_step = Math_TAU / 12.0;
-				shape_outline.resize(14);
-				int shape_outline_inx = 0;
-				for (int i = 0; i < 12; i++) {
-					Vector2 ofs = Vector2(0, (i > 3 && i <= 9) ? -capsule_height * 0.5 + capsule_radius : capsule_height * 0.5 - capsule_radius);
-
-					shape_outline.write[shape_outline_inx] = static_body_xform.xform(Vector2(Math::sin(i * turn_step), Math::cos(i * turn_step)) * capsule_radius + ofs);
-					shape_outline_inx += 1;
-					if (i == 3 || i == 9) {
-						shape_outline.write[shape_outline_inx] = static_body_xform.xform(Vector2(Math::sin(i * turn_step), Math::cos(i * turn_step)) * capsule_radius - ofs);
-						shape_outline_inx += 1;
-					}
-				}
-
-				p_source_geometry_data->add_obstruction_outline(shape_outline);
-			}
-
-			CircleShape2D *circle_shape = Object::cast_to<CircleShape2D>(*s);
-			if (circle_shape) {
-				const real_t circle_radius = circle_shape->get_radius();
-
-				Vector<Vector2> shape_outline;
-				int circle_edge_count = 12;
-				shape_outline.resize(circle_edge_count);
-
-				const real_t turn_step = Math_TAU / real_t(circle_edge_count);
-				for (int i = 0; i < circle_edge_count; i++) {
-					shape_outline.write[i] = static_body_xform.xform(Vector2(Math::cos(i * turn_step), Math::sin(i * turn_step)) * circle_radius);
-				}
-
-				p_source_geometry_data->add_obstruction_outline(shape_outline);
-			}
-
-			ConcavePolygonShape2D *concave_polygon_shape = Object::cast_to<ConcavePolygonShape2D>(*s);
-			if (concave_polygon_shape) {
-				Vector<Vector2> shape_outline = concave_polygon_shape->get_segments();
-
-				for (int i = 0; i < shape_outline.size(); i++) {
-					shape_outline.write[i] = static_body_xform.xform(shape_outline[i]);
-				}
-
-				p_source_geometry_data->add_obstruction_outline(shape_outline);
-			}
-
-			ConvexPolygonShape2D *convex_polygon_shape = Object::cast_to<ConvexPolygonShape2D>(*s);
-			if (convex_polygon_shape) {
-				Vector<Vector2> shape_outline = convex_polygon_shape->get_points();
-
-				for (int i = 0; i < shape_outline.size(); i++) {
-					shape_outline.write[i] = static_body_xform.xform(shape_outline[i]);
-				}
-
-				p_source_geometry_data->add_obstruction_outline(shape_outline);
-			}
+			NavMeshGeometryParseItem2D item;
+			item.type = NavMeshGeometryParseItem2D::ITEM_TYPE_SHAPE;
+			item.transforms.push_back(r_parse_data.source_geometry_data->root_node_transform * static_body->get_global_transform() * static_body->shape_owner_get_transform(shape_owner));
+			item.shape = s;
+			r_parse_data.items.push_back(item);
 		}
 	}
 }
 
-void NavMeshGenerator2D::generator_parse_tilemap_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator2D::generator_parse_tilemap_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node) {
 	TileMap *tilemap = Object::cast_to<TileMap>(p_node);
 
 	if (tilemap == nullptr) {
@@ -590,7 +596,7 @@ void NavMeshGenerator2D::generator_parse_tilemap_node(const Ref<NavigationPolygo
 	HashSet<Vector2i> cells_with_navigation_polygon;
 	HashSet<Vector2i> cells_with_collision_polygon;
 
-	const Transform2D tilemap_xform = p_source_geometry_data->root_node_transform * tilemap->get_global_transform();
+	const Transform2D tilemap_xform = r_parse_data.source_geometry_data->root_node_transform * tilemap->get_global_transform();
 
 #ifdef DEBUG_ENABLED
 	int error_print_counter = 0;
@@ -638,17 +644,11 @@ void NavMeshGenerator2D::generator_parse_tilemap_node(const Ref<NavigationPolygo
 								continue;
 							}
 
-							Vector<Vector2> traversable_outline;
-							traversable_outline.resize(navigation_polygon_outline.size());
-
-							const Vector2 *navigation_polygon_outline_ptr = navigation_polygon_outline.ptr();
-							Vector2 *traversable_outline_ptrw = traversable_outline.ptrw();
-
-							for (int traversable_outline_index = 0; traversable_outline_index < traversable_outline.size(); traversable_outline_index++) {
-								traversable_outline_ptrw[traversable_outline_index] = tile_transform_offset.xform(navigation_polygon_outline_ptr[traversable_outline_index]);
-							}
-
-							p_source_geometry_data->_add_traversable_outline(traversable_outline);
+							NavMeshGeometryParseItem2D item;
+							item.type = NavMeshGeometryParseItem2D::ITEM_TYPE_TRAVERSABLE_OUTLINE;
+							item.transforms.push_back(tile_transform_offset);
+							item.outline = navigation_polygon_outline;
+							r_parse_data.items.push_back(item);
 						}
 					}
 				}
@@ -675,17 +675,11 @@ void NavMeshGenerator2D::generator_parse_tilemap_node(const Ref<NavigationPolygo
 							collision_polygon_points = TileData::get_transformed_vertices(collision_polygon_points, flip_h, flip_v, transpose);
 						}
 
-						Vector<Vector2> obstruction_outline;
-						obstruction_outline.resize(collision_polygon_points.size());
-
-						const Vector2 *collision_polygon_points_ptr = collision_polygon_points.ptr();
-						Vector2 *obstruction_outline_ptrw = obstruction_outline.ptrw();
-
-						for (int obstruction_outline_index = 0; obstruction_outline_index < obstruction_outline.size(); obstruction_outline_index++) {
-							obstruction_outline_ptrw[obstruction_outline_index] = tile_transform_offset.xform(collision_polygon_points_ptr[obstruction_outline_index]);
-						}
-
-						p_source_geometry_data->_add_obstruction_outline(obstruction_outline);
+						NavMeshGeometryParseItem2D item;
+						item.type = NavMeshGeometryParseItem2D::ITEM_TYPE_OBSTRUCTION_OUTLINE;
+						item.transforms.push_back(tile_transform_offset);
+						item.outline = collision_polygon_points;
+						r_parse_data.items.push_back(item);
 					}
 				}
 			}
@@ -698,7 +692,7 @@ void NavMeshGenerator2D::generator_parse_tilemap_node(const Ref<NavigationPolygo
 #endif // DEBUG_ENABLED
 }
 
-void NavMeshGenerator2D::generator_parse_navigationobstacle_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator2D::generator_parse_navigationobstacle_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node) {
 	NavigationObstacle2D *obstacle = Object::cast_to<NavigationObstacle2D>(p_node);
 	if (obstacle == nullptr) {
 		return;
@@ -708,7 +702,10 @@ void NavMeshGenerator2D::generator_parse_navigationobstacle_node(const Ref<Navig
 		return;
 	}
 
-	const Transform2D node_xform = p_source_geometry_data->root_node_transform * Transform2D(0.0, obstacle->get_global_position());
+	// Obstructions are cheap to build, add them right away instead of deferring them to the workers.
+	const Ref<NavigationMeshSourceGeometryData2D> &source_geometry_data = r_parse_data.source_geometry_data;
+
+	const Transform2D node_xform = source_geometry_data->root_node_transform * Transform2D(0.0, obstacle->get_global_position());
 
 	const float obstacle_radius = obstacle->get_radius();
 
@@ -729,7 +726,7 @@ void NavMeshGenerator2D::generator_parse_navigationobstacle_node(const Ref<Navig
 			circle_vertices_ptrw[i] = node_xform.xform(Vector2(Math::cos(angle) * obstacle_radius, Math::sin(angle) * obstacle_radius));
 		}
 
-		p_source_geometry_data->add_projected_obstruction(obstruction_circle_vertices, obstacle->get_carve_navigation_mesh());
+		source_geometry_data->add_projected_obstruction(obstruction_circle_vertices, obstacle->get_carve_navigation_mesh());
 	}
 
 	const Vector<Vector2> &obstacle_vertices = obstacle->get_vertices();
@@ -747,7 +744,7 @@ void NavMeshGenerator2D::generator_parse_navigationobstacle_node(const Ref<Navig
 	for (int i = 0; i < obstacle_vertices.size(); i++) {
 		obstruction_shape_vertices_ptrw[i] = node_xform.xform(obstacle_vertices_ptr[i]);
 	}
-	p_source_geometry_data->add_projected_obstruction(obstruction_shape_vertices, obstacle->get_carve_navigation_mesh());
+	source_geometry_data->add_projected_obstruction(obstruction_shape_vertices, obstacle->get_carve_navigation_mesh());
 }
 
 void NavMeshGenerator2D::generator_parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node) {
@@ -769,8 +766,42 @@ void NavMeshGenerator2D::generator_parse_source_geometry_data(Ref<NavigationPoly
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationPolygon::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
+	// Only gather the meshes, shapes, outlines and transforms here, the scene tree and servers can not be touched from other threads.
+	NavMeshGeometryParseData2D parse_data;
+	parse_data.source_geometry_data = p_source_geometry_data;
+
 	for (Node *E : parse_nodes) {
-		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, E, recurse_children);
+		generator_parse_geometry_node(p_navigation_mesh, parse_data, E, recurse_children);
+	}
+
+	if (parse_data.items.is_empty()) {
+		return;
+	}
+
+	// The main thread waits for the extraction, so unlike async baking this is also safe to spread over threads in the editor.
+	uint32_t chunk_count = 1;
+	if (baking_use_multiple_threads) {
+		chunk_count = MIN(parse_data.items.size(), (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count() * 4);
+	}
+
+	if (chunk_count <= 1) {
+		parse_data.chunks.push_back(p_source_geometry_data);
+		generator_thread_parse_chunk(&parse_data, 0);
+		return;
+	}
+
+	// Transform the outlines on the workers, then merge the chunks in order to keep the result deterministic.
+	parse_data.chunks.resize(chunk_count);
+	for (Ref<NavigationMeshSourceGeometryData2D> &chunk : parse_data.chunks) {
+		chunk.instantiate();
+		chunk->root_node_transform = root_node_transform;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator2D::generator_thread_parse_chunk, &parse_data, chunk_count, -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorParse2D"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (const Ref<NavigationMeshSourceGeometryData2D> &chunk : parse_data.chunks) {
+		p_source_geometry_data->merge(chunk);
 	}
 };
 
@@ -36,9 +36,11 @@
 #include "core/object/class_db.h"
 #include "core/object/worker_thread_pool.h"
 
+class Mesh;
 class Node;
 class NavigationPolygon;
 class NavigationMeshSourceGeometryData2D;
+class Shape2D;
 
 class NavMeshGenerator2D : public Object {
 	static NavMeshGenerator2D *singleton;
@@ -72,16 +74,45 @@ class NavMeshGenerator2D : public Object {
 
 	static HashSet<Ref<NavigationPolygon>> baking_navmeshes;
 
-	static void generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
+	struct NavMeshGeometryParseItem2D {
+		enum ItemType {
+			ITEM_TYPE_OBSTRUCTION_OUTLINE,
+			ITEM_TYPE_TRAVERSABLE_OUTLINE,
+			ITEM_TYPE_SHAPE,
+			ITEM_TYPE_MESH,
+		};
+
+		ItemType type = ITEM_TYPE_OBSTRUCTION_OUTLINE;
+		// Outlines and shapes are transformed by the first transform, meshes are added once per transform.
+		LocalVector<Transform2D> transforms;
+		Vector<Vector2> outline;
+		Ref<Shape2D> shape;
+		// Triangle vertices of each mesh surface, in index order.
+		const LocalVector<Vector<Vector2>> *mesh_surfaces = nullptr;
+	};
+
+	struct NavMeshGeometryParseData2D {
+		Ref<NavigationMeshSourceGeometryData2D> source_geometry_data;
+		// Surface arrays are fetched once per mesh on the main thread, as it needs the RenderingServer.
+		HashMap<Ref<Mesh>, LocalVector<Vector<Vector2>>> mesh_surfaces;
+		LocalVector<NavMeshGeometryParseItem2D> items;
+		// Each worker extracts a consecutive range of items into its own chunk.
+		LocalVector<Ref<NavigationMeshSourceGeometryData2D>> chunks;
+	};
+
+	static void generator_thread_parse_chunk(void *p_arg, uint32_t p_index);
+
+	static void generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data);
 
-	static void generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_polygon2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_staticbody2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_tilemap_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_navigationobstacle_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
+	static const LocalVector<Vector<Vector2>> *generator_parse_mesh(NavMeshGeometryParseData2D &r_parse_data, const Ref<Mesh> &p_mesh);
+	static void generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node);
+	static void generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node);
+	static void generator_parse_polygon2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node);
+	static void generator_parse_staticbody2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node);
+	static void generator_parse_tilemap_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node);
+	static void generator_parse_navigationobstacle_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometryParseData2D &r_parse_data, Node *p_node);
 
 	static bool generator_emit_callback(const Callable &p_callback);
 
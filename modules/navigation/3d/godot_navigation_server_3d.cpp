@@ -244,6 +244,13 @@ Vector<Vector3> GodotNavigationServer3D::map_get_path(RID p_map, Vector3 p_origi
 	return map->get_path(p_origin, p_destination, p_optimize, p_navigation_layers, nullptr, nullptr, nullptr);
 }
 
+Vector3 GodotNavigationServer3D::map_get_flow_field_direction(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, Vector3());
+
+	return map->get_flow_field_direction(p_origin, p_destination, p_navigation_layers);
+}
+
 Vector3 GodotNavigationServer3D::map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector3());
@@ -1131,6 +1138,18 @@ void GodotNavigationServer3D::bake_from_source_geometry_data_async(const Ref<Nav
 #endif // _3D_DISABLED
 }
 
+Dictionary GodotNavigationServer3D::bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, real_t p_tile_size, const AABB &p_changed_aabb) {
+#ifdef _3D_DISABLED
+	return Dictionary();
+#else
+	ERR_FAIL_COND_V_MSG(!p_navigation_mesh.is_valid(), Dictionary(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_V_MSG(!p_source_geometry_data.is_valid(), Dictionary(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL_V(NavMeshGenerator3D::get_singleton(), Dictionary());
+	return NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_tile_size, p_changed_aabb);
+#endif // _3D_DISABLED
+}
+
 bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const {
 #ifdef _3D_DISABLED
 	return false;
@@ -1140,6 +1159,11 @@ bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_na
 }
 
 COMMAND_1(free, RID, p_object) {
+	if (map_owner.owns(p_object) || region_owner.owns(p_object) || link_owner.owns(p_object)) {
+		// Running batch queries still reference the polygons of this object.
+		_wait_for_path_query_batches();
+	}
+
 	if (map_owner.owns(p_object)) {
 		NavMap *map = map_owner.get_or_null(p_object);
 
@@ -1271,6 +1295,8 @@ uint32_t GodotNavigationServer3D::map_get_iteration_id(RID p_map) const {
 }
 
 void GodotNavigationServer3D::sync() {
+	_dispatch_path_query_batches();
+
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->sync();
@@ -1337,6 +1363,7 @@ void GodotNavigationServer3D::init() {
 
 void GodotNavigationServer3D::finish() {
 	flush_queries();
+	_clear_path_query_batches();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->finish();
@@ -1347,33 +1374,41 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters) const {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
-	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
+	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR || p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR) {
+		const bool hierarchical = p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR;
+
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
 					p_parameters.navigation_layers,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
+					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr,
+					hierarchical);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
 					p_parameters.navigation_layers,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
+					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr,
+					hierarchical);
 		}
 	} else {
 		return r_query_result;
@@ -1386,6 +1421,122 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 	return r_query_result;
 }
 
+uint32_t GodotNavigationServer3D::query_path_batch_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), 0, "The number of path query parameters and path query results must match.");
+
+	const uint32_t query_count = p_query_parameters.size();
+	for (uint32_t i = 0; i < query_count; i++) {
+		ERR_FAIL_COND_V(Ref<NavigationPathQueryParameters3D>(p_query_parameters[i]).is_null(), 0);
+		ERR_FAIL_COND_V(Ref<NavigationPathQueryResult3D>(p_query_results[i]).is_null(), 0);
+	}
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->parameters.resize(query_count);
+	batch->maps.resize(query_count);
+	batch->results.resize(query_count);
+	batch->query_results = p_query_results;
+	batch->callback = p_callback;
+
+	// Copy the parameters so the query objects can be changed or reused while the batch is running.
+	for (uint32_t i = 0; i < query_count; i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		batch->parameters[i] = query_parameters->get_parameters();
+		batch->maps[i] = map_owner.get_or_null(batch->parameters[i].map);
+		if (batch->maps[i] == nullptr) {
+			ERR_PRINT("Attempted to query a path on a NavigationServer map RID that does not exist.");
+		}
+	}
+
+	MutexLock lock(path_query_batch_mutex);
+
+	// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
+	path_query_batch_id = path_query_batch_id % UINT32_MAX + 1;
+	batch->id = path_query_batch_id;
+
+	if (query_count > 0) {
+		// Low priority, so long batches leave room for the frame critical work of other systems.
+		batch->group_task_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_query_path_batch_item, batch, query_count, -1, false, SNAME("NavigationPathQueryBatch3D"));
+	}
+	path_query_batches.insert(batch->id, batch);
+
+	return batch->id;
+}
+
+bool GodotNavigationServer3D::is_path_query_batch_pending(uint32_t p_batch_id) const {
+	MutexLock lock(path_query_batch_mutex);
+	return path_query_batches.has(p_batch_id);
+}
+
+void GodotNavigationServer3D::_query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) {
+	const NavMap *map = p_batch->maps[p_index];
+	if (map) {
+		// Each query holds the map read lock only for itself, so it never sees a map in the middle of a sync.
+		// Waiting for a pending sync first lets it in between the queries instead of behind the whole batch.
+		map->wait_for_sync();
+		p_batch->results[p_index] = _query_map_path(map, p_batch->parameters[p_index]);
+	}
+}
+
+void GodotNavigationServer3D::_wait_for_path_query_batches() {
+	MutexLock lock(path_query_batch_mutex);
+
+	for (KeyValue<uint32_t, PathQueryBatch *> &E : path_query_batches) {
+		PathQueryBatch *batch = E.value;
+		if (batch->group_task_id != -1) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_task_id);
+			batch->group_task_id = -1;
+		}
+	}
+}
+
+void GodotNavigationServer3D::_dispatch_path_query_batches() {
+	LocalVector<PathQueryBatch *> finished_batches;
+
+	path_query_batch_mutex.lock();
+	for (KeyValue<uint32_t, PathQueryBatch *> &E : path_query_batches) {
+		PathQueryBatch *batch = E.value;
+		if (batch->group_task_id != -1) {
+			if (!WorkerThreadPool::get_singleton()->is_group_task_completed(batch->group_task_id)) {
+				continue;
+			}
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_task_id);
+			batch->group_task_id = -1;
+		}
+		finished_batches.push_back(batch);
+	}
+	for (const PathQueryBatch *batch : finished_batches) {
+		path_query_batches.erase(batch->id);
+	}
+	path_query_batch_mutex.unlock();
+
+	// Results and callbacks are delivered without holding the lock, so callbacks can start new batches.
+	for (PathQueryBatch *batch : finished_batches) {
+		for (uint32_t i = 0; i < batch->results.size(); i++) {
+			Ref<NavigationPathQueryResult3D> query_result = batch->query_results[i];
+			const PathQueryResult &result = batch->results[i];
+			query_result->set_path(result.path);
+			query_result->set_path_types(result.path_types);
+			query_result->set_path_rids(result.path_rids);
+			query_result->set_path_owner_ids(result.path_owner_ids);
+		}
+
+		if (batch->callback.is_valid()) {
+			batch->callback.call(batch->id);
+		}
+		memdelete(batch);
+	}
+}
+
+void GodotNavigationServer3D::_clear_path_query_batches() {
+	_wait_for_path_query_batches();
+
+	MutexLock lock(path_query_batch_mutex);
+	for (KeyValue<uint32_t, PathQueryBatch *> &E : path_query_batches) {
+		memdelete(E.value);
+	}
+	path_query_batches.clear();
+}
+
 int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
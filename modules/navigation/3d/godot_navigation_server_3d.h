@@ -37,6 +37,7 @@
 #include "../nav_obstacle.h"
 #include "../nav_region.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -86,6 +87,20 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 #endif // _3D_DISABLED
 
+	struct PathQueryBatch {
+		uint32_t id = 0;
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		TypedArray<NavigationPathQueryResult3D> query_results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_task_id = -1;
+	};
+
+	Mutex path_query_batch_mutex;
+	HashMap<uint32_t, PathQueryBatch *> path_query_batches;
+	uint32_t path_query_batch_id = 0;
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -131,6 +146,8 @@ public:
 
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const override;
 
+	virtual Vector3 map_get_flow_field_direction(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers = 1) const override;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const override;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const override;
@@ -262,6 +279,7 @@ public:
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
+	virtual Dictionary bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, real_t p_tile_size, const AABB &p_changed_aabb = AABB()) override;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const override;
 
 	COMMAND_1(free, RID, p_object);
@@ -276,11 +294,20 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
 
+	virtual uint32_t query_path_batch_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override;
+	virtual bool is_path_query_batch_pending(uint32_t p_batch_id) const override;
+
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	NavigationUtilities::PathQueryResult _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters) const;
+	void _query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch);
+	void _wait_for_path_query_batches();
+	void _dispatch_path_query_batches();
+	void _clear_path_query_batches();
 };
 
 #undef COMMAND_1
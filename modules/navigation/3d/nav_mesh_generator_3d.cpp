@@ -227,6 +227,169 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	generator_task_mutex.unlock();
 }
 
+Dictionary NavMeshGenerator3D::bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, real_t p_tile_size, const AABB &p_changed_aabb) {
+	ERR_FAIL_COND_V(!p_navigation_mesh.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(!p_source_geometry_data.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_tile_size <= 0.0, Dictionary(), "The navigation mesh tile size must be greater than zero.");
+
+	Dictionary tile_meshes;
+
+	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
+	const Vector<int> &indices = p_source_geometry_data->get_indices();
+	if (vertices.size() < 3 || indices.size() < 3) {
+		return tile_meshes;
+	}
+
+	// Tiles are aligned with the voxel grid at the world origin, so a tile keeps the same bounds in every bake.
+	const real_t cell_size = p_navigation_mesh->get_cell_size();
+	const real_t cell_height = p_navigation_mesh->get_cell_height();
+	const real_t tile_world_size = MAX(1, (int)Math::round(p_tile_size / cell_size)) * cell_size;
+
+	// Each tile is baked with a border around it that is large enough for the agent radius erosion,
+	// so the walkable area reaches the tile edges. Must match the border used in the tile bake.
+	const real_t border_world_size = ((int)Math::ceil(p_navigation_mesh->get_agent_radius() / cell_size) + 3) * cell_size;
+
+	const float *verts = vertices.ptr();
+	const int *tris = indices.ptr();
+	const int ntris = indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(verts, vertices.size() / 3, bmin, bmax);
+
+	// Without a changed area all tiles touched by the source geometry are baked. Geometry changes
+	// also affect the tiles whose border overlaps them, and tiles where geometry was removed are baked empty.
+	AABB bake_aabb;
+	if (p_changed_aabb.has_surface()) {
+		bake_aabb = p_changed_aabb.grow(border_world_size);
+	} else {
+		bake_aabb = AABB(Vector3(bmin[0], bmin[1], bmin[2]), Vector3(bmax[0] - bmin[0], bmax[1] - bmin[1], bmax[2] - bmin[2]));
+	}
+
+	AABB filter_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (filter_aabb.has_volume()) {
+		filter_aabb.position += p_navigation_mesh->get_filter_baking_aabb_offset();
+		if (!bake_aabb.intersects(filter_aabb)) {
+			return tile_meshes;
+		}
+		bake_aabb = bake_aabb.intersection(filter_aabb);
+	}
+
+	const int min_tile_x = (int)Math::floor(bake_aabb.position.x / tile_world_size);
+	const int min_tile_z = (int)Math::floor(bake_aabb.position.z / tile_world_size);
+	const int max_tile_x = MAX(min_tile_x, (int)Math::ceil((bake_aabb.position.x + bake_aabb.size.x) / tile_world_size) - 1);
+	const int max_tile_z = MAX(min_tile_z, (int)Math::ceil((bake_aabb.position.z + bake_aabb.size.z) / tile_world_size) - 1);
+	const int tile_count_x = max_tile_x - min_tile_x + 1;
+	const int tile_count_z = max_tile_z - min_tile_z + 1;
+
+	// Start the tiles at a multiple of the cell height, so all tiles share the same vertical voxel grid.
+	const real_t tile_min_y = Math::floor(bmin[1] / cell_height) * cell_height;
+	const real_t tile_height = bmax[1] - tile_min_y;
+
+	NavMeshGeneratorTiles3D tiles_data;
+	tiles_data.source_geometry_data = p_source_geometry_data;
+	tiles_data.tiles.resize(tile_count_x * tile_count_z);
+	for (int z = 0; z < tile_count_z; z++) {
+		for (int x = 0; x < tile_count_x; x++) {
+			NavMeshGeneratorTile3D &tile = tiles_data.tiles[z * tile_count_x + x];
+			tile.coords = Vector2i(min_tile_x + x, min_tile_z + z);
+			tile.bounds = AABB(Vector3(tile.coords.x * tile_world_size, tile_min_y, tile.coords.y * tile_world_size), Vector3(tile_world_size, tile_height, tile_world_size));
+			if (filter_aabb.has_volume()) {
+				// Only bake the part of the tile inside the filter. The clipped sides are snapped outwards
+				// to the voxel grid, the tile bake drops the cells outside the filter again.
+				const AABB clipped = tile.bounds.intersection(filter_aabb);
+				if (clipped.has_volume()) {
+					Vector3 from = tile.bounds.position;
+					Vector3 to = tile.bounds.get_end();
+					if (clipped.position.x > from.x) {
+						from.x = Math::floor(clipped.position.x / cell_size) * cell_size;
+					}
+					if (clipped.position.y > from.y) {
+						from.y = Math::floor(clipped.position.y / cell_height) * cell_height;
+					}
+					if (clipped.position.z > from.z) {
+						from.z = Math::floor(clipped.position.z / cell_size) * cell_size;
+					}
+					if (clipped.get_end().x < to.x) {
+						to.x = Math::ceil(clipped.get_end().x / cell_size) * cell_size;
+					}
+					if (clipped.get_end().y < to.y) {
+						to.y = Math::ceil(clipped.get_end().y / cell_height) * cell_height;
+					}
+					if (clipped.get_end().z < to.z) {
+						to.z = Math::ceil(clipped.get_end().z / cell_size) * cell_size;
+					}
+					tile.bounds = AABB(from, to - from);
+				} else {
+					tile.bounds = AABB();
+				}
+			}
+			tile.navigation_mesh = p_navigation_mesh->duplicate();
+			tile.navigation_mesh->clear();
+		}
+	}
+
+	// Sort the source triangles into the tiles they overlap, so each tile only rasterizes its own geometry.
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
+		const real_t triangle_min_x = MIN(v0[0], MIN(v1[0], v2[0])) - border_world_size;
+		const real_t triangle_max_x = MAX(v0[0], MAX(v1[0], v2[0])) + border_world_size;
+		const real_t triangle_min_z = MIN(v0[2], MIN(v1[2], v2[2])) - border_world_size;
+		const real_t triangle_max_z = MAX(v0[2], MAX(v1[2], v2[2])) + border_world_size;
+
+		// Triangles outside the filter are not rasterized by any tile.
+		if (filter_aabb.has_volume()) {
+			const real_t triangle_min_y = MIN(v0[1], MIN(v1[1], v2[1]));
+			const real_t triangle_max_y = MAX(v0[1], MAX(v1[1], v2[1]));
+			const AABB triangle_aabb(Vector3(triangle_min_x, triangle_min_y, triangle_min_z), Vector3(triangle_max_x - triangle_min_x, triangle_max_y - triangle_min_y, triangle_max_z - triangle_min_z));
+			if (!triangle_aabb.intersects_inclusive(filter_aabb)) {
+				continue;
+			}
+		}
+
+		const int from_x = MAX(min_tile_x, (int)Math::floor(triangle_min_x / tile_world_size));
+		const int to_x = MIN(max_tile_x, (int)Math::floor(triangle_max_x / tile_world_size));
+		const int from_z = MAX(min_tile_z, (int)Math::floor(triangle_min_z / tile_world_size));
+		const int to_z = MIN(max_tile_z, (int)Math::floor(triangle_max_z / tile_world_size));
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				NavMeshGeneratorTile3D &tile = tiles_data.tiles[(z - min_tile_z) * tile_count_x + (x - min_tile_x)];
+				if (!tile.bounds.has_volume()) {
+					continue;
+				}
+				LocalVector<int> &tile_indices = tile.indices;
+				tile_indices.push_back(tris[i * 3 + 0]);
+				tile_indices.push_back(tris[i * 3 + 1]);
+				tile_indices.push_back(tris[i * 3 + 2]);
+			}
+		}
+	}
+
+	// The bake settings are the same for all tiles, only warn about them once.
+	for (NavMeshGeneratorTile3D &tile : tiles_data.tiles) {
+		if (!tile.indices.is_empty()) {
+			tile.print_warnings = true;
+			break;
+		}
+	}
+
+	if (use_threads && tiles_data.tiles.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, &tiles_data, tiles_data.tiles.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tiles_data.tiles.size(); i++) {
+			generator_thread_bake_tile(&tiles_data, i);
+		}
+	}
+
+	for (const NavMeshGeneratorTile3D &tile : tiles_data.tiles) {
+		tile_meshes[tile.coords] = tile.navigation_mesh;
+	}
+
+	return tile_meshes;
+}
+
 bool NavMeshGenerator3D::is_baking(Ref<NavigationMesh> p_navigation_mesh) {
 	baking_navmesh_mutex.lock();
 	bool baking = baking_navmeshes.has(p_navigation_mesh);
@@ -242,26 +405,237 @@ void NavMeshGenerator3D::generator_thread_bake(void *p_arg) {
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
 }
 
-void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children) {
-	generator_parse_meshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_multimeshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_staticbody3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+void NavMeshGenerator3D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorTiles3D *tiles_data = static_cast<NavMeshGeneratorTiles3D *>(p_arg);
+	const NavMeshGeneratorTile3D &tile = tiles_data->tiles[p_index];
+
+	if (tile.indices.is_empty()) {
+		return;
+	}
+
+	generator_bake_from_source_geometry_data(tile.navigation_mesh, tiles_data->source_geometry_data, &tile);
+}
+
+void NavMeshGenerator3D::generator_thread_parse_chunk(void *p_arg, uint32_t p_index) {
+	NavMeshGeometryParseData3D *parse_data = static_cast<NavMeshGeometryParseData3D *>(p_arg);
+	const Ref<NavigationMeshSourceGeometryData3D> &chunk = parse_data->chunks[p_index];
+
+	const uint32_t item_count = parse_data->items.size();
+	const uint32_t chunk_count = parse_data->chunks.size();
+	const uint32_t from = item_count * p_index / chunk_count;
+	const uint32_t to = item_count * (p_index + 1) / chunk_count;
+
+	for (uint32_t i = from; i < to; i++) {
+		const NavMeshGeometryParseItem3D &item = parse_data->items[i];
+
+		if (item.mesh_surfaces) {
+			for (const Array &surface : *item.mesh_surfaces) {
+				chunk->add_mesh_array(surface, item.transform);
+			}
+			continue;
+		}
+
+		switch (item.shape_type) {
+			case PhysicsServer3D::SHAPE_SPHERE: {
+				real_t radius = item.shape_data;
+				Array arr;
+				arr.resize(RS::ARRAY_MAX);
+				SphereMesh::create_mesh_array(arr, radius, radius * 2.0);
+				chunk->add_mesh_array(arr, item.transform);
+			} break;
+			case PhysicsServer3D::SHAPE_BOX: {
+				Vector3 extents = item.shape_data;
+				Array arr;
+				arr.resize(RS::ARRAY_MAX);
+				BoxMesh::create_mesh_array(arr, extents * 2.0);
+				chunk->add_mesh_array(arr, item.transform);
+			} break;
+			case PhysicsServer3D::SHAPE_CAPSULE: {
+				Dictionary dict = item.shape_data;
+				real_t radius = dict["radius"];
+				real_t height = dict["height"];
+				Array arr;
+				arr.resize(RS::ARRAY_MAX);
+				CapsuleMesh::create_mesh_array(arr, radius, height);
+				chunk->add_mesh_array(arr, item.transform);
+			} break;
+			case PhysicsServer3D::SHAPE_CYLINDER: {
+				Dictionary dict = item.shape_data;
+				real_t radius = dict["radius"];
+				real_t height = dict["height"];
+				Array arr;
+				arr.resize(RS::ARRAY_MAX);
+				CylinderMesh::create_mesh_array(arr, radius, radius, height);
+				chunk->add_mesh_array(arr, item.transform);
+			} break;
+			case PhysicsServer3D::SHAPE_CONVEX_POLYGON: {
+				PackedVector3Array vertices = item.shape_data;
+				Geometry3D::MeshData md;
+
+				Error err = ConvexHullComputer::convex_hull(vertices, md);
+
+				if (err == OK) {
+					PackedVector3Array faces;
+
+					for (const Geometry3D::MeshData::Face &face : md.faces) {
+						for (uint32_t k = 2; k < face.indices.size(); ++k) {
+							faces.push_back(md.vertices[face.indices[0]]);
+							faces.push_back(md.vertices[face.indices[k - 1]]);
+							faces.push_back(md.vertices[face.indices[k]]);
+						}
+					}
+
+					chunk->add_faces(faces, item.transform);
+				}
+			} break;
+			case PhysicsServer3D::SHAPE_CONCAVE_POLYGON: {
+				Dictionary dict = item.shape_data;
+				PackedVector3Array faces = Variant(dict["faces"]);
+				if (faces.size() > 0) {
+					chunk->add_faces(faces, item.transform);
+				}
+			} break;
+			case PhysicsServer3D::SHAPE_HEIGHTMAP: {
+				Dictionary dict = item.shape_data;
+				///< dict( int:"width", int:"depth",float:"cell_size", float_array:"heights"
+				int heightmap_depth = dict["depth"];
+				int heightmap_width = dict["width"];
+
+				if (heightmap_depth >= 2 && heightmap_width >= 2) {
+					const Vector<real_t> &map_data = dict["heights"];
+
+					Vector2 heightmap_gridsize(heightmap_width - 1, heightmap_depth - 1);
+					Vector3 start = Vector3(heightmap_gridsize.x, 0, heightmap_gridsize.y) * -0.5;
+
+					Vector<Vector3> vertex_array;
+					vertex_array.resize((heightmap_depth - 1) * (heightmap_width - 1) * 6);
+					Vector3 *vertex_array_ptrw = vertex_array.ptrw();
+					const real_t *map_data_ptr = map_data.ptr();
+					int vertex_index = 0;
+
+					for (int d = 0; d < heightmap_depth - 1; d++) {
+						for (int w = 0; w < heightmap_width - 1; w++) {
+							vertex_array_ptrw[vertex_index] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + w], d);
+							vertex_array_ptrw[vertex_index + 1] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
+							vertex_array_ptrw[vertex_index + 2] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
+							vertex_array_ptrw[vertex_index + 3] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
+							vertex_array_ptrw[vertex_index + 4] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + heightmap_width + w + 1], d + 1);
+							vertex_array_ptrw[vertex_index + 5] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
+							vertex_index += 6;
+						}
+					}
+					if (vertex_array.size() > 0) {
+						chunk->add_faces(vertex_array, item.transform);
+					}
+				}
+			} break;
+			default: {
+				// Unsupported shapes are filtered out while gathering.
+			} break;
+		}
+	}
+}
+
+void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node, bool p_recurse_children) {
+	generator_parse_meshinstance3d_node(p_navigation_mesh, r_parse_data, p_node);
+	generator_parse_multimeshinstance3d_node(p_navigation_mesh, r_parse_data, p_node);
+	generator_parse_staticbody3d_node(p_navigation_mesh, r_parse_data, p_node);
 #ifdef MODULE_CSG_ENABLED
-	generator_parse_csgshape3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_csgshape3d_node(p_navigation_mesh, r_parse_data, p_node);
 #endif
 #ifdef MODULE_GRIDMAP_ENABLED
-	generator_parse_gridmap_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_gridmap_node(p_navigation_mesh, r_parse_data, p_node);
 #endif
-	generator_parse_navigationobstacle_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_navigationobstacle_node(p_navigation_mesh, r_parse_data, p_node);
 
 	if (p_recurse_children) {
 		for (int i = 0; i < p_node->get_child_count(); i++) {
-			generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, p_node->get_child(i), p_recurse_children);
+			generator_parse_geometry_node(p_navigation_mesh, r_parse_data, p_node->get_child(i), p_recurse_children);
+		}
+	}
+}
+
+void NavMeshGenerator3D::generator_parse_mesh(NavMeshGeometryParseData3D &r_parse_data, const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
+	const LocalVector<Array> *mesh_surfaces = r_parse_data.mesh_surfaces.getptr(p_mesh);
+
+	if (mesh_surfaces == nullptr) {
+		LocalVector<Array> &surfaces = r_parse_data.mesh_surfaces[p_mesh];
+
+		for (int i = 0; i < p_mesh->get_surface_count(); i++) {
+			if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+				continue;
+			}
+
+			const bool is_indexed = p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX;
+			const int index_count = is_indexed ? p_mesh->surface_get_array_index_len(i) : p_mesh->surface_get_array_len(i);
+			ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
+
+			Array a = p_mesh->surface_get_arrays(i);
+			ERR_CONTINUE(a.is_empty() || (a.size() != Mesh::ARRAY_MAX));
+
+			Vector<Vector3> mesh_vertices = a[Mesh::ARRAY_VERTEX];
+			ERR_CONTINUE(mesh_vertices.is_empty());
+
+			Vector<int> mesh_indices;
+			if (is_indexed) {
+				mesh_indices = a[Mesh::ARRAY_INDEX];
+				ERR_CONTINUE(mesh_indices.is_empty() || (mesh_indices.size() != index_count));
+			} else {
+				ERR_CONTINUE(mesh_vertices.size() != index_count);
+				mesh_indices.resize(index_count);
+				int *mesh_indices_ptrw = mesh_indices.ptrw();
+				for (int j = 0; j < index_count; j++) {
+					mesh_indices_ptrw[j] = j;
+				}
+			}
+
+			// Only keep what the extraction needs, the other arrays can be large.
+			Array surface;
+			surface.resize(Mesh::ARRAY_MAX);
+			surface[Mesh::ARRAY_VERTEX] = mesh_vertices;
+			surface[Mesh::ARRAY_INDEX] = mesh_indices;
+			surfaces.push_back(surface);
 		}
+
+		mesh_surfaces = &surfaces;
+	}
+
+	if (mesh_surfaces->is_empty()) {
+		return;
+	}
+
+	NavMeshGeometryParseItem3D item;
+	item.transform = p_xform;
+	item.mesh_surfaces = mesh_surfaces;
+	r_parse_data.items.push_back(item);
+}
+
+void NavMeshGenerator3D::generator_parse_shape(NavMeshGeometryParseData3D &r_parse_data, RID p_shape, const Transform3D &p_xform, bool p_warn_unsupported) {
+	PhysicsServer3D::ShapeType type = PhysicsServer3D::get_singleton()->shape_get_type(p_shape);
+
+	switch (type) {
+		case PhysicsServer3D::SHAPE_SPHERE:
+		case PhysicsServer3D::SHAPE_BOX:
+		case PhysicsServer3D::SHAPE_CAPSULE:
+		case PhysicsServer3D::SHAPE_CYLINDER:
+		case PhysicsServer3D::SHAPE_CONVEX_POLYGON:
+		case PhysicsServer3D::SHAPE_CONCAVE_POLYGON:
+		case PhysicsServer3D::SHAPE_HEIGHTMAP: {
+			NavMeshGeometryParseItem3D item;
+			item.transform = p_xform;
+			item.shape_type = type;
+			item.shape_data = PhysicsServer3D::get_singleton()->shape_get_data(p_shape);
+			r_parse_data.items.push_back(item);
+		} break;
+		default: {
+			if (p_warn_unsupported) {
+				WARN_PRINT("Unsupported collision shape type.");
+			}
+		} break;
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node) {
 	MeshInstance3D *mesh_instance = Object::cast_to<MeshInstance3D>(p_node);
 
 	if (mesh_instance) {
@@ -270,13 +644,13 @@ void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<Navigatio
 		if (parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_BOTH) {
 			Ref<Mesh> mesh = mesh_instance->get_mesh();
 			if (mesh.is_valid()) {
-				p_source_geometry_data->add_mesh(mesh, mesh_instance->get_global_transform());
+				generator_parse_mesh(r_parse_data, mesh, mesh_instance->get_global_transform());
 			}
 		}
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node) {
 	MultiMeshInstance3D *multimesh_instance = Object::cast_to<MultiMeshInstance3D>(p_node);
 
 	if (multimesh_instance) {
@@ -292,7 +666,7 @@ void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<Navi
 						n = multimesh->get_instance_count();
 					}
 					for (int i = 0; i < n; i++) {
-						p_source_geometry_data->add_mesh(mesh, multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i));
+						generator_parse_mesh(r_parse_data, mesh, multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i));
 					}
 				}
 			}
@@ -300,7 +674,7 @@ void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<Navi
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node) {
 	StaticBody3D *static_body = Object::cast_to<StaticBody3D>(p_node);
 
 	if (static_body) {
@@ -323,98 +697,8 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 
 					const Transform3D transform = static_body->get_global_transform() * static_body->shape_owner_get_transform(shape_owner);
 
-					BoxShape3D *box = Object::cast_to<BoxShape3D>(*s);
-					if (box) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						BoxMesh::create_mesh_array(arr, box->get_size());
-						p_source_geometry_data->add_mesh_array(arr, transform);
-					}
-
-					CapsuleShape3D *capsule = Object::cast_to<CapsuleShape3D>(*s);
-					if (capsule) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CapsuleMesh::create_mesh_array(arr, capsule->get_radius(), capsule->get_height());
-						p_source_geometry_data->add_mesh_array(arr, transform);
-					}
-
-					CylinderShape3D *cylinder = Object::cast_to<CylinderShape3D>(*s);
-					if (cylinder) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CylinderMesh::create_mesh_array(arr, cylinder->get_radius(), cylinder->get_radius(), cylinder->get_height());
-						p_source_geometry_data->add_mesh_array(arr, transform);
-					}
-
-					SphereShape3D *sphere = Object::cast_to<SphereShape3D>(*s);
-					if (sphere) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						SphereMesh::create_mesh_array(arr, sphere->get_radius(), sphere->get_radius() * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, transform);
-					}
-
-					ConcavePolygonShape3D *concave_polygon = Object::cast_to<ConcavePolygonShape3D>(*s);
-					if (concave_polygon) {
-						p_source_geometry_data->add_faces(concave_polygon->get_faces(), transform);
-					}
-
-					ConvexPolygonShape3D *convex_polygon = Object::cast_to<ConvexPolygonShape3D>(*s);
-					if (convex_polygon) {
-						Vector<Vector3> varr = Variant(convex_polygon->get_points());
-						Geometry3D::MeshData md;
-
-						Error err = ConvexHullComputer::convex_hull(varr, md);
-
-						if (err == OK) {
-							PackedVector3Array faces;
-
-							for (const Geometry3D::MeshData::Face &face : md.faces) {
-								for (uint32_t k = 2; k < face.indices.size(); ++k) {
-									faces.push_back(md.vertices[face.indices[0]]);
-									faces.push_back(md.vertices[face.indices[k - 1]]);
-									faces.push_back(md.vertices[face.indices[k]]);
-								}
-							}
-
-							p_source_geometry_data->add_faces(faces, transform);
-						}
-					}
-
-					HeightMapShape3D *heightmap_shape = Object::cast_to<HeightMapShape3D>(*s);
-					if (heightmap_shape) {
-						int heightmap_depth = heightmap_shape->get_map_depth();
-						int heightmap_width = heightmap_shape->get_map_width();
-
-						if (heightmap_depth >= 2 && heightmap_width >= 2) {
-							const Vector<real_t> &map_data = heightmap_shape->get_map_data();
-
-							Vector2 heightmap_gridsize(heightmap_width - 1, heightmap_depth - 1);
-							Vector3 start = Vector3(heightmap_gridsize.x, 0, heightmap_gridsize.y) * -0.5;
-
-							Vector<Vector3> vertex_array;
-							vertex_array.resize((heightmap_depth - 1) * (heightmap_width - 1) * 6);
-							Vector3 *vertex_array_ptrw = vertex_array.ptrw();
-							const real_t *map_data_ptr = map_data.ptr();
-							int vertex_index = 0;
-
-							for (int d = 0; d < heightmap_depth - 1; d++) {
-								for (int w = 0; w < heightmap_width - 1; w++) {
-									vertex_array_ptrw[vertex_index] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + w], d);
-									vertex_array_ptrw[vertex_index + 1] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 2] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_array_ptrw[vertex_index + 3] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 4] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + heightmap_width + w + 1], d + 1);
-									vertex_array_ptrw[vertex_index + 5] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_index += 6;
-								}
-							}
-							if (vertex_array.size() > 0) {
-								p_source_geometry_data->add_faces(vertex_array, transform);
-							}
-						}
-					}
+					// Static bodies may use shapes that do not block navigation, like world boundaries, skip them quietly.
+					generator_parse_shape(r_parse_data, s->get_rid(), transform, false);
 				}
 			}
 		}
@@ -422,7 +706,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 }
 
 #ifdef MODULE_CSG_ENABLED
-void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node) {
 	CSGShape3D *csgshape3d = Object::cast_to<CSGShape3D>(p_node);
 
 	if (csgshape3d) {
@@ -435,7 +719,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 			if (!meshes.is_empty()) {
 				Ref<Mesh> mesh = meshes[1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, csg_shape->get_global_transform());
+					generator_parse_mesh(r_parse_data, mesh, csg_shape->get_global_transform());
 				}
 			}
 		}
@@ -444,7 +728,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 #endif // MODULE_CSG_ENABLED
 
 #ifdef MODULE_GRIDMAP_ENABLED
-void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node) {
 	GridMap *gridmap = Object::cast_to<GridMap>(p_node);
 
 	if (gridmap) {
@@ -457,7 +741,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 			for (int i = 0; i < meshes.size(); i += 2) {
 				Ref<Mesh> mesh = meshes[i + 1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, xform * (Transform3D)meshes[i]);
+					generator_parse_mesh(r_parse_data, mesh, xform * (Transform3D)meshes[i]);
 				}
 			}
 		}
@@ -465,113 +749,14 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 		else if ((parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_STATIC_COLLIDERS || parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_BOTH) && (gridmap->get_collision_layer() & parsed_collision_mask)) {
 			Array shapes = gridmap->get_collision_shapes();
 			for (int i = 0; i < shapes.size(); i += 2) {
-				RID shape = shapes[i + 1];
-				PhysicsServer3D::ShapeType type = PhysicsServer3D::get_singleton()->shape_get_type(shape);
-				Variant data = PhysicsServer3D::get_singleton()->shape_get_data(shape);
-
-				switch (type) {
-					case PhysicsServer3D::SHAPE_SPHERE: {
-						real_t radius = data;
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						SphereMesh::create_mesh_array(arr, radius, radius * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_BOX: {
-						Vector3 extents = data;
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						BoxMesh::create_mesh_array(arr, extents * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_CAPSULE: {
-						Dictionary dict = data;
-						real_t radius = dict["radius"];
-						real_t height = dict["height"];
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CapsuleMesh::create_mesh_array(arr, radius, height);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_CYLINDER: {
-						Dictionary dict = data;
-						real_t radius = dict["radius"];
-						real_t height = dict["height"];
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CylinderMesh::create_mesh_array(arr, radius, radius, height);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_CONVEX_POLYGON: {
-						PackedVector3Array vertices = data;
-						Geometry3D::MeshData md;
-
-						Error err = ConvexHullComputer::convex_hull(vertices, md);
-
-						if (err == OK) {
-							PackedVector3Array faces;
-
-							for (const Geometry3D::MeshData::Face &face : md.faces) {
-								for (uint32_t k = 2; k < face.indices.size(); ++k) {
-									faces.push_back(md.vertices[face.indices[0]]);
-									faces.push_back(md.vertices[face.indices[k - 1]]);
-									faces.push_back(md.vertices[face.indices[k]]);
-								}
-							}
-
-							p_source_geometry_data->add_faces(faces, shapes[i]);
-						}
-					} break;
-					case PhysicsServer3D::SHAPE_CONCAVE_POLYGON: {
-						Dictionary dict = data;
-						PackedVector3Array faces = Variant(dict["faces"]);
-						p_source_geometry_data->add_faces(faces, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_HEIGHTMAP: {
-						Dictionary dict = data;
-						///< dict( int:"width", int:"depth",float:"cell_size", float_array:"heights"
-						int heightmap_depth = dict["depth"];
-						int heightmap_width = dict["width"];
-
-						if (heightmap_depth >= 2 && heightmap_width >= 2) {
-							const Vector<real_t> &map_data = dict["heights"];
-
-							Vector2 heightmap_gridsize(heightmap_width - 1, heightmap_depth - 1);
-							Vector3 start = Vector3(heightmap_gridsize.x, 0, heightmap_gridsize.y) * -0.5;
-
-							Vector<Vector3> vertex_array;
-							vertex_array.resize((heightmap_depth - 1) * (heightmap_width - 1) * 6);
-							Vector3 *vertex_array_ptrw = vertex_array.ptrw();
-							const real_t *map_data_ptr = map_data.ptr();
-							int vertex_index = 0;
-
-							for (int d = 0; d < heightmap_depth - 1; d++) {
-								for (int w = 0; w < heightmap_width - 1; w++) {
-									vertex_array_ptrw[vertex_index] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + w], d);
-									vertex_array_ptrw[vertex_index + 1] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 2] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_array_ptrw[vertex_index + 3] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 4] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + heightmap_width + w + 1], d + 1);
-									vertex_array_ptrw[vertex_index + 5] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_index += 6;
-								}
-							}
-							if (vertex_array.size() > 0) {
-								p_source_geometry_data->add_faces(vertex_array, shapes[i]);
-							}
-						}
-					} break;
-					default: {
-						WARN_PRINT("Unsupported collision shape type.");
-					} break;
-				}
+				generator_parse_shape(r_parse_data, shapes[i + 1], shapes[i], true);
 			}
 		}
 	}
 }
 #endif // MODULE_GRIDMAP_ENABLED
 
-void NavMeshGenerator3D::generator_parse_navigationobstacle_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_navigationobstacle_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node) {
 	NavigationObstacle3D *obstacle = Object::cast_to<NavigationObstacle3D>(p_node);
 	if (obstacle == nullptr) {
 		return;
@@ -581,7 +766,10 @@ void NavMeshGenerator3D::generator_parse_navigationobstacle_node(const Ref<Navig
 		return;
 	}
 
-	const Transform3D node_xform = p_source_geometry_data->root_node_transform * Transform3D(Basis(), obstacle->get_global_position());
+	// Obstructions are cheap to build, add them right away instead of deferring them to the workers.
+	const Ref<NavigationMeshSourceGeometryData3D> &source_geometry_data = r_parse_data.source_geometry_data;
+
+	const Transform3D node_xform = source_geometry_data->root_node_transform * Transform3D(Basis(), obstacle->get_global_position());
 
 	const float obstacle_radius = obstacle->get_radius();
 
@@ -602,7 +790,7 @@ void NavMeshGenerator3D::generator_parse_navigationobstacle_node(const Ref<Navig
 			circle_vertices_ptrw[i] = node_xform.xform(Vector3(Math::cos(angle) * obstacle_radius, 0.0, Math::sin(angle) * obstacle_radius));
 		}
 
-		p_source_geometry_data->add_projected_obstruction(obstruction_circle_vertices, obstacle->get_global_position().y + p_source_geometry_data->root_node_transform.origin.y - obstacle_radius, obstacle_radius, obstacle->get_carve_navigation_mesh());
+		source_geometry_data->add_projected_obstruction(obstruction_circle_vertices, obstacle->get_global_position().y + source_geometry_data->root_node_transform.origin.y - obstacle_radius, obstacle_radius, obstacle->get_carve_navigation_mesh());
 	}
 
 	const Vector<Vector3> &obstacle_vertices = obstacle->get_vertices();
@@ -621,7 +809,7 @@ void NavMeshGenerator3D::generator_parse_navigationobstacle_node(const Ref<Navig
 		obstruction_shape_vertices_ptrw[i] = node_xform.xform(obstacle_vertices_ptr[i]);
 		obstruction_shape_vertices_ptrw[i].y = 0.0;
 	}
-	p_source_geometry_data->add_projected_obstruction(obstruction_shape_vertices, obstacle->get_global_position().y + p_source_geometry_data->root_node_transform.origin.y, obstacle->get_height(), obstacle->get_carve_navigation_mesh());
+	source_geometry_data->add_projected_obstruction(obstruction_shape_vertices, obstacle->get_global_position().y + source_geometry_data->root_node_transform.origin.y, obstacle->get_height(), obstacle->get_carve_navigation_mesh());
 }
 
 void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node) {
@@ -643,12 +831,53 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
+	// Only gather the meshes, shapes and transforms here, the scene tree and servers can not be touched from other threads.
+	NavMeshGeometryParseData3D parse_data;
+	parse_data.source_geometry_data = p_source_geometry_data;
+
 	for (Node *parse_node : parse_nodes) {
-		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children);
+		generator_parse_geometry_node(p_navigation_mesh, parse_data, parse_node, recurse_children);
+	}
+
+	if (parse_data.items.is_empty()) {
+		return;
+	}
+
+	// The main thread waits for the extraction, so unlike async baking this is also safe to spread over threads in the editor.
+	uint32_t chunk_count = 1;
+	if (baking_use_multiple_threads) {
+		chunk_count = MIN(parse_data.items.size(), (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count() * 4);
+	}
+
+	if (chunk_count <= 1) {
+		parse_data.chunks.push_back(p_source_geometry_data);
+		generator_thread_parse_chunk(&parse_data, 0);
+		return;
+	}
+
+	// Extract and transform the triangles on the workers, then merge the chunks in order to keep the result deterministic.
+	parse_data.chunks.resize(chunk_count);
+	for (Ref<NavigationMeshSourceGeometryData3D> &chunk : parse_data.chunks) {
+		chunk.instantiate();
+		chunk->root_node_transform = root_node_transform;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_parse_chunk, &parse_data, chunk_count, -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorParse3D"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (const Ref<NavigationMeshSourceGeometryData3D> &chunk : parse_data.chunks) {
+		p_source_geometry_data->merge(chunk);
 	}
 };
 
-void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
+// Moves coordinates that lie on the voxel grid exactly onto it,
+// so the border vertices baked by neighboring tiles are identical.
+static float _snap_to_voxel_grid(float p_value, float p_step) {
+	const float snapped = Math::round(p_value / p_step) * p_step;
+	return Math::abs(snapped - p_value) < p_step * 0.01f ? snapped : p_value;
+}
+
+void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const NavMeshGeneratorTile3D *p_tile) {
 	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
 		return;
 	}
@@ -674,8 +903,12 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	const float *verts = vertices.ptr();
 	const int nverts = vertices.size() / 3;
-	const int *tris = indices.ptr();
-	const int ntris = indices.size() / 3;
+	const int *tris = p_tile ? p_tile->indices.ptr() : indices.ptr();
+	const int ntris = p_tile ? p_tile->indices.size() / 3 : indices.size() / 3;
+
+	if (ntris == 0) {
+		return;
+	}
 
 	float bmin[3], bmax[3];
 	rcCalcBounds(verts, nverts, bmin, bmax);
@@ -700,32 +933,40 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
 	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
 
-	if (p_navigation_mesh->get_border_size() > 0.0 && !Math::is_equal_approx(p_navigation_mesh->get_cell_size(), p_navigation_mesh->get_border_size())) {
-		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
-		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
-		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
-		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
+	if (p_tile) {
+		// Tiles need a border large enough for the erosion by the agent radius, the fixed border_size is ignored.
+		cfg.borderSize = cfg.walkableRadius + 3;
 	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
-		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
-		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
-		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
-		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
-	}
-	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
-		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
+
+	// The settings are the same for all tiles, only the first tile warns about them.
+	if (!p_tile || p_tile->print_warnings) {
+		if (p_navigation_mesh->get_border_size() > 0.0 && !Math::is_equal_approx(p_navigation_mesh->get_cell_size(), p_navigation_mesh->get_border_size())) {
+			WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
+		}
+		if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
+			WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
+		}
+		if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
+			WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
+		}
+		if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
+			WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
+		}
+		if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
+			WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
+		}
+		if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
+			WARN_PRINT("Property region_min_size is converted to int and loses precision.");
+		}
+		if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
+			WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
+		}
+		if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
+			WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
+		}
+		if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
+			WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
+		}
 	}
 
 	cfg.bmin[0] = bmin[0];
@@ -736,7 +977,16 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	cfg.bmax[2] = bmax[2];
 
 	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
-	if (baking_aabb.has_volume()) {
+	if (p_tile) {
+		// Bake the tile together with its border, the border is removed again when building the regions.
+		const float border = cfg.borderSize * cfg.cs;
+		cfg.bmin[0] = p_tile->bounds.position.x - border;
+		cfg.bmin[1] = p_tile->bounds.position.y;
+		cfg.bmin[2] = p_tile->bounds.position.z - border;
+		cfg.bmax[0] = p_tile->bounds.position.x + p_tile->bounds.size.x + border;
+		cfg.bmax[1] = p_tile->bounds.position.y + p_tile->bounds.size.y;
+		cfg.bmax[2] = p_tile->bounds.position.z + p_tile->bounds.size.z + border;
+	} else if (baking_aabb.has_volume()) {
 		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
 		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
 		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
@@ -799,6 +1049,27 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
+	if (p_tile && baking_aabb.has_volume()) {
+		// The tile bounds were clipped to the filter and snapped outwards to the voxel grid, and the border
+		// reaches past them. Drop the cells whose center is outside the filter, like the edges of a single bake.
+		const Vector3 filter_from = baking_aabb.position + p_navigation_mesh->get_filter_baking_aabb_offset();
+		const Vector3 filter_to = filter_from + baking_aabb.size;
+		const float half_cell = cfg.cs * 0.5f;
+		for (int axis = 0; axis < 3; axis += 2) {
+			float box_min[3] = { chf->bmin[0], chf->bmin[1], chf->bmin[2] };
+			float box_max[3] = { chf->bmax[0], chf->bmax[1], chf->bmax[2] };
+			if (filter_from[axis] - half_cell > chf->bmin[axis]) {
+				box_max[axis] = filter_from[axis] - half_cell;
+				rcMarkBoxArea(&ctx, box_min, box_max, RC_NULL_AREA, *chf);
+				box_max[axis] = chf->bmax[axis];
+			}
+			if (filter_to[axis] + half_cell < chf->bmax[axis]) {
+				box_min[axis] = filter_to[axis] + half_cell;
+				rcMarkBoxArea(&ctx, box_min, box_max, RC_NULL_AREA, *chf);
+			}
+		}
+	}
+
 	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &projected_obstructions = p_source_geometry_data->_get_projected_obstructions();
 
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
@@ -878,7 +1149,11 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	for (int i = 0; i < detail_mesh->nverts; i++) {
 		const float *v = &detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		if (p_tile) {
+			nav_vertices.push_back(Vector3(_snap_to_voxel_grid(v[0], cfg.cs), _snap_to_voxel_grid(v[1], cfg.ch), _snap_to_voxel_grid(v[2], cfg.cs)));
+		} else {
+			nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		}
 	}
 	p_navigation_mesh->set_vertices(nav_vertices);
 	p_navigation_mesh->clear_polygons();
@@ -36,7 +36,9 @@
 #include "core/object/class_db.h"
 #include "core/object/worker_thread_pool.h"
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
+#include "servers/physics_server_3d.h"
 
+class Mesh;
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
@@ -71,22 +73,60 @@ class NavMeshGenerator3D : public Object {
 
 	static void generator_thread_bake(void *p_arg);
 
+	struct NavMeshGeneratorTile3D {
+		Vector2i coords;
+		// Tile bounds without the border that is baked around them.
+		AABB bounds;
+		// Source geometry triangles that overlap the tile or its border.
+		LocalVector<int> indices;
+		Ref<NavigationMesh> navigation_mesh;
+		bool print_warnings = false;
+	};
+
+	struct NavMeshGeneratorTiles3D {
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+		LocalVector<NavMeshGeneratorTile3D> tiles;
+	};
+
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
+
+	struct NavMeshGeometryParseItem3D {
+		Transform3D transform;
+		// Surface arrays of a parsed mesh, or null when the item is a collision shape.
+		const LocalVector<Array> *mesh_surfaces = nullptr;
+		PhysicsServer3D::ShapeType shape_type = PhysicsServer3D::SHAPE_CUSTOM;
+		Variant shape_data;
+	};
+
+	struct NavMeshGeometryParseData3D {
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+		// Surface arrays are fetched once per mesh on the main thread, as it needs the RenderingServer.
+		HashMap<Ref<Mesh>, LocalVector<Array>> mesh_surfaces;
+		LocalVector<NavMeshGeometryParseItem3D> items;
+		// Each worker extracts a consecutive range of items into its own chunk.
+		LocalVector<Ref<NavigationMeshSourceGeometryData3D>> chunks;
+	};
+
+	static void generator_thread_parse_chunk(void *p_arg, uint32_t p_index);
+
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
-	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
+	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
-	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const NavMeshGeneratorTile3D *p_tile = nullptr);
 
-	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_mesh(NavMeshGeometryParseData3D &r_parse_data, const Ref<Mesh> &p_mesh, const Transform3D &p_xform);
+	static void generator_parse_shape(NavMeshGeometryParseData3D &r_parse_data, RID p_shape, const Transform3D &p_xform, bool p_warn_unsupported);
+	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node);
+	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node);
+	static void generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node);
 #ifdef MODULE_CSG_ENABLED
-	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node);
 #endif // MODULE_CSG_ENABLED
 #ifdef MODULE_GRIDMAP_ENABLED
-	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node);
 #endif // MODULE_GRIDMAP_ENABLED
-	static void generator_parse_navigationobstacle_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_navigationobstacle_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometryParseData3D &r_parse_data, Node *p_node);
 
 	static bool generator_emit_callback(const Callable &p_callback);
 
@@ -100,6 +140,7 @@ public:
 	static void parse_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
+	static Dictionary bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, real_t p_tile_size, const AABB &p_changed_aabb = AABB());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
 
 	NavMeshGenerator3D();
@@ -0,0 +1,631 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_3d.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_grid_3d.h"
+
+#include "nav_agent.h"
+
+#include "core/object/worker_thread_pool.h"
+
+// Same tolerance as the RVO2 linear programs.
+#define NAV_AVOIDANCE_GRID_EPSILON 0.00001
+#define NAV_AVOIDANCE_GRID_MIN_CELL_SIZE 0.01
+// Agents per worker chunk below which splitting the step is not worth the task overhead.
+#define NAV_AVOIDANCE_GRID_MIN_CHUNK_SIZE 64
+
+Vector3i NavAvoidanceGrid3D::_get_cell(real_t p_x, real_t p_y, real_t p_z) const {
+	// Clamping in floating point first also keeps NaN positions inside the grid.
+	return Vector3i(
+			int(MIN(MAX(Math::floor((p_x - grid_origin.x) / cell_size), (real_t)0.0), (real_t)(grid_size.x - 1))),
+			int(MIN(MAX(Math::floor((p_y - grid_origin.y) / cell_size), (real_t)0.0), (real_t)(grid_size.y - 1))),
+			int(MIN(MAX(Math::floor((p_z - grid_origin.z) / cell_size), (real_t)0.0), (real_t)(grid_size.z - 1))));
+}
+
+uint32_t NavAvoidanceGrid3D::_get_cell_index(const Vector3i &p_cell) const {
+	return (uint32_t(p_cell.z) * uint32_t(grid_size.y) + uint32_t(p_cell.y)) * uint32_t(grid_size.x) + uint32_t(p_cell.x);
+}
+
+void NavAvoidanceGrid3D::_build_grid(const LocalVector<NavAgent *> &p_agents) {
+	const uint32_t agent_count = p_agents.size();
+
+	unsorted_positions.resize(agent_count);
+	unsorted_cells.resize(agent_count);
+
+	real_t max_radius = 0.0;
+	for (uint32_t i = 0; i < agent_count; i++) {
+		const RVO3D::Agent3D *rvo_agent = p_agents[i]->get_rvo_agent_3d();
+		unsorted_positions[i] = Vector3(rvo_agent->position_.x(), rvo_agent->position_.y(), rvo_agent->position_.z());
+		max_radius = MAX(max_radius, (real_t)rvo_agent->radius_);
+	}
+
+	Vector3 grid_min = unsorted_positions[0];
+	Vector3 grid_max = unsorted_positions[0];
+	for (const Vector3 &position : unsorted_positions) {
+		grid_min = grid_min.min(position);
+		grid_max = grid_max.max(position);
+	}
+
+	// Start with cells that hold about one agent and grow them until the grid is at most
+	// a few times larger than the agent count, so sparse crowds do not end up with mostly empty cells.
+	grid_origin = grid_min;
+	grid_size = Vector3i(1, 1, 1);
+	cell_size = MAX(max_radius * 2.0, (real_t)NAV_AVOIDANCE_GRID_MIN_CELL_SIZE);
+
+	const Vector3 extent = grid_max - grid_min;
+	if (extent.is_finite()) {
+		const real_t max_cell_count = MAX(agent_count * 2, 64u);
+		while ((Math::floor(extent.x / cell_size) + 1.0) * (Math::floor(extent.y / cell_size) + 1.0) * (Math::floor(extent.z / cell_size) + 1.0) > max_cell_count) {
+			cell_size *= 2.0;
+		}
+		grid_size = Vector3i(int(extent.x / cell_size) + 1, int(extent.y / cell_size) + 1, int(extent.z / cell_size) + 1);
+	} else {
+		grid_origin = Vector3();
+	}
+
+	// Counting sort of the agents by cell.
+	const uint32_t cell_count = uint32_t(grid_size.x) * uint32_t(grid_size.y) * uint32_t(grid_size.z);
+	cell_offsets.resize(cell_count + 1);
+	for (uint32_t i = 0; i <= cell_count; i++) {
+		cell_offsets[i] = 0;
+	}
+
+	for (uint32_t i = 0; i < agent_count; i++) {
+		const Vector3 &position = unsorted_positions[i];
+		const uint32_t cell_index = _get_cell_index(_get_cell(position.x, position.y, position.z));
+		unsorted_cells[i] = cell_index;
+		cell_offsets[cell_index + 1]++;
+	}
+
+	for (uint32_t i = 0; i < cell_count; i++) {
+		cell_offsets[i + 1] += cell_offsets[i];
+	}
+
+	sorted_indices.resize(agent_count);
+	for (uint32_t i = 0; i < agent_count; i++) {
+		sorted_indices[cell_offsets[unsorted_cells[i]]++] = i;
+	}
+
+	// Placing the agents moved every offset to the start of the next cell, shift them back.
+	for (uint32_t i = cell_count; i > 0; i--) {
+		cell_offsets[i] = cell_offsets[i - 1];
+	}
+	cell_offsets[0] = 0;
+
+	agents.resize(agent_count);
+	position_x.resize(agent_count);
+	position_y.resize(agent_count);
+	position_z.resize(agent_count);
+	velocity_x.resize(agent_count);
+	velocity_y.resize(agent_count);
+	velocity_z.resize(agent_count);
+	radius.resize(agent_count);
+	avoidance_layers.resize(agent_count);
+	avoidance_priority.resize(agent_count);
+	preferred_velocity.resize(agent_count);
+	new_velocity.resize(agent_count);
+	max_speed.resize(agent_count);
+	neighbor_distance.resize(agent_count);
+	time_horizon.resize(agent_count);
+	max_neighbors.resize(agent_count);
+	avoidance_mask.resize(agent_count);
+
+	for (uint32_t i = 0; i < agent_count; i++) {
+		NavAgent *agent = p_agents[sorted_indices[i]];
+		const RVO3D::Agent3D *rvo_agent = agent->get_rvo_agent_3d();
+
+		agents[i] = agent;
+		position_x[i] = rvo_agent->position_.x();
+		position_y[i] = rvo_agent->position_.y();
+		position_z[i] = rvo_agent->position_.z();
+		velocity_x[i] = rvo_agent->velocity_.x();
+		velocity_y[i] = rvo_agent->velocity_.y();
+		velocity_z[i] = rvo_agent->velocity_.z();
+		radius[i] = rvo_agent->radius_;
+		avoidance_layers[i] = rvo_agent->avoidance_layers_;
+		avoidance_priority[i] = rvo_agent->avoidance_priority_;
+		preferred_velocity[i] = Vector3(rvo_agent->prefVelocity_.x(), rvo_agent->prefVelocity_.y(), rvo_agent->prefVelocity_.z());
+		max_speed[i] = rvo_agent->maxSpeed_;
+		neighbor_distance[i] = rvo_agent->neighborDist_;
+		time_horizon[i] = rvo_agent->timeHorizon_;
+		max_neighbors[i] = uint32_t(rvo_agent->maxNeighbors_);
+		avoidance_mask[i] = rvo_agent->avoidance_mask_;
+	}
+}
+
+uint32_t NavAvoidanceGrid3D::_compute_neighbors(uint32_t p_agent, Scratch &r_scratch) const {
+	const uint32_t neighbor_capacity = max_neighbors[p_agent];
+	if (neighbor_capacity == 0) {
+		return 0;
+	}
+
+	if (r_scratch.neighbors.size() < neighbor_capacity) {
+		r_scratch.neighbors.resize(neighbor_capacity);
+		r_scratch.neighbor_distances_sq.resize(neighbor_capacity);
+	}
+	uint32_t *neighbors = r_scratch.neighbors.ptr();
+	real_t *neighbor_distances_sq = r_scratch.neighbor_distances_sq.ptr();
+	uint32_t neighbor_count = 0;
+
+	const real_t agent_x = position_x[p_agent];
+	const real_t agent_y = position_y[p_agent];
+	const real_t agent_z = position_z[p_agent];
+	const uint32_t agent_mask = avoidance_mask[p_agent];
+	const real_t agent_priority = avoidance_priority[p_agent];
+	real_t range_sq = neighbor_distance[p_agent] * neighbor_distance[p_agent];
+
+	// Same selection rules as RVO3D::Agent3D::insertAgentNeighbor(), the closest agents are kept sorted by distance.
+	auto scan_cell = [&](uint32_t p_cell_index) {
+		const uint32_t cell_end = cell_offsets[p_cell_index + 1];
+		for (uint32_t other = cell_offsets[p_cell_index]; other < cell_end; other++) {
+			if (other == p_agent) {
+				continue;
+			}
+			if ((agent_mask & avoidance_layers[other]) == 0) {
+				continue;
+			}
+			if (agent_priority > avoidance_priority[other]) {
+				continue;
+			}
+
+			const real_t dx = position_x[other] - agent_x;
+			const real_t dy = position_y[other] - agent_y;
+			const real_t dz = position_z[other] - agent_z;
+			const real_t distance_sq = dx * dx + dy * dy + dz * dz;
+			if (distance_sq >= range_sq) {
+				continue;
+			}
+
+			if (neighbor_count < neighbor_capacity) {
+				neighbor_count++;
+			}
+
+			uint32_t slot = neighbor_count - 1;
+			while (slot != 0 && distance_sq < neighbor_distances_sq[slot - 1]) {
+				neighbors[slot] = neighbors[slot - 1];
+				neighbor_distances_sq[slot] = neighbor_distances_sq[slot - 1];
+				slot--;
+			}
+			neighbors[slot] = other;
+			neighbor_distances_sq[slot] = distance_sq;
+
+			if (neighbor_count == neighbor_capacity) {
+				range_sq = neighbor_distances_sq[neighbor_count - 1];
+			}
+		}
+	};
+
+	const Vector3i cell = _get_cell(agent_x, agent_y, agent_z);
+
+	// Cells are visited in growing rings around the agent cell. Ring `d` is at least
+	// (d - 1) cells plus the distance from the agent to its own cell border away.
+	const real_t local_x = agent_x - (grid_origin.x + cell.x * cell_size);
+	const real_t local_y = agent_y - (grid_origin.y + cell.y * cell_size);
+	const real_t local_z = agent_z - (grid_origin.z + cell.z * cell_size);
+	const real_t border_distance = MAX((real_t)0.0, MIN(MIN(MIN(local_x, cell_size - local_x), MIN(local_y, cell_size - local_y)), MIN(local_z, cell_size - local_z)));
+	const int max_ring = MAX(MAX(grid_size.x, grid_size.y), grid_size.z);
+
+	for (int ring = 0; ring <= max_ring; ring++) {
+		if (ring > 0) {
+			const real_t ring_distance = (ring - 1) * cell_size + border_distance;
+			if (ring_distance * ring_distance >= range_sq) {
+				break;
+			}
+		}
+
+		const int x_begin = MAX(cell.x - ring, 0);
+		const int x_end = MIN(cell.x + ring, grid_size.x - 1);
+		const int y_begin = MAX(cell.y - ring, 0);
+		const int y_end = MIN(cell.y + ring, grid_size.y - 1);
+		const int z_begin = MAX(cell.z - ring, 0);
+		const int z_end = MIN(cell.z + ring, grid_size.z - 1);
+
+		for (int z = z_begin; z <= z_end; z++) {
+			for (int y = y_begin; y <= y_end; y++) {
+				if (ABS(z - cell.z) == ring || ABS(y - cell.y) == ring) {
+					// Rows on the ring faces are fully part of the ring.
+					for (int x = x_begin; x <= x_end; x++) {
+						scan_cell(_get_cell_index(Vector3i(x, y, z)));
+					}
+				} else {
+					// Inner rows only touch the ring at both ends.
+					if (cell.x - ring >= 0) {
+						scan_cell(_get_cell_index(Vector3i(cell.x - ring, y, z)));
+					}
+					if (cell.x + ring < grid_size.x) {
+						scan_cell(_get_cell_index(Vector3i(cell.x + ring, y, z)));
+					}
+				}
+			}
+		}
+	}
+
+	return neighbor_count;
+}
+
+// The three ORCA cases of RVO3D::Agent3D::computeNewVelocity() (cut-off sphere, cone and collision)
+// all build the plane from w = relative_velocity - scale * relative_position and only differ in `scale`.
+// Computing every case and selecting the scale keeps the loop free of branches, and the restrict
+// qualified arrays let the compiler vectorize it.
+static void _build_orca_planes(uint32_t p_count, const real_t *__restrict p_relative_position_x, const real_t *__restrict p_relative_position_y, const real_t *__restrict p_relative_position_z,
+		const real_t *__restrict p_relative_velocity_x, const real_t *__restrict p_relative_velocity_y, const real_t *__restrict p_relative_velocity_z, const real_t *__restrict p_combined_radius,
+		real_t p_velocity_x, real_t p_velocity_y, real_t p_velocity_z, real_t p_inv_time_horizon, real_t p_inv_time_step,
+		real_t *__restrict r_normal_x, real_t *__restrict r_normal_y, real_t *__restrict r_normal_z, real_t *__restrict r_point_x, real_t *__restrict r_point_y, real_t *__restrict r_point_z) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		const real_t px = p_relative_position_x[i];
+		const real_t py = p_relative_position_y[i];
+		const real_t pz = p_relative_position_z[i];
+		const real_t vx = p_relative_velocity_x[i];
+		const real_t vy = p_relative_velocity_y[i];
+		const real_t vz = p_relative_velocity_z[i];
+		const real_t radius_sum = p_combined_radius[i];
+		const real_t radius_sum_sq = radius_sum * radius_sum;
+		const real_t distance_sq = px * px + py * py + pz * pz;
+
+		// Vector from the cut-off center to the relative velocity.
+		const real_t cutoff_x = vx - p_inv_time_horizon * px;
+		const real_t cutoff_y = vy - p_inv_time_horizon * py;
+		const real_t cutoff_z = vz - p_inv_time_horizon * pz;
+		const real_t cutoff_length_sq = cutoff_x * cutoff_x + cutoff_y * cutoff_y + cutoff_z * cutoff_z;
+		const real_t cutoff_dot = cutoff_x * px + cutoff_y * py + cutoff_z * pz;
+		// Bitwise and, so that both comparisons are always evaluated and no branch is introduced.
+		const bool project_on_cutoff = (cutoff_dot < (real_t)0.0) & (cutoff_dot * cutoff_dot > radius_sum_sq * cutoff_length_sq);
+
+		// Projection on the cone legs.
+		const real_t b = px * vx + py * vy + pz * vz;
+		const real_t cross_x = py * vz - pz * vy;
+		const real_t cross_y = pz * vx - px * vz;
+		const real_t cross_z = px * vy - py * vx;
+		const real_t c = (vx * vx + vy * vy + vz * vz) - (cross_x * cross_x + cross_y * cross_y + cross_z * cross_z) / MAX(distance_sq - radius_sum_sq, (real_t)NAV_AVOIDANCE_GRID_EPSILON);
+		const real_t cone_scale = (b + Math::sqrt(MAX(b * b - distance_sq * c, (real_t)0.0))) / MAX(distance_sq, (real_t)NAV_AVOIDANCE_GRID_EPSILON);
+
+		const bool collision = distance_sq <= radius_sum_sq;
+		const real_t scale = collision ? p_inv_time_step : (project_on_cutoff ? p_inv_time_horizon : cone_scale);
+
+		const real_t wx = vx - scale * px;
+		const real_t wy = vy - scale * py;
+		const real_t wz = vz - scale * pz;
+		const real_t w_length = Math::sqrt(wx * wx + wy * wy + wz * wz);
+		const real_t inv_w_length = (real_t)1.0 / MAX(w_length, (real_t)NAV_AVOIDANCE_GRID_EPSILON);
+		const real_t nx = wx * inv_w_length;
+		const real_t ny = wy * inv_w_length;
+		const real_t nz = wz * inv_w_length;
+		const real_t half_u_length = (real_t)0.5 * (radius_sum * scale - w_length);
+
+		r_normal_x[i] = nx;
+		r_normal_y[i] = ny;
+		r_normal_z[i] = nz;
+		r_point_x[i] = p_velocity_x + half_u_length * nx;
+		r_point_y[i] = p_velocity_y + half_u_length * ny;
+		r_point_z[i] = p_velocity_z + half_u_length * nz;
+	}
+}
+
+void NavAvoidanceGrid3D::_compute_orca_planes(uint32_t p_agent, uint32_t p_neighbor_count, Scratch &r_scratch) const {
+	r_scratch.relative_position_x.resize(p_neighbor_count);
+	r_scratch.relative_position_y.resize(p_neighbor_count);
+	r_scratch.relative_position_z.resize(p_neighbor_count);
+	r_scratch.relative_velocity_x.resize(p_neighbor_count);
+	r_scratch.relative_velocity_y.resize(p_neighbor_count);
+	r_scratch.relative_velocity_z.resize(p_neighbor_count);
+	r_scratch.combined_radius.resize(p_neighbor_count);
+	r_scratch.plane_normal_x.resize(p_neighbor_count);
+	r_scratch.plane_normal_y.resize(p_neighbor_count);
+	r_scratch.plane_normal_z.resize(p_neighbor_count);
+	r_scratch.plane_point_x.resize(p_neighbor_count);
+	r_scratch.plane_point_y.resize(p_neighbor_count);
+	r_scratch.plane_point_z.resize(p_neighbor_count);
+	r_scratch.planes.resize(p_neighbor_count);
+
+	const real_t agent_velocity_x = velocity_x[p_agent];
+	const real_t agent_velocity_y = velocity_y[p_agent];
+	const real_t agent_velocity_z = velocity_z[p_agent];
+
+	// Gather the neighbor data next to each other so the plane construction below runs over plain arrays.
+	for (uint32_t i = 0; i < p_neighbor_count; i++) {
+		const uint32_t other = r_scratch.neighbors[i];
+		r_scratch.relative_position_x[i] = position_x[other] - position_x[p_agent];
+		r_scratch.relative_position_y[i] = position_y[other] - position_y[p_agent];
+		r_scratch.relative_position_z[i] = position_z[other] - position_z[p_agent];
+		r_scratch.relative_velocity_x[i] = agent_velocity_x - velocity_x[other];
+		r_scratch.relative_velocity_y[i] = agent_velocity_y - velocity_y[other];
+		r_scratch.relative_velocity_z[i] = agent_velocity_z - velocity_z[other];
+		r_scratch.combined_radius[i] = radius[p_agent] + radius[other];
+	}
+
+	_build_orca_planes(p_neighbor_count, r_scratch.relative_position_x.ptr(), r_scratch.relative_position_y.ptr(), r_scratch.relative_position_z.ptr(),
+			r_scratch.relative_velocity_x.ptr(), r_scratch.relative_velocity_y.ptr(), r_scratch.relative_velocity_z.ptr(), r_scratch.combined_radius.ptr(),
+			agent_velocity_x, agent_velocity_y, agent_velocity_z, (real_t)1.0 / time_horizon[p_agent], (real_t)1.0 / time_step,
+			r_scratch.plane_normal_x.ptr(), r_scratch.plane_normal_y.ptr(), r_scratch.plane_normal_z.ptr(),
+			r_scratch.plane_point_x.ptr(), r_scratch.plane_point_y.ptr(), r_scratch.plane_point_z.ptr());
+
+	for (uint32_t i = 0; i < p_neighbor_count; i++) {
+		OrcaPlane &plane = r_scratch.planes[i];
+		plane.normal = Vector3(r_scratch.plane_normal_x[i], r_scratch.plane_normal_y[i], r_scratch.plane_normal_z[i]);
+		plane.point = Vector3(r_scratch.plane_point_x[i], r_scratch.plane_point_y[i], r_scratch.plane_point_z[i]);
+	}
+}
+
+void NavAvoidanceGrid3D::_compute_chunk(uint32_t p_chunk, Scratch *p_scratch) {
+	Scratch &scratch = p_scratch[p_chunk];
+
+	const uint32_t begin = p_chunk * chunk_size;
+	const uint32_t end = MIN(begin + chunk_size, agents.size());
+
+	for (uint32_t i = begin; i < end; i++) {
+		const uint32_t neighbor_count = _compute_neighbors(i, scratch);
+		_compute_orca_planes(i, neighbor_count, scratch);
+
+		Vector3 result;
+		const uint32_t plane_fail = _linear_program_3(scratch.planes, max_speed[i], preferred_velocity[i], false, result);
+		if (plane_fail < scratch.planes.size()) {
+			_linear_program_4(scratch.planes, plane_fail, max_speed[i], scratch.projected_planes, result);
+		}
+		new_velocity[i] = result;
+	}
+}
+
+// The linear programs below are the RVO2 3D solver ported to Godot types, see thirdparty/rvo2/rvo2_3d/Agent3d.cpp.
+
+bool NavAvoidanceGrid3D::_linear_program_1(const LocalVector<OrcaPlane> &p_planes, uint32_t p_plane_index, const Vector3 &p_line_point, const Vector3 &p_line_direction, real_t p_radius, const Vector3 &p_opt_velocity, bool p_direction_opt, Vector3 &r_result) {
+	const real_t dot_product = p_line_point.dot(p_line_direction);
+	const real_t discriminant = dot_product * dot_product + p_radius * p_radius - p_line_point.length_squared();
+
+	if (discriminant < 0.0) {
+		// Max speed sphere fully invalidates line.
+		return false;
+	}
+
+	const real_t sqrt_discriminant = Math::sqrt(discriminant);
+	real_t t_left = -dot_product - sqrt_discriminant;
+	real_t t_right = -dot_product + sqrt_discriminant;
+
+	for (uint32_t i = 0; i < p_plane_index; i++) {
+		const real_t numerator = (p_planes[i].point - p_line_point).dot(p_planes[i].normal);
+		const real_t denominator = p_line_direction.dot(p_planes[i].normal);
+
+		if (denominator * denominator <= NAV_AVOIDANCE_GRID_EPSILON) {
+			// Line is (almost) parallel to plane i.
+			if (numerator > 0.0) {
+				return false;
+			}
+			continue;
+		}
+
+		const real_t t = numerator / denominator;
+
+		if (denominator >= 0.0) {
+			// Plane i bounds line on the left.
+			t_left = MAX(t_left, t);
+		} else {
+			// Plane i bounds line on the right.
+			t_right = MIN(t_right, t);
+		}
+
+		if (t_left > t_right) {
+			return false;
+		}
+	}
+
+	if (p_direction_opt) {
+		// Optimize direction.
+		if (p_opt_velocity.dot(p_line_direction) > 0.0) {
+			// Take right extreme.
+			r_result = p_line_point + t_right * p_line_direction;
+		} else {
+			// Take left extreme.
+			r_result = p_line_point + t_left * p_line_direction;
+		}
+	} else {
+		// Optimize closest point.
+		const real_t t = p_line_direction.dot(p_opt_velocity - p_line_point);
+
+		if (t < t_left) {
+			r_result = p_line_point + t_left * p_line_direction;
+		} else if (t > t_right) {
+			r_result = p_line_point + t_right * p_line_direction;
+		} else {
+			r_result = p_line_point + t * p_line_direction;
+		}
+	}
+
+	return true;
+}
+
+bool NavAvoidanceGrid3D::_linear_program_2(const LocalVector<OrcaPlane> &p_planes, uint32_t p_plane_index, real_t p_radius, const Vector3 &p_opt_velocity, bool p_direction_opt, Vector3 &r_result) {
+	const OrcaPlane &plane = p_planes[p_plane_index];
+	const real_t plane_distance = plane.point.dot(plane.normal);
+	const real_t plane_distance_sq = plane_distance * plane_distance;
+	const real_t radius_sq = p_radius * p_radius;
+
+	if (plane_distance_sq > radius_sq) {
+		// Max speed sphere fully invalidates plane.
+		return false;
+	}
+
+	const real_t plane_radius_sq = radius_sq - plane_distance_sq;
+	const Vector3 plane_center = plane_distance * plane.normal;
+
+	if (p_direction_opt) {
+		// Project direction p_opt_velocity on plane.
+		const Vector3 plane_opt_velocity = p_opt_velocity - p_opt_velocity.dot(plane.normal) * plane.normal;
+		const real_t plane_opt_velocity_length_sq = plane_opt_velocity.length_squared();
+
+		if (plane_opt_velocity_length_sq <= NAV_AVOIDANCE_GRID_EPSILON) {
+			r_result = plane_center;
+		} else {
+			r_result = plane_center + Math::sqrt(plane_radius_sq / plane_opt_velocity_length_sq) * plane_opt_velocity;
+		}
+	} else {
+		// Project point p_opt_velocity on plane.
+		r_result = p_opt_velocity + (plane.point - p_opt_velocity).dot(plane.normal) * plane.normal;
+
+		// If outside the plane circle, project on the plane circle.
+		if (r_result.length_squared() > radius_sq) {
+			const Vector3 plane_result = r_result - plane_center;
+			const real_t plane_result_length_sq = plane_result.length_squared();
+			r_result = plane_center + Math::sqrt(plane_radius_sq / plane_result_length_sq) * plane_result;
+		}
+	}
+
+	for (uint32_t i = 0; i < p_plane_index; i++) {
+		if (p_planes[i].normal.dot(p_planes[i].point - r_result) > 0.0) {
+			// Result does not satisfy constraint i, compute the intersection line of plane i and this plane.
+			const Vector3 cross_product = p_planes[i].normal.cross(plane.normal);
+
+			if (cross_product.length_squared() <= NAV_AVOIDANCE_GRID_EPSILON) {
+				// Planes are (almost) parallel, and plane i fully invalidates this plane.
+				return false;
+			}
+
+			const Vector3 line_direction = cross_product.normalized();
+			const Vector3 line_normal = line_direction.cross(plane.normal);
+			const Vector3 line_point = plane.point + ((p_planes[i].point - plane.point).dot(p_planes[i].normal) / line_normal.dot(p_planes[i].normal)) * line_normal;
+
+			if (!_linear_program_1(p_planes, i, line_point, line_direction, p_radius, p_opt_velocity, p_direction_opt, r_result)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+uint32_t NavAvoidanceGrid3D::_linear_program_3(const LocalVector<OrcaPlane> &p_planes, real_t p_radius, const Vector3 &p_opt_velocity, bool p_direction_opt, Vector3 &r_result) {
+	if (p_direction_opt) {
+		// Optimize direction. The optimization velocity is of unit length in this case.
+		r_result = p_opt_velocity * p_radius;
+	} else if (p_opt_velocity.length_squared() > p_radius * p_radius) {
+		// Optimize closest point and outside sphere.
+		r_result = p_opt_velocity.normalized() * p_radius;
+	} else {
+		// Optimize closest point and inside sphere.
+		r_result = p_opt_velocity;
+	}
+
+	for (uint32_t i = 0; i < p_planes.size(); i++) {
+		if (p_planes[i].normal.dot(p_planes[i].point - r_result) > 0.0) {
+			// Result does not satisfy constraint i, compute a new optimal result.
+			const Vector3 previous_result = r_result;
+
+			if (!_linear_program_2(p_planes, i, p_radius, p_opt_velocity, p_direction_opt, r_result)) {
+				r_result = previous_result;
+				return i;
+			}
+		}
+	}
+
+	return p_planes.size();
+}
+
+void NavAvoidanceGrid3D::_linear_program_4(const LocalVector<OrcaPlane> &p_planes, uint32_t p_begin_plane, real_t p_radius, LocalVector<OrcaPlane> &r_projected_planes, Vector3 &r_result) {
+	real_t distance = 0.0;
+
+	for (uint32_t i = p_begin_plane; i < p_planes.size(); i++) {
+		if (p_planes[i].normal.dot(p_planes[i].point - r_result) <= distance) {
+			continue;
+		}
+
+		// Result does not satisfy constraint of plane i.
+		r_projected_planes.clear();
+
+		for (uint32_t j = 0; j < i; j++) {
+			OrcaPlane projected_plane;
+
+			const Vector3 cross_product = p_planes[j].normal.cross(p_planes[i].normal);
+
+			if (cross_product.length_squared() <= NAV_AVOIDANCE_GRID_EPSILON) {
+				// Plane i and plane j are (almost) parallel.
+				if (p_planes[i].normal.dot(p_planes[j].normal) > 0.0) {
+					// Plane i and plane j point in the same direction.
+					continue;
+				}
+				// Plane i and plane j point in opposite directions.
+				projected_plane.point = 0.5 * (p_planes[i].point + p_planes[j].point);
+			} else {
+				// Point on the line of intersection between plane i and plane j.
+				const Vector3 line_normal = cross_product.cross(p_planes[i].normal);
+				projected_plane.point = p_planes[i].point + ((p_planes[j].point - p_planes[i].point).dot(p_planes[j].normal) / line_normal.dot(p_planes[j].normal)) * line_normal;
+			}
+
+			projected_plane.normal = (p_planes[j].normal - p_planes[i].normal).normalized();
+			r_projected_planes.push_back(projected_plane);
+		}
+
+		const Vector3 previous_result = r_result;
+
+		if (_linear_program_3(r_projected_planes, p_radius, p_planes[i].normal, true, r_result) < r_projected_planes.size()) {
+			// This should in principle not happen. The result is by definition already in the feasible region of this
+			// linear program. If it fails, it is due to small floating point error, and the current result is kept.
+			r_result = previous_result;
+		}
+
+		distance = p_planes[i].normal.dot(p_planes[i].point - r_result);
+	}
+}
+
+void NavAvoidanceGrid3D::step(const LocalVector<NavAgent *> &p_agents, real_t p_time_step, bool p_use_threads, bool p_use_high_priority_threads) {
+	const uint32_t agent_count = p_agents.size();
+	if (agent_count == 0) {
+		return;
+	}
+
+	// A zero time step would turn the collision case into infinite velocities.
+	time_step = MAX(p_time_step, (real_t)CMP_EPSILON);
+
+	_build_grid(p_agents);
+
+	uint32_t chunk_count = 1;
+	if (p_use_threads) {
+		chunk_count = CLAMP(agent_count / NAV_AVOIDANCE_GRID_MIN_CHUNK_SIZE, 1u, uint32_t(WorkerThreadPool::get_singleton()->get_thread_count()) * 4);
+	}
+	chunk_size = (agent_count + chunk_count - 1) / chunk_count;
+
+	if (chunk_scratch.size() < chunk_count) {
+		chunk_scratch.resize(chunk_count);
+	}
+
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavAvoidanceGrid3D::_compute_chunk, chunk_scratch.ptr(), chunk_count, -1, p_use_high_priority_threads, SNAME("GridAvoidanceAgents3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_compute_chunk(0, chunk_scratch.ptr());
+	}
+
+	// Velocities are only written back once all agents are solved, so every agent sees the same neighbor state.
+	for (uint32_t i = 0; i < agent_count; i++) {
+		NavAgent *agent = agents[i];
+		RVO3D::Agent3D *rvo_agent = agent->get_rvo_agent_3d();
+		const Vector3 &velocity = new_velocity[i];
+		rvo_agent->newVelocity_ = RVO3D::Vector3(velocity.x, velocity.y, velocity.z);
+		rvo_agent->velocity_ = rvo_agent->newVelocity_;
+		rvo_agent->position_ += rvo_agent->velocity_ * float(time_step);
+		agent->update();
+	}
+}
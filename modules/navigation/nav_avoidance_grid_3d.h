@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_AVOIDANCE_GRID_3D_H
+#define NAV_AVOIDANCE_GRID_3D_H
+
+#include "core/math/vector3.h"
+#include "core/math/vector3i.h"
+#include "core/templates/local_vector.h"
+
+class NavAgent;
+
+// Alternative 3D avoidance backend to the RVO2 simulation.
+// Agent data is copied each step into contiguous arrays sorted by a uniform grid,
+// so that neighbor searches and ORCA plane construction walk linear memory
+// instead of chasing agent pointers through a KD-tree.
+class NavAvoidanceGrid3D {
+	struct OrcaPlane {
+		Vector3 point;
+		Vector3 normal;
+	};
+
+	// Per worker chunk buffers, kept between steps to avoid reallocations.
+	struct Scratch {
+		LocalVector<uint32_t> neighbors;
+		LocalVector<real_t> neighbor_distances_sq;
+
+		LocalVector<real_t> relative_position_x;
+		LocalVector<real_t> relative_position_y;
+		LocalVector<real_t> relative_position_z;
+		LocalVector<real_t> relative_velocity_x;
+		LocalVector<real_t> relative_velocity_y;
+		LocalVector<real_t> relative_velocity_z;
+		LocalVector<real_t> combined_radius;
+
+		LocalVector<real_t> plane_normal_x;
+		LocalVector<real_t> plane_normal_y;
+		LocalVector<real_t> plane_normal_z;
+		LocalVector<real_t> plane_point_x;
+		LocalVector<real_t> plane_point_y;
+		LocalVector<real_t> plane_point_z;
+
+		LocalVector<OrcaPlane> planes;
+		LocalVector<OrcaPlane> projected_planes;
+	};
+
+	// Agents and their simulation data, all in grid cell order.
+	LocalVector<NavAgent *> agents;
+	LocalVector<real_t> position_x;
+	LocalVector<real_t> position_y;
+	LocalVector<real_t> position_z;
+	LocalVector<real_t> velocity_x;
+	LocalVector<real_t> velocity_y;
+	LocalVector<real_t> velocity_z;
+	LocalVector<real_t> radius;
+	LocalVector<uint32_t> avoidance_layers;
+	LocalVector<real_t> avoidance_priority;
+
+	// Only read by the agent itself.
+	LocalVector<Vector3> preferred_velocity;
+	LocalVector<Vector3> new_velocity;
+	LocalVector<real_t> max_speed;
+	LocalVector<real_t> neighbor_distance;
+	LocalVector<real_t> time_horizon;
+	LocalVector<uint32_t> max_neighbors;
+	LocalVector<uint32_t> avoidance_mask;
+
+	// Uniform grid, agents of cell `c` are in the range [cell_offsets[c], cell_offsets[c + 1]).
+	Vector3 grid_origin;
+	Vector3i grid_size;
+	real_t cell_size = 1.0;
+	LocalVector<uint32_t> cell_offsets;
+
+	// Temporary buffers for sorting the agents into the grid.
+	LocalVector<Vector3> unsorted_positions;
+	LocalVector<uint32_t> unsorted_cells;
+	LocalVector<uint32_t> sorted_indices;
+
+	LocalVector<Scratch> chunk_scratch;
+	uint32_t chunk_size = 0;
+	real_t time_step = 0.0;
+
+	Vector3i _get_cell(real_t p_x, real_t p_y, real_t p_z) const;
+	uint32_t _get_cell_index(const Vector3i &p_cell) const;
+
+	void _build_grid(const LocalVector<NavAgent *> &p_agents);
+	void _compute_chunk(uint32_t p_chunk, Scratch *p_scratch);
+	uint32_t _compute_neighbors(uint32_t p_agent, Scratch &r_scratch) const;
+	void _compute_orca_planes(uint32_t p_agent, uint32_t p_neighbor_count, Scratch &r_scratch) const;
+
+	static bool _linear_program_1(const LocalVector<OrcaPlane> &p_planes, uint32_t p_plane_index, const Vector3 &p_line_point, const Vector3 &p_line_direction, real_t p_radius, const Vector3 &p_opt_velocity, bool p_direction_opt, Vector3 &r_result);
+	static bool _linear_program_2(const LocalVector<OrcaPlane> &p_planes, uint32_t p_plane_index, real_t p_radius, const Vector3 &p_opt_velocity, bool p_direction_opt, Vector3 &r_result);
+	static uint32_t _linear_program_3(const LocalVector<OrcaPlane> &p_planes, real_t p_radius, const Vector3 &p_opt_velocity, bool p_direction_opt, Vector3 &r_result);
+	static void _linear_program_4(const LocalVector<OrcaPlane> &p_planes, uint32_t p_begin_plane, real_t p_radius, LocalVector<OrcaPlane> &r_projected_planes, Vector3 &r_result);
+
+public:
+	// Computes the new velocities of all agents and writes them back to their RVO agents.
+	void step(const LocalVector<NavAgent *> &p_agents, real_t p_time_step, bool p_use_threads, bool p_use_high_priority_threads);
+};
+
+#endif // NAV_AVOIDANCE_GRID_3D_H
@@ -37,11 +37,18 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
 
 #include <Obstacle2d.h>
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+// Maximum number of region polygons grouped into one cluster of the hierarchical search graph.
+#define NAVMAP_CLUSTER_POLYGON_COUNT 64
+
+// Maximum number of destinations whose flow fields are kept until the map changes.
+#define NAVMAP_FLOW_FIELD_CACHE_SIZE 16
+
 // Helper macro
 #define APPEND_METADATA(poly)                                  \
 	if (r_path_types) {                                        \
@@ -135,7 +142,7 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_hierarchical) const {
 	RWLockRead read_lock(map_rwlock);
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -154,40 +161,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
+	// Only consider polygons in regions with compatible layers.
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
+	const gd::Polygon *begin_poly = _get_closest_polygon(p_origin, true, p_navigation_layers, begin_point);
+	const gd::Polygon *end_poly = _get_closest_polygon(p_destination, true, p_navigation_layers, end_point);
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -219,9 +198,13 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// For hierarchical queries, search the cluster graph first and only refine the path inside the found corridor.
+	LocalVector<uint8_t> corridor;
+	bool use_corridor = p_hierarchical && _get_cluster_corridor(begin_poly, end_poly, p_navigation_layers, corridor);
+
 	// List of all reachable navigation polys.
 	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	navigation_polys.reserve(pm_polygon_count * 0.75);
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -256,6 +239,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Only consider polygons inside the cluster corridor.
+				if (use_corridor && !corridor[connection.polygon->cluster_id]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -305,6 +293,24 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
 		if (to_visit.size() == 0) {
+			if (use_corridor) {
+				// The corridor did not lead to the end polygon, so search the whole map instead.
+				use_corridor = false;
+
+				gd::NavigationPoly np = navigation_polys[0];
+				navigation_polys.clear();
+				navigation_polys.push_back(np);
+				to_visit.clear();
+				to_visit.push_back(0);
+				least_cost_id = 0;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -600,6 +606,47 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	return path;
 }
 
+Vector3 NavMap::get_flow_field_direction(const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers) const {
+	RWLockRead read_lock(map_rwlock);
+	if (iteration_id == 0) {
+		NAVMAP_ITERATION_ZERO_ERROR_MSG();
+		return Vector3();
+	}
+
+	Vector3 begin_point;
+	const gd::Polygon *begin_poly = _get_closest_polygon(p_origin, true, p_navigation_layers, begin_point);
+	if (!begin_poly) {
+		return Vector3();
+	}
+
+	// Only the map sync invalidates the flow fields, including for changed layers and costs, and it never runs during a query.
+	// The lock is held while sampling, as another query may replace the flow field in the cache.
+	MutexLock lock(flow_fields_mutex);
+	const gd::FlowField *flow_field = const_cast<NavMap *>(this)->_get_flow_field(p_destination, p_navigation_layers);
+	if (!flow_field) {
+		return Vector3();
+	}
+
+	// Follow the next hops until there is a point to move to, the origin may already lie on the exit of its polygon.
+	uint32_t id = begin_poly->flow_field_id;
+	while (id != UINT32_MAX) {
+		const gd::FlowFieldCell &cell = flow_field->cells[id];
+		if (cell.traveled_distance == FLT_MAX) {
+			// The destination can not be reached from this polygon.
+			return Vector3();
+		}
+
+		const Vector3 direction = cell.exit - begin_point;
+		if (!direction.is_zero_approx()) {
+			return direction.normalized();
+		}
+		id = cell.next_id;
+	}
+
+	// The origin is at the destination.
+	return Vector3();
+}
+
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	RWLockRead read_lock(map_rwlock);
 	if (iteration_id == 0) {
@@ -611,10 +658,18 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 	Vector3 closest_point;
 	real_t closest_point_d = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
+	if (polygons_bvh.is_empty()) {
+		return closest_point;
+	}
+
+	// Only polygons with bounds crossed by the segment can intersect it.
+	LocalVector<const gd::Polygon *> candidates;
+	_query_polygons(p_from, p_to, candidates);
+
+	for (const gd::Polygon *p : candidates) {
 		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+		for (size_t point_id = 2; point_id < p->points.size(); point_id += 1) {
+			const Face3 f(p->points[0].pos, p->points[point_id - 1].pos, p->points[point_id].pos);
 			Vector3 inters;
 			if (f.intersects_segment(p_from, p_to, &inters)) {
 				const real_t d = closest_point_d = p_from.distance_to(inters);
@@ -628,16 +683,32 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 				}
 			}
 		}
+	}
+
+	if (use_collision) {
+		return closest_point;
+	}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
+	// Find the closest polygon edge, growing the searched bounds around the segment until
+	// they are at least as large as the closest distance found so far.
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+	real_t search_radius = polygons_search_radius;
+	while (true) {
+		closest_point_d = FLT_MAX;
+
+		const AABB search_aabb = segment_aabb.grow(search_radius);
+		_query_polygons(search_aabb, false, 0, candidates);
+
+		for (const gd::Polygon *p : candidates) {
+			for (size_t point_id = 0; point_id < p->points.size(); point_id += 1) {
 				Vector3 a, b;
 
 				Geometry3D::get_closest_points_between_segments(
 						p_from,
 						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
+						p->points[point_id].pos,
+						p->points[(point_id + 1) % p->points.size()].pos,
 						a,
 						b);
 
@@ -648,6 +719,11 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 				}
 			}
 		}
+
+		if (closest_point_d <= search_radius || search_aabb.encloses(polygons_aabb)) {
+			break;
+		}
+		search_radius = closest_point_d < FLT_MAX ? closest_point_d : search_radius * 2.0;
 	}
 
 	return closest_point;
@@ -687,21 +763,9 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	RWLockRead read_lock(map_rwlock);
 
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+	const gd::Polygon *closest_polygon = _get_closest_polygon(p_point, false, 0, result.point, &result.normal);
+	if (closest_polygon) {
+		result.owner = closest_polygon->owner->get_self();
 	}
 
 	return result;
@@ -709,27 +773,27 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+	regions_dirty = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+		regions_dirty = true;
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	links_dirty = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		links_dirty = true;
 	}
 }
 
@@ -880,6 +944,7 @@ Vector3 NavMap::get_random_point(uint32_t p_navigation_layers, bool p_uniformly)
 }
 
 void NavMap::sync() {
+	MutexLock turnstile_lock(sync_turnstile);
 	RWLockWrite write_lock(map_rwlock);
 
 	// Performance Monitor
@@ -900,99 +965,351 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
+	// Only the regions that changed since the last sync get their polygons rebuilt.
+	HashSet<const NavRegion *> changed_regions;
 	for (NavRegion *region : regions) {
 		if (region->sync()) {
-			regenerate_links = true;
+			changed_regions.insert(region);
 		}
 	}
 
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
-			regenerate_links = true;
+			links_dirty = true;
+		}
+	}
+
+	// Changed layers or costs leave the polygons alone, but the flow fields computed with them are stale.
+	for (NavRegion *region : regions) {
+		if (region->check_costs_dirty()) {
+			flow_fields_dirty = true;
 		}
 	}
+	for (NavLink *link : links) {
+		if (link->check_costs_dirty()) {
+			flow_fields_dirty = true;
+		}
+	}
+
+	const bool update_regions = regenerate_links || regions_dirty || !changed_regions.is_empty();
+	if (update_regions || links_dirty) {
+		// Links are always connected again, clear their connections while the connected polygons still exist.
+		_clear_link_connections();
+
+		if (update_regions) {
+			// Regions whose border edges need to be connected again.
+			HashSet<RegionPolygons *> affected_regions;
+
+			HashSet<const NavRegion *> map_regions;
+			for (const NavRegion *region : regions) {
+				map_regions.insert(region);
+			}
+
+			// Remove the polygons of the regions that changed, got disabled or are no longer on the map.
+			// The regions removed from the map may already be freed, so they are never accessed.
+			LocalVector<RegionPolygons *> removed_regions;
+			for (const KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+				if (!map_regions.has(E.key)) {
+					removed_regions.push_back(E.value);
+				} else if (regenerate_links || changed_regions.has(E.key) || !E.value->region->get_enabled()) {
+					E.value->region->get_connections().clear();
+					removed_regions.push_back(E.value);
+				}
+			}
+			for (RegionPolygons *removed_region : removed_regions) {
+				region_polygons.erase(removed_region->region);
+				_remove_region_polygons(removed_region, affected_regions);
+			}
+
+			for (NavRegion *region : regions) {
+				if (region->get_enabled() && !region_polygons.has(region)) {
+					_add_region_polygons(region, affected_regions);
+				}
+			}
+
+			if (regenerate_links) {
+				polygons_bvh.optimize_top_down();
+				border_edges_bvh.optimize_top_down();
+			}
+
+			for (RegionPolygons *affected_region : affected_regions) {
+				_connect_region_border_edges(affected_region);
+			}
+
+			_update_polygons_bounds();
+		}
+
+		_update_link_connections();
+		clusters_dirty = true;
+		flow_fields_dirty = true;
 
-	if (regenerate_links) {
 		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
+		_new_pm_edge_count = border_edge_keys.size();
 		_new_pm_edge_merge_count = 0;
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
 
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
-			region->get_connections().clear();
+		for (const KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+			_new_pm_polygon_count += E.value->polygons.size();
+			_new_pm_edge_count += E.value->edge_merge_count;
+			_new_pm_edge_merge_count += E.value->edge_merge_count;
+			_new_pm_edge_connection_count += E.value->edge_connection_count;
 		}
-
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+		for (const KeyValue<gd::EdgeKey, LocalVector<BorderEdge *>> &E : border_edge_keys) {
+			if (E.value.size() == 2) {
+				_new_pm_edge_merge_count += 1;
+			} else if (E.value.size() == 1 && use_edge_connections && E.value[0]->region->region->get_use_edge_connections()) {
+				_new_pm_edge_free_count += 1;
 			}
-			count += region->get_polygons().size();
 		}
-		polygons.resize(count);
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
-			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
-			}
-			count += region->get_polygons().size();
+		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
+		iteration_id = iteration_id % UINT32_MAX + 1;
+	}
+
+	// Do we have modified obstacle positions?
+	for (NavObstacle *obstacle : obstacles) {
+		if (obstacle->check_dirty()) {
+			obstacles_dirty = true;
+		}
+	}
+	// Do we have modified agent arrays?
+	for (NavAgent *agent : agents) {
+		if (agent->check_dirty()) {
+			agents_dirty = true;
 		}
+	}
 
-		_new_pm_polygon_count = polygons.size();
+	// Update avoidance worlds.
+	if (obstacles_dirty || agents_dirty) {
+		_update_rvo_simulation();
+	}
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+	regenerate_polygons = false;
+	regenerate_links = false;
+	regions_dirty = false;
+	links_dirty = false;
+	obstacles_dirty = false;
+	agents_dirty = false;
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
-				}
-			}
+	// Performance Monitor.
+	pm_region_count = _new_pm_region_count;
+	pm_agent_count = _new_pm_agent_count;
+	pm_link_count = _new_pm_link_count;
+	pm_polygon_count = _new_pm_polygon_count;
+	pm_edge_count = _new_pm_edge_count;
+	pm_edge_merge_count = _new_pm_edge_merge_count;
+	pm_edge_connection_count = _new_pm_edge_connection_count;
+	pm_edge_free_count = _new_pm_edge_free_count;
+}
+
+struct NavMapPolygonCollector {
+	LocalVector<const gd::Polygon *> *polygons = nullptr;
+	uint32_t navigation_layers = 0;
+	bool use_layers = false;
+
+	_FORCE_INLINE_ bool operator()(void *p_data) {
+		const gd::Polygon *polygon = static_cast<const gd::Polygon *>(p_data);
+		if (!use_layers || (navigation_layers & polygon->owner->get_navigation_layers()) != 0) {
+			polygons->push_back(polygon);
 		}
+		return false;
+	}
+};
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
+struct NavMapPolygonOrder {
+	_FORCE_INLINE_ bool operator()(const gd::Polygon *p_a, const gd::Polygon *p_b) const {
+		return p_a->map_index < p_b->map_index;
+	}
+};
+
+struct NavMap::BorderEdgeCollector {
+	LocalVector<BorderEdge *> *edges = nullptr;
+
+	_FORCE_INLINE_ bool operator()(void *p_data) {
+		edges->push_back(static_cast<BorderEdge *>(p_data));
+		return false;
+	}
+};
+
+static AABB _get_edge_aabb(const gd::Edge::Connection &p_edge) {
+	AABB edge_aabb(p_edge.polygon->points[p_edge.edge].pos, Vector3());
+	edge_aabb.expand_to(p_edge.polygon->points[(p_edge.edge + 1) % p_edge.polygon->points.size()].pos);
+	return edge_aabb;
+}
+
+void NavMap::_add_region_polygons(NavRegion *p_region, HashSet<RegionPolygons *> &r_affected_regions) {
+	RegionPolygons *region_data = memnew(RegionPolygons);
+	region_data->region = p_region;
+	region_polygons.insert(p_region, region_data);
+
+	// Copy all region polygons in the map.
+	const LocalVector<gd::Polygon> &polygons_source = p_region->get_polygons();
+	region_data->polygons.resize(polygons_source.size());
+	for (uint32_t n = 0; n < polygons_source.size(); n++) {
+		region_data->polygons[n] = polygons_source[n];
+	}
+
+	// Group all edges per key.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> connections;
+	for (gd::Polygon &poly : region_data->polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			LocalVector<gd::Edge::Connection> &edge_connections = connections[ek];
+			if (edge_connections.size() <= 1) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+				edge_connections.push_back(new_connection);
 			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
-				}
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 			}
 		}
+	}
+
+	uint32_t border_edge_count = 0;
+	for (KeyValue<gd::EdgeKey, LocalVector<gd::Edge::Connection>> &E : connections) {
+		if (E.value.size() == 2) {
+			// Connect edge that are shared in different polygons.
+			gd::Edge::Connection &c1 = E.value[0];
+			gd::Edge::Connection &c2 = E.value[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			region_data->edge_merge_count += 1;
+		} else {
+			border_edge_count += 1;
+		}
+	}
+
+	// The border edges are referenced by pointer from here on, the vector is never resized again.
+	region_data->border_edges.resize(border_edge_count);
+	uint32_t border_edge_index = 0;
+	for (const KeyValue<gd::EdgeKey, LocalVector<gd::Edge::Connection>> &E : connections) {
+		if (E.value.size() == 1) {
+			BorderEdge &border_edge = region_data->border_edges[border_edge_index++];
+			border_edge.connection = E.value[0];
+			border_edge.key = E.key;
+			border_edge.region = region_data;
+		}
+	}
+
+	region_data->polygon_ids.reserve(region_data->polygons.size());
+	bool region_aabb_empty = true;
+	for (gd::Polygon &poly : region_data->polygons) {
+		if (poly.points.is_empty()) {
+			continue;
+		}
+
+		AABB polygon_aabb(poly.points[0].pos, Vector3());
+		for (uint32_t i = 1; i < poly.points.size(); i++) {
+			polygon_aabb.expand_to(poly.points[i].pos);
+		}
+		region_data->polygon_size_sum += polygon_aabb.get_longest_axis_size();
+
+		// Flat polygons have no height, give the bounds some thickness so segments crossing them are found reliably.
+		polygon_aabb = polygon_aabb.grow(cell_height);
+		region_data->polygon_ids.push_back(polygons_bvh.insert(polygon_aabb, &poly));
+
+		if (region_aabb_empty) {
+			region_data->aabb = polygon_aabb;
+			region_aabb_empty = false;
+		} else {
+			region_data->aabb.merge_with(polygon_aabb);
+		}
+	}
+
+	for (BorderEdge &border_edge : region_data->border_edges) {
+		border_edge.id = border_edges_bvh.insert(_get_edge_aabb(border_edge.connection), &border_edge);
+		border_edge_keys[border_edge.key].push_back(&border_edge);
+	}
+
+	// The region connects to the regions next to it, which in turn have to connect to the new edges.
+	r_affected_regions.insert(region_data);
+	for (const BorderEdge &border_edge : region_data->border_edges) {
+		_collect_border_edge_neighbors(border_edge, r_affected_regions);
+	}
+}
+
+void NavMap::_remove_region_polygons(RegionPolygons *p_region_polygons, HashSet<RegionPolygons *> &r_affected_regions) {
+	for (const DynamicBVH::ID &polygon_id : p_region_polygons->polygon_ids) {
+		polygons_bvh.remove(polygon_id);
+	}
+
+	// The regions next to the removed one may have connections to its polygons.
+	for (const BorderEdge &border_edge : p_region_polygons->border_edges) {
+		_collect_border_edge_neighbors(border_edge, r_affected_regions);
+	}
+
+	for (BorderEdge &border_edge : p_region_polygons->border_edges) {
+		border_edges_bvh.remove(border_edge.id);
+
+		HashMap<gd::EdgeKey, LocalVector<BorderEdge *>, gd::EdgeKey>::Iterator key_edges = border_edge_keys.find(border_edge.key);
+		if (key_edges) {
+			key_edges->value.erase(&border_edge);
+			if (key_edges->value.is_empty()) {
+				border_edge_keys.remove(key_edges);
+			}
+		}
+	}
+
+	r_affected_regions.erase(p_region_polygons);
+	memdelete(p_region_polygons);
+}
+
+void NavMap::_collect_border_edge_neighbors(const BorderEdge &p_border_edge, HashSet<RegionPolygons *> &r_affected_regions) {
+	HashMap<gd::EdgeKey, LocalVector<BorderEdge *>, gd::EdgeKey>::ConstIterator key_edges = border_edge_keys.find(p_border_edge.key);
+	if (key_edges) {
+		for (const BorderEdge *other_edge : key_edges->value) {
+			r_affected_regions.insert(other_edge->region);
+		}
+	}
+
+	LocalVector<BorderEdge *> near_edges;
+	BorderEdgeCollector collector;
+	collector.edges = &near_edges;
+	border_edges_bvh.aabb_query(_get_edge_aabb(p_border_edge.connection).grow(edge_connection_margin), collector);
+	for (const BorderEdge *other_edge : near_edges) {
+		r_affected_regions.insert(other_edge->region);
+	}
+}
+
+void NavMap::_connect_region_border_edges(RegionPolygons *p_region_polygons) {
+	NavRegion *region = p_region_polygons->region;
+	Vector<gd::Edge::Connection> &region_connections = region->get_connections();
+	region_connections.clear();
+
+	for (const BorderEdge &border_edge : p_region_polygons->border_edges) {
+		const gd::Edge::Connection &edge = border_edge.connection;
+		edge.polygon->edges[edge.edge].connections.clear();
+	}
+
+	const bool region_use_edge_connections = use_edge_connections && region->get_use_edge_connections();
+	LocalVector<BorderEdge *> near_edges;
+	for (const BorderEdge &border_edge : p_region_polygons->border_edges) {
+		const gd::Edge::Connection &free_edge = border_edge.connection;
+		Vector<gd::Edge::Connection> &edge_connections = free_edge.polygon->edges[free_edge.edge].connections;
+
+		const LocalVector<BorderEdge *> &key_edges = border_edge_keys[border_edge.key];
+		if (key_edges.size() == 2) {
+			// Connect the edge shared with a polygon of another region.
+			const BorderEdge *other_edge = key_edges[0] == &border_edge ? key_edges[1] : key_edges[0];
+			edge_connections.push_back(other_edge->connection);
+			continue;
+		} else if (key_edges.size() > 2) {
+			ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			continue;
+		}
+
+		if (!region_use_edge_connections) {
+			continue;
+		}
 
 		// Find the compatible near edges.
 		//
@@ -1001,215 +1318,632 @@ void NavMap::sync() {
 		// to be connected, create new polygons to remove that small gap is
 		// not really useful and would result in wasteful computation during
 		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
+		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+		near_edges.clear();
+		BorderEdgeCollector collector;
+		collector.edges = &near_edges;
+		border_edges_bvh.aabb_query(_get_edge_aabb(free_edge).grow(edge_connection_margin), collector);
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
+		for (const BorderEdge *near_edge : near_edges) {
+			if (near_edge->region == p_region_polygons || !near_edge->region->region->get_use_edge_connections() || border_edge_keys[near_edge->key].size() != 1) {
+				continue;
+			}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+			const gd::Edge::Connection &other_edge = near_edge->connection;
+			Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+			Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
+			// Compute the projection of the opposite edge on the current one
+			Vector3 edge_vector = edge_p2 - edge_p1;
+			real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+			real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+			if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+				continue;
+			}
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
+			// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+			Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other1;
+			if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+				other1 = other_edge_p1;
+			} else {
+				other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other1.distance_to(self1) > edge_connection_margin) {
+				continue;
+			}
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
+			Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other2;
+			if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+				other2 = other_edge_p2;
+			} else {
+				other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other2.distance_to(self2) > edge_connection_margin) {
+				continue;
+			}
+
+			// The edges can now be connected.
+			gd::Edge::Connection new_connection = other_edge;
+			new_connection.pathway_start = (self1 + other1) / 2.0;
+			new_connection.pathway_end = (self2 + other2) / 2.0;
+			edge_connections.push_back(new_connection);
+
+			// Add the connection to the region_connection map.
+			region_connections.push_back(new_connection);
+		}
+	}
+
+	p_region_polygons->edge_connection_count = region_connections.size();
+}
+
+void NavMap::_clear_link_connections() {
+	for (gd::Polygon *polygon : link_connected_polygons) {
+		Vector<gd::Edge::Connection> &connections = polygon->edges[0].connections;
+		for (int i = connections.size() - 1; i >= 0; i--) {
+			if (connections[i].edge == -1) {
+				connections.remove_at(i);
+			}
+		}
+	}
+	link_connected_polygons.clear();
+	link_polygons.clear();
+}
+
+void NavMap::_update_link_connections() {
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
+
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		// Connect to the closest polygons within the search radius of the start and end points.
+		Vector3 closest_start_point;
+		gd::Polygon *closest_start_polygon = const_cast<gd::Polygon *>(_get_closest_polygon(start, false, 0, closest_start_point));
+		if (!closest_start_polygon || closest_start_point.distance_to(start) > link_connection_radius) {
+			continue;
+		}
+
+		Vector3 closest_end_point;
+		gd::Polygon *closest_end_polygon = const_cast<gd::Polygon *>(_get_closest_polygon(end, false, 0, closest_end_point));
+		if (!closest_end_polygon || closest_end_point.distance_to(end) > link_connection_radius) {
+			continue;
+		}
+
+		// We have both a start and end point, create a synthetic polygon to route through.
+		gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+		new_polygon.owner = link;
+
+		new_polygon.edges.clear();
+		new_polygon.edges.resize(4);
+		new_polygon.points.clear();
+		new_polygon.points.reserve(4);
+
+		// Build a set of vertices that create a thin polygon going from the start to the end point.
+		new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+		new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+		new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+		new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+		Vector3 center;
+		for (int p = 0; p < 4; ++p) {
+			center += new_polygon.points[p].pos;
+		}
+		new_polygon.center = center / real_t(new_polygon.points.size());
+		new_polygon.clockwise = true;
+
+		// Setup connections to go forward in the link.
+		{
+			gd::Edge::Connection entry_connection;
+			entry_connection.polygon = &new_polygon;
+			entry_connection.edge = -1;
+			entry_connection.pathway_start = new_polygon.points[0].pos;
+			entry_connection.pathway_end = new_polygon.points[1].pos;
+			closest_start_polygon->edges[0].connections.push_back(entry_connection);
+			link_connected_polygons.push_back(closest_start_polygon);
+
+			gd::Edge::Connection exit_connection;
+			exit_connection.polygon = closest_end_polygon;
+			exit_connection.edge = -1;
+			exit_connection.pathway_start = new_polygon.points[2].pos;
+			exit_connection.pathway_end = new_polygon.points[3].pos;
+			new_polygon.edges[2].connections.push_back(exit_connection);
+		}
+
+		// If the link is bi-directional, create connections from the end to the start.
+		if (link->is_bidirectional()) {
+			gd::Edge::Connection entry_connection;
+			entry_connection.polygon = &new_polygon;
+			entry_connection.edge = -1;
+			entry_connection.pathway_start = new_polygon.points[2].pos;
+			entry_connection.pathway_end = new_polygon.points[3].pos;
+			closest_end_polygon->edges[0].connections.push_back(entry_connection);
+			link_connected_polygons.push_back(closest_end_polygon);
+
+			gd::Edge::Connection exit_connection;
+			exit_connection.polygon = closest_start_polygon;
+			exit_connection.edge = -1;
+			exit_connection.pathway_start = new_polygon.points[0].pos;
+			exit_connection.pathway_end = new_polygon.points[1].pos;
+			new_polygon.edges[0].connections.push_back(exit_connection);
+		}
+	}
+
+	// Only keep the polygons of the connected links, shrinking does not move them.
+	link_polygons.resize(link_poly_idx);
+}
+
+void NavMap::_update_polygons_bounds() {
+	polygons_aabb = AABB();
+	polygons_search_radius = cell_size;
+
+	real_t polygon_size_sum = 0.0;
+	uint32_t polygon_count = 0;
+	bool polygons_aabb_empty = true;
+	uint32_t map_index = 0;
+	for (const NavRegion *region : regions) {
+		RegionPolygons **region_data_ptr = region_polygons.getptr(region);
+		if (!region_data_ptr) {
+			continue;
+		}
+
+		// Number the polygons like when iterating over the regions of the map, the region copies live at unrelated addresses.
+		RegionPolygons *region_data = *region_data_ptr;
+		for (gd::Polygon &poly : region_data->polygons) {
+			poly.map_index = map_index++;
+		}
+
+		if (region_data->polygon_ids.is_empty()) {
+			continue;
+		}
+
+		polygon_size_sum += region_data->polygon_size_sum;
+		polygon_count += region_data->polygon_ids.size();
+		if (polygons_aabb_empty) {
+			polygons_aabb = region_data->aabb;
+			polygons_aabb_empty = false;
+		} else {
+			polygons_aabb.merge_with(region_data->aabb);
+		}
+	}
+
+	// Start the closest polygon searches with bounds about the size of an average polygon.
+	if (polygon_count > 0) {
+		polygons_search_radius = MAX(cell_size, polygon_size_sum / polygon_count);
+	}
+}
+
+void NavMap::_query_polygons(const AABB &p_aabb, bool p_use_layers, uint32_t p_navigation_layers, LocalVector<const gd::Polygon *> &r_polygons) const {
+	r_polygons.clear();
+
+	NavMapPolygonCollector collector;
+	collector.polygons = &r_polygons;
+	collector.navigation_layers = p_navigation_layers;
+	collector.use_layers = p_use_layers;
+	polygons_bvh.aabb_query(p_aabb, collector);
+
+	// Keep the map polygon order, so ties are resolved like when iterating over all polygons.
+	r_polygons.sort_custom<NavMapPolygonOrder>();
+}
+
+void NavMap::_query_polygons(const Vector3 &p_from, const Vector3 &p_to, LocalVector<const gd::Polygon *> &r_polygons) const {
+	r_polygons.clear();
+
+	NavMapPolygonCollector collector;
+	collector.polygons = &r_polygons;
+	if (p_from.is_equal_approx(p_to)) {
+		polygons_bvh.aabb_query(AABB(p_from, Vector3()), collector);
+	} else {
+		polygons_bvh.ray_query(p_from, p_to, collector);
+	}
+
+	r_polygons.sort_custom<NavMapPolygonOrder>();
+}
+
+const gd::Polygon *NavMap::_get_closest_polygon(const Vector3 &p_point, bool p_use_layers, uint32_t p_navigation_layers, Vector3 &r_closest_point, Vector3 *r_closest_normal) const {
+	if (polygons_bvh.is_empty()) {
+		return nullptr;
+	}
+	// A non-finite point would keep growing the search radius without ever enclosing the map.
+	if (!p_point.is_finite()) {
+		return nullptr;
+	}
+
+	const gd::Polygon *closest_polygon = nullptr;
+	LocalVector<const gd::Polygon *> candidates;
+	real_t search_radius = polygons_search_radius;
+	while (true) {
+		closest_polygon = nullptr;
+		real_t closest_distance_squared = FLT_MAX;
+
+		const AABB search_aabb = AABB(p_point, Vector3()).grow(search_radius);
+		_query_polygons(search_aabb, p_use_layers, p_navigation_layers, candidates);
+
+		for (const gd::Polygon *p : candidates) {
+			// For each face check the distance to the point
+			for (size_t point_id = 2; point_id < p->points.size(); point_id += 1) {
+				const Face3 f(p->points[0].pos, p->points[point_id - 1].pos, p->points[point_id].pos);
+				const Vector3 point = f.get_closest_point_to(p_point);
+				const real_t distance_squared = point.distance_squared_to(p_point);
+				if (distance_squared < closest_distance_squared) {
+					closest_distance_squared = distance_squared;
+					closest_polygon = p;
+					r_closest_point = point;
+					if (r_closest_normal) {
+						*r_closest_normal = f.get_plane().normal;
+					}
 				}
+			}
+		}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+		// Any polygon closer than the one found has bounds overlapping a box of that distance around the point.
+		if ((closest_polygon && Math::sqrt(closest_distance_squared) <= search_radius) || search_aabb.encloses(polygons_aabb)) {
+			break;
+		}
+		search_radius = closest_polygon ? Math::sqrt(closest_distance_squared) : search_radius * 2.0;
+	}
+
+	return closest_polygon;
+}
 
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+static void _add_cluster_neighbors(LocalVector<gd::Cluster> &r_clusters, const gd::Polygon &p_polygon) {
+	gd::Cluster &cluster = r_clusters[p_polygon.cluster_id];
+	for (const gd::Edge &edge : p_polygon.edges) {
+		for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+			const uint32_t neighbor_id = edge.connections[connection_index].polygon->cluster_id;
+			if (neighbor_id != p_polygon.cluster_id && cluster.neighbors.find(neighbor_id) == -1) {
+				cluster.neighbors.push_back(neighbor_id);
 			}
 		}
+	}
+}
+
+void NavMap::_update_clusters() {
+	clusters.clear();
+	clusters_dirty = false;
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
+	for (KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		for (gd::Polygon &poly : E.value->polygons) {
+			poly.cluster_id = UINT32_MAX;
+		}
+	}
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
+	// Grow each cluster breadth-first through the edge connections of a single region,
+	// so that all polygons of a cluster are connected and share the same owner and costs.
+	LocalVector<gd::Polygon *> cluster_polygons;
+	for (KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		for (gd::Polygon &seed : E.value->polygons) {
+			if (seed.cluster_id != UINT32_MAX) {
 				continue;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
+
+			const uint32_t cluster_id = clusters.size();
+			seed.cluster_id = cluster_id;
+			cluster_polygons.clear();
+			cluster_polygons.push_back(&seed);
+
+			Vector3 center;
+			for (uint32_t i = 0; i < cluster_polygons.size(); i++) {
+				const gd::Polygon *poly = cluster_polygons[i];
+				center += poly->center;
+
+				for (const gd::Edge &edge : poly->edges) {
+					for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+						gd::Polygon *other = edge.connections[connection_index].polygon;
+						if (other->owner != seed.owner || other->cluster_id != UINT32_MAX || cluster_polygons.size() >= NAVMAP_CLUSTER_POLYGON_COUNT) {
+							continue;
+						}
+						other->cluster_id = cluster_id;
+						cluster_polygons.push_back(other);
 					}
 				}
 			}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			gd::Cluster cluster;
+			cluster.owner = seed.owner;
+			cluster.center = center / real_t(cluster_polygons.size());
+			clusters.push_back(cluster);
+		}
+	}
+
+	// Every link gets a cluster of its own.
+	for (uint32_t i = 0; i < link_polygons.size(); i++) {
+		gd::Polygon &link_polygon = link_polygons[i];
+		link_polygon.cluster_id = clusters.size();
+
+		gd::Cluster cluster;
+		cluster.owner = link_polygon.owner;
+		cluster.center = link_polygon.center;
+		clusters.push_back(cluster);
+	}
+
+	for (const KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		for (const gd::Polygon &poly : E.value->polygons) {
+			_add_cluster_neighbors(clusters, poly);
+		}
+	}
+	for (const gd::Polygon &link_polygon : link_polygons) {
+		_add_cluster_neighbors(clusters, link_polygon);
+	}
+}
+
+bool NavMap::_get_cluster_corridor(const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const {
+	{
+		// Only the map sync invalidates the clusters, and it never runs during a query.
+		MutexLock lock(clusters_mutex);
+		if (clusters_dirty) {
+			const_cast<NavMap *>(this)->_update_clusters();
+		}
+	}
+
+	const uint32_t begin_cluster = p_begin_poly->cluster_id;
+	const uint32_t end_cluster = p_end_poly->cluster_id;
+	if (begin_cluster >= clusters.size() || end_cluster >= clusters.size() || begin_cluster == end_cluster) {
+		return false;
+	}
+
+	struct ClusterNode {
+		real_t traveled_distance = FLT_MAX;
+		uint32_t previous = UINT32_MAX;
+		bool closed = false;
+	};
+
+	struct OpenCluster {
+		real_t cost = 0.0;
+		uint32_t id = 0;
+	};
+
+	struct SortOpenClusters {
+		_FORCE_INLINE_ bool operator()(const OpenCluster &A, const OpenCluster &B) const { // Returns true when A is worse than B.
+			return A.cost > B.cost;
+		}
+	};
+
+	LocalVector<ClusterNode> nodes;
+	nodes.resize(clusters.size());
+
+	LocalVector<OpenCluster> open_list;
+	SortArray<OpenCluster, SortOpenClusters> sorter;
+
+	// This is an implementation of the A* algorithm on the cluster graph.
+	const Vector3 &end_center = clusters[end_cluster].center;
+	nodes[begin_cluster].traveled_distance = 0.0;
+	open_list.push_back({ clusters[begin_cluster].center.distance_to(end_center), begin_cluster });
+
+	bool found_route = false;
+	while (!open_list.is_empty()) {
+		const uint32_t current_id = open_list[0].id;
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+
+		ClusterNode &current = nodes[current_id];
+		if (current.closed) {
+			continue;
+		}
+		current.closed = true;
+
+		if (current_id == end_cluster) {
+			found_route = true;
+			break;
+		}
+
+		const gd::Cluster &cluster = clusters[current_id];
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+		for (const uint32_t neighbor_id : cluster.neighbors) {
+			const gd::Cluster &neighbor = clusters[neighbor_id];
+			if ((p_navigation_layers & neighbor.owner->get_navigation_layers()) == 0) {
+				continue;
 			}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				Vector3 center;
-				for (int p = 0; p < 4; ++p) {
-					center += new_polygon.points[p].pos;
-				}
-				new_polygon.center = center / real_t(new_polygon.points.size());
-				new_polygon.clockwise = true;
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+			ClusterNode &node = nodes[neighbor_id];
+			if (node.closed) {
+				continue;
+			}
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
+			real_t traveled_distance = current.traveled_distance + cluster.center.distance_to(neighbor.center) * travel_cost;
+			if (neighbor.owner != cluster.owner) {
+				traveled_distance += neighbor.owner->get_enter_cost();
 			}
+			if (traveled_distance >= node.traveled_distance) {
+				continue;
+			}
+
+			node.traveled_distance = traveled_distance;
+			node.previous = current_id;
+
+			OpenCluster open_cluster = { traveled_distance + neighbor.center.distance_to(end_center), neighbor_id };
+			open_list.push_back(open_cluster);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_cluster, open_list.ptr());
 		}
+	}
 
-		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
-		iteration_id = iteration_id % UINT32_MAX + 1;
+	if (!found_route) {
+		return false;
 	}
 
-	// Do we have modified obstacle positions?
-	for (NavObstacle *obstacle : obstacles) {
-		if (obstacle->check_dirty()) {
-			obstacles_dirty = true;
+	// Mark the clusters along the abstract path, together with their direct neighbors
+	// so the refined search can still cut corners across cluster borders.
+	r_corridor.resize(clusters.size());
+	memset(r_corridor.ptr(), 0, r_corridor.size());
+	for (uint32_t id = end_cluster; id != UINT32_MAX; id = nodes[id].previous) {
+		r_corridor[id] = 1;
+		for (const uint32_t neighbor_id : clusters[id].neighbors) {
+			r_corridor[neighbor_id] = 1;
 		}
 	}
-	// Do we have modified agent arrays?
-	for (NavAgent *agent : agents) {
-		if (agent->check_dirty()) {
-			agents_dirty = true;
+
+	return true;
+}
+
+void NavMap::_update_flow_field_graph() {
+	flow_fields_dirty = false;
+
+	// The cached flow fields are indexed by the ids of the previous polygons.
+	for (gd::FlowField *flow_field : flow_fields) {
+		memdelete(flow_field);
+	}
+	flow_fields.clear();
+
+	flow_field_polygons.clear();
+	for (KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		for (gd::Polygon &poly : E.value->polygons) {
+			poly.flow_field_id = flow_field_polygons.size();
+			flow_field_polygons.push_back(&poly);
 		}
 	}
+	for (gd::Polygon &link_polygon : link_polygons) {
+		link_polygon.flow_field_id = flow_field_polygons.size();
+		flow_field_polygons.push_back(&link_polygon);
+	}
 
-	// Update avoidance worlds.
-	if (obstacles_dirty || agents_dirty) {
-		_update_rvo_simulation();
+	// Group the connections by the polygon they enter, flow fields are searched backwards from the destination.
+	flow_field_connection_offsets.resize(flow_field_polygons.size() + 1);
+	memset(flow_field_connection_offsets.ptr(), 0, flow_field_connection_offsets.size() * sizeof(uint32_t));
+	for (const gd::Polygon *poly : flow_field_polygons) {
+		for (const gd::Edge &edge : poly->edges) {
+			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+				flow_field_connection_offsets[edge.connections[connection_index].polygon->flow_field_id + 1]++;
+			}
+		}
+	}
+	for (uint32_t i = 1; i < flow_field_connection_offsets.size(); i++) {
+		flow_field_connection_offsets[i] += flow_field_connection_offsets[i - 1];
 	}
 
-	regenerate_polygons = false;
-	regenerate_links = false;
-	obstacles_dirty = false;
-	agents_dirty = false;
+	LocalVector<uint32_t> connection_counts;
+	connection_counts.resize(flow_field_polygons.size());
+	memset(connection_counts.ptr(), 0, connection_counts.size() * sizeof(uint32_t));
 
-	// Performance Monitor.
-	pm_region_count = _new_pm_region_count;
-	pm_agent_count = _new_pm_agent_count;
-	pm_link_count = _new_pm_link_count;
-	pm_polygon_count = _new_pm_polygon_count;
-	pm_edge_count = _new_pm_edge_count;
-	pm_edge_merge_count = _new_pm_edge_merge_count;
-	pm_edge_connection_count = _new_pm_edge_connection_count;
-	pm_edge_free_count = _new_pm_edge_free_count;
+	flow_field_connections.resize(flow_field_connection_offsets[flow_field_polygons.size()]);
+	for (uint32_t polygon_id = 0; polygon_id < flow_field_polygons.size(); polygon_id++) {
+		for (const gd::Edge &edge : flow_field_polygons[polygon_id]->edges) {
+			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+				const gd::Edge::Connection &connection = edge.connections[connection_index];
+				const uint32_t entered_id = connection.polygon->flow_field_id;
+
+				FlowFieldConnection &flow_field_connection = flow_field_connections[flow_field_connection_offsets[entered_id] + connection_counts[entered_id]++];
+				flow_field_connection.polygon_id = polygon_id;
+				flow_field_connection.connection = &connection;
+			}
+		}
+	}
+}
+
+const gd::FlowField *NavMap::_get_flow_field(const Vector3 &p_destination, uint32_t p_navigation_layers) {
+	if (flow_fields_dirty) {
+		_update_flow_field_graph();
+	}
+
+	for (uint32_t i = 0; i < flow_fields.size(); i++) {
+		gd::FlowField *flow_field = flow_fields[i];
+		if (flow_field->destination == p_destination && flow_field->navigation_layers == p_navigation_layers) {
+			// Keep the cache ordered by use, the least recently used flow field is replaced first.
+			flow_fields.remove_at(i);
+			flow_fields.push_back(flow_field);
+			return flow_field;
+		}
+	}
+
+	Vector3 end_point;
+	const gd::Polygon *end_poly = _get_closest_polygon(p_destination, true, p_navigation_layers, end_point);
+	if (!end_poly) {
+		return nullptr;
+	}
+
+	gd::FlowField *flow_field = nullptr;
+	if (flow_fields.size() >= NAVMAP_FLOW_FIELD_CACHE_SIZE) {
+		flow_field = flow_fields[0];
+		flow_fields.remove_at(0);
+	} else {
+		flow_field = memnew(gd::FlowField);
+	}
+
+	flow_field->destination = p_destination;
+	flow_field->navigation_layers = p_navigation_layers;
+	_compute_flow_field(*flow_field, end_poly, end_point);
+	flow_fields.push_back(flow_field);
+
+	return flow_field;
+}
+
+void NavMap::_compute_flow_field(gd::FlowField &r_flow_field, const gd::Polygon *p_end_poly, const Vector3 &p_end_point) const {
+	struct OpenPolygon {
+		real_t cost = 0.0;
+		uint32_t id = 0;
+	};
+
+	struct SortOpenPolygons {
+		_FORCE_INLINE_ bool operator()(const OpenPolygon &A, const OpenPolygon &B) const { // Returns true when A is worse than B.
+			return A.cost > B.cost;
+		}
+	};
+
+	LocalVector<gd::FlowFieldCell> &cells = r_flow_field.cells;
+	cells.clear();
+	cells.resize(flow_field_polygons.size());
+
+	LocalVector<OpenPolygon> open_list;
+	SortArray<OpenPolygon, SortOpenPolygons> sorter;
+
+	const uint32_t end_id = p_end_poly->flow_field_id;
+	cells[end_id].traveled_distance = 0.0;
+	cells[end_id].exit = p_end_point;
+	open_list.push_back({ 0.0, end_id });
+
+	// This is an implementation of Dijkstra's algorithm, following the connections backwards from the destination.
+	while (!open_list.is_empty()) {
+		const OpenPolygon current = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+
+		const gd::FlowFieldCell &current_cell = cells[current.id];
+		if (current.cost > current_cell.traveled_distance) {
+			// A shorter way to this polygon was found after it was added.
+			continue;
+		}
+
+		const gd::Polygon *current_poly = flow_field_polygons[current.id];
+		const real_t travel_cost = current_poly->owner->get_travel_cost();
+
+		for (uint32_t i = flow_field_connection_offsets[current.id]; i < flow_field_connection_offsets[current.id + 1]; i++) {
+			const FlowFieldConnection &flow_field_connection = flow_field_connections[i];
+			const gd::Polygon *poly = flow_field_polygons[flow_field_connection.polygon_id];
+
+			// Only consider the polygons in regions with compatible layers.
+			if ((r_flow_field.navigation_layers & poly->owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			Vector3 pathway[2] = { flow_field_connection.connection->pathway_start, flow_field_connection.connection->pathway_end };
+			const Vector3 exit = Geometry3D::get_closest_point_to_segment(current_cell.exit, pathway);
+
+			real_t traveled_distance = current_cell.traveled_distance + exit.distance_to(current_cell.exit) * travel_cost;
+			if (poly->owner != current_poly->owner) {
+				traveled_distance += current_poly->owner->get_enter_cost();
+			}
+
+			gd::FlowFieldCell &cell = cells[flow_field_connection.polygon_id];
+			if (traveled_distance >= cell.traveled_distance) {
+				continue;
+			}
+
+			cell.traveled_distance = traveled_distance;
+			cell.exit = exit;
+			cell.next_id = current.id;
+
+			OpenPolygon open_polygon = { traveled_distance, flow_field_connection.polygon_id };
+			open_list.push_back(open_polygon);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_polygon, open_list.ptr());
+		}
+	}
 }
 
 void NavMap::_update_rvo_obstacles_tree_2d() {
@@ -1316,7 +2050,9 @@ void NavMap::_update_rvo_simulation() {
 	}
 	if (agents_dirty) {
 		_update_rvo_agents_tree_2d();
-		_update_rvo_agents_tree_3d();
+		if (!use_grid_avoidance_3d) {
+			_update_rvo_agents_tree_3d();
+		}
 	}
 }
 
@@ -1355,7 +2091,9 @@ void NavMap::step(real_t p_deltatime) {
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
+		if (use_grid_avoidance_3d) {
+			avoidance_grid_3d.step(active_3d_avoidance_agents, deltatime, use_threads && avoidance_use_multiple_threads, avoidance_use_high_priority_threads);
+		} else if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
@@ -1420,7 +2158,14 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	use_grid_avoidance_3d = GLOBAL_GET("navigation/avoidance/3d/use_grid_avoidance");
 }
 
 NavMap::~NavMap() {
+	for (KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		memdelete(E.value);
+	}
+	for (gd::FlowField *flow_field : flow_fields) {
+		memdelete(flow_field);
+	}
 }
@@ -31,11 +31,15 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_avoidance_grid_3d.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
+#include "core/math/dynamic_bvh.h"
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
 
 #include <KdTree2d.h>
 #include <KdTree3d.h>
@@ -49,6 +53,9 @@ class NavObstacle;
 
 class NavMap : public NavRid {
 	RWLock map_rwlock;
+	// Held by sync() from before it asks for the write lock until it is done. Batched queries pass
+	// through it before taking the read lock, so a steady stream of them can not starve the sync.
+	mutable Mutex sync_turnstile;
 
 	/// Map Up
 	Vector3 up = Vector3(0, 1, 0);
@@ -73,21 +80,83 @@ class NavMap : public NavRid {
 
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
+	bool regions_dirty = true;
+	bool links_dirty = true;
+
+	struct RegionPolygons;
+
+	/// Region polygon edge that is not merged with another edge of the same region,
+	/// so it can be merged or connected with the edges of other regions.
+	struct BorderEdge {
+		gd::Edge::Connection connection;
+		gd::EdgeKey key;
+		RegionPolygons *region = nullptr;
+		DynamicBVH::ID id;
+	};
+
+	/// Map copy of the polygons of an enabled region, with the edges shared inside the region already merged.
+	/// Only the regions that changed are rebuilt, the polygons of the other regions keep their connections.
+	struct RegionPolygons {
+		NavRegion *region = nullptr;
+		LocalVector<gd::Polygon> polygons;
+		LocalVector<DynamicBVH::ID> polygon_ids;
+		LocalVector<BorderEdge> border_edges;
+		AABB aabb;
+		real_t polygon_size_sum = 0.0;
+		int edge_merge_count = 0;
+		int edge_connection_count = 0;
+	};
+
+	struct BorderEdgeCollector;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
+	HashMap<const NavRegion *, RegionPolygons *> region_polygons;
+
+	/// Region border edges, grouped by key to merge them and in a tree to find the near edges to connect.
+	HashMap<gd::EdgeKey, LocalVector<BorderEdge *>, gd::EdgeKey> border_edge_keys;
+	DynamicBVH border_edges_bvh;
 
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
-
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	LocalVector<gd::Polygon *> link_connected_polygons;
+
+	/// Bounding volume hierarchy over the map polygons, used to find the polygons close to a point or segment.
+	/// Queries do not modify the tree, `DynamicBVH` just does not declare them const.
+	mutable DynamicBVH polygons_bvh;
+	AABB polygons_aabb;
+	real_t polygons_search_radius = 0.0;
+
+	/// Abstract graph of polygon clusters used by hierarchical path queries.
+	/// It is only built by the first hierarchical query after the map changed.
+	LocalVector<gd::Cluster> clusters;
+	bool clusters_dirty = true;
+	mutable Mutex clusters_mutex;
+
+	/// Map connection entering a polygon, stored with the polygon it comes from.
+	struct FlowFieldConnection {
+		uint32_t polygon_id = 0;
+		const gd::Edge::Connection *connection = nullptr;
+	};
+
+	/// Flow fields of the most recently queried destinations, shared by all queries towards them.
+	/// The graph of connections entering each polygon is only built by the first flow field query after the map changed.
+	LocalVector<gd::Polygon *> flow_field_polygons;
+	LocalVector<uint32_t> flow_field_connection_offsets;
+	LocalVector<FlowFieldConnection> flow_field_connections;
+	LocalVector<gd::FlowField *> flow_fields;
+	bool flow_fields_dirty = true;
+	mutable Mutex flow_fields_mutex;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
 
+	/// Grid based avoidance used instead of rvo_simulation_3d when enabled
+	NavAvoidanceGrid3D avoidance_grid_3d;
+	bool use_grid_avoidance_3d = false;
+
 	/// avoidance controlled agents
 	LocalVector<NavAgent *> active_2d_avoidance_agents;
 	LocalVector<NavAgent *> active_3d_avoidance_agents;
@@ -130,6 +199,9 @@ public:
 
 	uint32_t get_iteration_id() const { return iteration_id; }
 
+	// Blocks while a sync is waiting for or holding the map, for queries that must not delay it.
+	void wait_for_sync() const { MutexLock lock(sync_turnstile); }
+
 	void set_up(Vector3 p_up);
 	Vector3 get_up() const {
 		return up;
@@ -165,7 +237,8 @@ public:
 
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
-	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_hierarchical = false) const;
+	Vector3 get_flow_field_direction(const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -223,6 +296,24 @@ private:
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
 
+	void _add_region_polygons(NavRegion *p_region, HashSet<RegionPolygons *> &r_affected_regions);
+	void _remove_region_polygons(RegionPolygons *p_region_polygons, HashSet<RegionPolygons *> &r_affected_regions);
+	void _collect_border_edge_neighbors(const BorderEdge &p_border_edge, HashSet<RegionPolygons *> &r_affected_regions);
+	void _connect_region_border_edges(RegionPolygons *p_region_polygons);
+	void _clear_link_connections();
+	void _update_link_connections();
+	void _update_polygons_bounds();
+	void _query_polygons(const AABB &p_aabb, bool p_use_layers, uint32_t p_navigation_layers, LocalVector<const gd::Polygon *> &r_polygons) const;
+	void _query_polygons(const Vector3 &p_from, const Vector3 &p_to, LocalVector<const gd::Polygon *> &r_polygons) const;
+	const gd::Polygon *_get_closest_polygon(const Vector3 &p_point, bool p_use_layers, uint32_t p_navigation_layers, Vector3 &r_closest_point, Vector3 *r_closest_normal = nullptr) const;
+
+	void _update_clusters();
+	bool _get_cluster_corridor(const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const;
+
+	void _update_flow_field_graph();
+	const gd::FlowField *_get_flow_field(const Vector3 &p_destination, uint32_t p_navigation_layers);
+	void _compute_flow_field(gd::FlowField &r_flow_field, const gd::Polygon *p_end_poly, const Vector3 &p_end_point) const;
+
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
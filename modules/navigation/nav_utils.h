@@ -114,6 +114,45 @@ struct Polygon {
 	Vector3 center;
 
 	real_t surface_area = 0.0;
+
+	/// The cluster of the map hierarchy that contains this `Polygon`.
+	uint32_t cluster_id = UINT32_MAX;
+
+	/// Index of this `Polygon` in the flow fields of the map.
+	uint32_t flow_field_id = UINT32_MAX;
+
+	/// Position of this `Polygon` in the map, in region order, to break ties between polygons found by spatial queries.
+	uint32_t map_index = UINT32_MAX;
+};
+
+struct Cluster {
+	/// Navigation region or link that owns all polygons of this cluster.
+	const NavBase *owner = nullptr;
+
+	/// The average center of the polygons in this cluster.
+	Vector3 center;
+
+	/// Clusters that can be entered through a connection leaving this cluster.
+	LocalVector<uint32_t> neighbors;
+};
+
+struct FlowFieldCell {
+	/// The cost to reach the destination from this polygon.
+	real_t traveled_distance = FLT_MAX;
+
+	/// The point where this polygon is left on the way to the destination, or the destination itself.
+	Vector3 exit;
+
+	/// Flow field index of the polygon entered next, or `UINT32_MAX` in the destination polygon.
+	uint32_t next_id = UINT32_MAX;
+};
+
+struct FlowField {
+	Vector3 destination;
+	uint32_t navigation_layers = 0;
+
+	/// The next hop of every map polygon, indexed by `Polygon::flow_field_id`.
+	LocalVector<FlowFieldCell> cells;
 };
 
 struct NavigationPoly {
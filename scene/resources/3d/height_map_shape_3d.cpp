@@ -286,6 +286,31 @@ void HeightMapShape3D::update_map_data_from_image(const Ref<Image> &p_image, rea
 	emit_changed();
 }
 
+void HeightMapShape3D::update_map_data_region(const Rect2i &p_region, const Vector<real_t> &p_data) {
+	ERR_FAIL_COND_MSG(!Rect2i(0, 0, map_width, map_depth).encloses(p_region), "Heightmap region update requires a region inside the heightmap.");
+	ERR_FAIL_COND_MSG(p_data.size() != p_region.size.x * p_region.size.y, "Heightmap region update requires one height value per point of the region.");
+
+	real_t *w = map_data.ptrw();
+	const real_t *r = p_data.ptr();
+	for (int z = 0; z < p_region.size.y; z++) {
+		for (int x = 0; x < p_region.size.x; x++) {
+			real_t val = r[z * p_region.size.x + x];
+			w[(p_region.position.y + z) * map_width + p_region.position.x + x] = val;
+			min_height = MIN(min_height, val);
+			max_height = MAX(max_height, val);
+		}
+	}
+
+	// Only send the region, so the physics server doesn't rebuild the whole shape.
+	Dictionary d;
+	d["width"] = map_width;
+	d["depth"] = map_depth;
+	d["region"] = p_region;
+	d["heights"] = p_data;
+	PhysicsServer3D::get_singleton()->shape_set_data(get_shape(), d);
+	Shape3D::_update_shape();
+}
+
 void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_map_width", "width"), &HeightMapShape3D::set_map_width);
 	ClassDB::bind_method(D_METHOD("get_map_width"), &HeightMapShape3D::get_map_width);
@@ -297,6 +322,7 @@ void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_max_height"), &HeightMapShape3D::get_max_height);
 
 	ClassDB::bind_method(D_METHOD("update_map_data_from_image", "image", "height_min", "height_max"), &HeightMapShape3D::update_map_data_from_image);
+	ClassDB::bind_method(D_METHOD("update_map_data_region", "region", "data"), &HeightMapShape3D::update_map_data_region);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_width", PROPERTY_HINT_RANGE, "0.001,100,0.001,or_greater"), "set_map_width", "get_map_width");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_depth", PROPERTY_HINT_RANGE, "0.001,100,0.001,or_greater"), "set_map_depth", "get_map_depth");
@@ -105,6 +105,9 @@ public:
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
+	/// Returns the direction to move in from the origin to reach the destination, sampled from a flow field shared by all queries to the destination.
+	virtual Vector3 map_get_flow_field_direction(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers = 1) const = 0;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
@@ -344,9 +347,14 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Runs many path queries on worker threads, the results are written back during `sync`.
+	virtual uint32_t query_path_batch_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) = 0;
+	virtual bool is_path_query_batch_pending(uint32_t p_batch_id) const = 0;
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
+	virtual Dictionary bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, real_t p_tile_size, const AABB &p_changed_aabb = AABB()) = 0;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const = 0;
 
 	NavigationServer3D();
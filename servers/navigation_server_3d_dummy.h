@@ -56,6 +56,7 @@ public:
 	void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) override {}
 	real_t map_get_link_connection_radius(RID p_map) const override { return 0; }
 	Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const override { return Vector<Vector3>(); }
+	Vector3 map_get_flow_field_direction(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers) const override { return Vector3(); }
 	Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const override { return Vector3(); }
 	Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const override { return Vector3(); }
 	Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const override { return Vector3(); }
@@ -178,6 +179,7 @@ public:
 	void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override {}
 	void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override {}
 	void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override {}
+	Dictionary bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, real_t p_tile_size, const AABB &p_changed_aabb = AABB()) override { return Dictionary(); }
 	bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const override { return false; }
 
 	void free(RID p_object) override {}
@@ -188,6 +190,8 @@ public:
 	void finish() override {}
 
 	NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override { return NavigationUtilities::PathQueryResult(); }
+	uint32_t query_path_batch_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override { return 0; }
+	bool is_path_query_batch_pending(uint32_t p_batch_id) const override { return false; }
 	int get_process_info(ProcessInfo p_info) const override { return 0; }
 
 	void set_debug_enabled(bool p_enabled) {}
@@ -285,6 +285,11 @@ void GodotBody2D::set_mode(PhysicsServer2D::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	if (get_space() && prev != mode) {
+		// Static bodies don't connect islands, and only rigid bodies are tested for sleeping.
+		get_space()->invalidate_islands();
+	}
 }
 
 PhysicsServer2D::BodyMode GodotBody2D::get_mode() const {
@@ -391,6 +396,7 @@ Variant GodotBody2D::get_state(PhysicsServer2D::BodyState p_state) const {
 void GodotBody2D::set_space(GodotSpace2D *p_space) {
 	if (get_space()) {
 		wakeup_neighbours();
+		get_space()->invalidate_islands();
 
 		if (mass_properties_update_list.in_list()) {
 			get_space()->body_remove_from_mass_properties_update_list(&mass_properties_update_list);
@@ -407,6 +413,7 @@ void GodotBody2D::set_space(GodotSpace2D *p_space) {
 
 	if (get_space()) {
 		_mass_properties_changed();
+		get_space()->invalidate_islands();
 
 		if (active && !active_list.in_list()) {
 			get_space()->body_add_to_active_list(&active_list);
@@ -414,6 +421,20 @@ void GodotBody2D::set_space(GodotSpace2D *p_space) {
 	}
 }
 
+void GodotBody2D::add_constraint(GodotConstraint2D *p_constraint, int p_pos) {
+	constraint_list.push_back({ p_constraint, p_pos });
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotBody2D::remove_constraint(GodotConstraint2D *p_constraint, int p_pos) {
+	constraint_list.erase({ p_constraint, p_pos });
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
 void GodotBody2D::_update_transform_dependent() {
 	center_of_mass = get_transform().basis_xform(center_of_mass_local);
 }
@@ -114,60 +114,70 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
+_FORCE_INLINE_ static bool _can_ray_query(GodotCollisionObject2D *p_object, const PhysicsDirectSpaceState2D::RayParameters &p_parameters) {
+	if (!_can_collide_with(p_object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		return false;
+	}
+
+	if (p_parameters.exclude.has(p_object->get_self())) {
+		return false;
+	}
+
+	return true;
+}
 
-	Vector2 begin, end;
-	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
+// Orders the shapes a ray hits at the same distance, so the result doesn't depend on the order they were culled in.
+static _FORCE_INLINE_ bool _is_ray_tie_preferred(const GodotCollisionObject2D *p_object, int p_shape, const GodotCollisionObject2D *p_other_object, int p_other_shape) {
+	if (p_object->get_self() != p_other_object->get_self()) {
+		return p_object->get_self() < p_other_object->get_self();
+	}
+	return p_shape < p_other_shape;
+}
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+// Finds the closest hit along the segment among shapes that already passed the ray query filters.
+static bool _intersect_ray_shapes(const Vector2 &p_begin, const Vector2 &p_end, bool p_hit_from_inside, GodotCollisionObject2D *const *p_objects, const int *p_shapes, int p_amount, PhysicsDirectSpaceState2D::RayResult &r_result) {
+	Vector2 normal = (p_end - p_begin).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
+	bool inside = false;
 	Vector2 res_point, res_normal;
 	int res_shape = -1;
 	const GodotCollisionObject2D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
-
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue;
-		}
-
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject2D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_shapes[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
-		Vector2 local_from = inv_xform.xform(begin);
-		Vector2 local_to = inv_xform.xform(end);
+		Vector2 local_from = inv_xform.xform(p_begin);
+		Vector2 local_to = inv_xform.xform(p_end);
 
 		const GodotShape2D *shape = col_obj->get_shape(shape_idx);
 
 		Vector2 shape_point, shape_normal;
 
 		if (shape->contains_point(local_from)) {
-			if (p_parameters.hit_from_inside) {
+			if (p_hit_from_inside && (!inside || _is_ray_tie_preferred(col_obj, shape_idx, res_obj, res_shape))) {
 				// Hit shape at starting point.
 				min_d = 0;
-				res_point = begin;
+				res_point = p_begin;
 				res_normal = Vector2();
 				res_shape = shape_idx;
 				res_obj = col_obj;
 				collided = true;
-				break;
-			} else {
-				// Ignore shape when starting inside.
-				continue;
+				inside = true;
 			}
+			// Otherwise, ignore shape when starting inside.
+			continue;
+		}
+
+		if (inside) {
+			// Already hit a shape at the starting point, only other shapes containing it matter.
+			continue;
 		}
 
 		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
@@ -176,7 +186,7 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 
 			real_t ld = normal.dot(shape_point);
 
-			if (ld < min_d) {
+			if (ld < min_d || (ld == min_d && collided && _is_ray_tie_preferred(col_obj, shape_idx, res_obj, res_shape))) {
 				min_d = ld;
 				res_point = shape_point;
 				res_normal = inv_xform.basis_xform_inv(shape_normal).normalized();
@@ -204,6 +214,118 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::_cast_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result) {
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	// Compact the candidates in place, keeping only those that pass the query filters.
+	int candidates = 0;
+	for (int i = 0; i < amount; i++) {
+		if (!_can_ray_query(space->intersection_query_results[i], p_parameters)) {
+			continue;
+		}
+		space->intersection_query_results[candidates] = space->intersection_query_results[i];
+		space->intersection_query_subindex_results[candidates] = space->intersection_query_subindex_results[i];
+		candidates++;
+	}
+
+	return _intersect_ray_shapes(p_from, p_to, p_parameters.hit_from_inside, space->intersection_query_results, space->intersection_query_subindex_results, candidates, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	return _cast_ray(p_parameters, p_parameters.from, p_parameters.to, r_result);
+}
+
+int GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_ray_count <= 0) {
+		return 0;
+	}
+	ERR_FAIL_NULL_V(p_from, 0);
+	ERR_FAIL_NULL_V(p_to, 0);
+	ERR_FAIL_NULL_V(r_results, 0);
+	ERR_FAIL_NULL_V(r_hits, 0);
+
+	// Per-ray candidate lists, filled from the packet candidates that overlap each segment.
+	GodotCollisionObject2D **ray_objects = (GodotCollisionObject2D **)alloca(sizeof(GodotCollisionObject2D *) * GodotSpace2D::INTERSECTION_QUERY_MAX);
+	int *ray_shapes = (int *)alloca(sizeof(int) * GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	int hit_count = 0;
+
+	for (int packet_begin = 0; packet_begin < p_ray_count; packet_begin += RAY_PACKET_SIZE) {
+		int packet_end = MIN(packet_begin + RAY_PACKET_SIZE, p_ray_count);
+
+		Rect2 ray_rects[RAY_PACKET_SIZE];
+		Rect2 packet_rect(p_from[packet_begin], Vector2());
+		real_t ray_size_max = 0.0;
+		for (int i = packet_begin; i < packet_end; i++) {
+			Rect2 &ray_rect = ray_rects[i - packet_begin];
+			ray_rect = Rect2(p_from[i], Vector2());
+			ray_rect.expand_to(p_to[i]);
+			packet_rect = packet_rect.merge(ray_rect);
+			ray_size_max = MAX(ray_size_max, MAX(ray_rect.size.x, ray_rect.size.y));
+		}
+
+		// Compare the areas with some margin, so rays along an axis still have one.
+		const real_t margin = ray_size_max * 0.25;
+		real_t rays_area = 0.0;
+		for (int i = 0; i < packet_end - packet_begin; i++) {
+			rays_area += ray_rects[i].grow(margin).get_area();
+		}
+		const bool scattered = packet_rect.grow(margin).get_area() > RAY_PACKET_MAX_SPREAD * rays_area;
+
+		int amount = 0;
+		if (!scattered) {
+			amount = space->broadphase->cull_aabb(packet_rect, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		}
+
+		if (scattered || amount >= GodotSpace2D::INTERSECTION_QUERY_MAX) {
+			// The packet bounds are mostly empty space between the rays, or too crowded to be culled at once,
+			// query each ray separately so no candidate is dropped or tested against rays far from it.
+			for (int i = packet_begin; i < packet_end; i++) {
+				r_hits[i] = _cast_ray(p_parameters, p_from[i], p_to[i], r_results[i]);
+				if (r_hits[i]) {
+					hit_count++;
+				}
+			}
+			continue;
+		}
+
+		int candidates = 0;
+		for (int i = 0; i < amount; i++) {
+			if (!_can_ray_query(space->intersection_query_results[i], p_parameters)) {
+				continue;
+			}
+			space->intersection_query_results[candidates] = space->intersection_query_results[i];
+			space->intersection_query_subindex_results[candidates] = space->intersection_query_subindex_results[i];
+			candidates++;
+		}
+
+		for (int i = packet_begin; i < packet_end; i++) {
+			// Same rejection the broadphase does for a single segment, against the cached shape bounds.
+			int ray_amount = 0;
+			for (int j = 0; j < candidates; j++) {
+				GodotCollisionObject2D *col_obj = space->intersection_query_results[j];
+				int shape_idx = space->intersection_query_subindex_results[j];
+				if (!col_obj->get_shape_aabb(shape_idx).intersects_segment(p_from[i], p_to[i])) {
+					continue;
+				}
+				ray_objects[ray_amount] = col_obj;
+				ray_shapes[ray_amount] = shape_idx;
+				ray_amount++;
+			}
+
+			r_hits[i] = _intersect_ray_shapes(p_from[i], p_to[i], p_parameters.hit_from_inside, ray_objects, ray_shapes, ray_amount, r_results[i]);
+			if (r_hits[i]) {
+				hit_count++;
+			}
+		}
+	}
+
+	return hit_count;
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1056,10 +1178,12 @@ const SelfList<GodotBody2D>::List &GodotSpace2D::get_active_body_list() const {
 
 void GodotSpace2D::body_add_to_active_list(SelfList<GodotBody2D> *p_body) {
 	active_list.add(p_body);
+	invalidate_islands();
 }
 
 void GodotSpace2D::body_remove_from_active_list(SelfList<GodotBody2D> *p_body) {
 	active_list.remove(p_body);
+	invalidate_islands();
 }
 
 void GodotSpace2D::body_add_to_mass_properties_update_list(SelfList<GodotBody2D> *p_body) {
@@ -1216,6 +1340,8 @@ GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 }
 
 GodotSpace2D::GodotSpace2D() {
+	invalidate_islands();
+
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/2d/time_before_sleep");
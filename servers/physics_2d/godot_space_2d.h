@@ -40,16 +40,25 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	// Rays batched by intersect_rays() share one broadphase cull per packet of this size.
+	static constexpr int RAY_PACKET_SIZE = 16;
+	// Packets whose bounds are this many times larger than the bounds of their rays are queried one ray at a time.
+	static constexpr real_t RAY_PACKET_MAX_SPREAD = 4.0;
+
+	bool _cast_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result);
+
 public:
 	GodotSpace2D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
@@ -70,6 +79,16 @@ public:
 
 	};
 
+	// Islands generated by the last step of this space, reused while the island version doesn't change.
+	// Body islands are used as is, constraint islands are copied since pre-solving compacts them.
+	struct IslandCache {
+		uint64_t version = 0;
+		uint32_t body_island_count = 0;
+		uint32_t constraint_island_count = 0;
+		LocalVector<LocalVector<GodotBody2D *>> body_islands;
+		LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
+	};
+
 private:
 	struct ExcludedShapeSW {
 		GodotShape2D *local_shape = nullptr;
@@ -121,6 +140,10 @@ private:
 
 	int island_count = 0;
 	int active_objects = 0;
+
+	// Changes whenever the active bodies or the constraints between bodies change.
+	uint64_t island_version = 0;
+	IslandCache island_cache;
 	int collision_pairs = 0;
 
 	int _cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb);
@@ -137,6 +160,10 @@ public:
 	void set_default_area(GodotArea2D *p_area) { area = p_area; }
 	GodotArea2D *get_default_area() const { return area; }
 
+	_FORCE_INLINE_ void invalidate_islands() { island_version++; }
+	_FORCE_INLINE_ uint64_t get_island_version() const { return island_version; }
+	_FORCE_INLINE_ IslandCache &get_island_cache() { return island_cache; }
+
 	const SelfList<GodotBody2D>::List &get_active_body_list() const;
 	void body_add_to_active_list(SelfList<GodotBody2D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody2D> *p_body);
@@ -33,7 +33,6 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
-#define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
@@ -162,71 +161,106 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
 	uint32_t island_count = 0;
+	uint32_t body_island_count = 0;
 
-	const SelfList<GodotArea2D>::List &aml = p_space->get_moved_area_list();
+	GodotSpace2D::IslandCache &island_cache = p_space->get_island_cache();
+	LocalVector<LocalVector<GodotBody2D *>> &body_islands = island_cache.body_islands;
 
-	while (aml.first()) {
-		for (GodotConstraint2D *E : aml.first()->self()->get_constraints()) {
-			GodotConstraint2D *constraint = E;
-			if (constraint->get_island_step() == _step) {
-				continue;
-			}
-			constraint->set_island_step(_step);
+	if (island_cache.version == p_space->get_island_version()) {
+		// No body was activated, deactivated or connected since the islands were generated, reuse them.
+		body_island_count = island_cache.body_island_count;
+
+		for (uint32_t cached_index = 0; cached_index < island_cache.constraint_island_count; ++cached_index) {
+			const LocalVector<GodotConstraint2D *> &cached_island = island_cache.constraint_islands[cached_index];
 
-			// Each constraint can be on a separate island for areas as there's no solving phase.
 			++island_count;
 			if (constraint_islands.size() < island_count) {
 				constraint_islands.resize(island_count);
 			}
 			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
 			constraint_island.clear();
+			constraint_island.reserve(cached_island.size());
 
-			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
+			for (GodotConstraint2D *constraint : cached_island) {
+				constraint->set_island_step(_step);
+				constraint_island.push_back(constraint);
+				all_constraints.push_back(constraint);
+			}
+		}
+	} else {
+		b = body_list->first();
+		while (b) {
+			GodotBody2D *body = b->self();
+
+			if (body->get_island_step() != _step) {
+				++body_island_count;
+				if (body_islands.size() < body_island_count) {
+					body_islands.resize(body_island_count);
+				}
+				LocalVector<GodotBody2D *> &body_island = body_islands[body_island_count - 1];
+				body_island.clear();
+				body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+
+				++island_count;
+				if (constraint_islands.size() < island_count) {
+					constraint_islands.resize(island_count);
+				}
+				LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
+				constraint_island.clear();
+				constraint_island.reserve(ISLAND_SIZE_RESERVE);
+
+				_populate_island(body, body_island, constraint_island);
+
+				if (body_island.is_empty()) {
+					--body_island_count;
+				}
+
+				if (constraint_island.is_empty()) {
+					--island_count;
+				}
+			}
+			b = b->next();
 		}
-		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
-	}
-
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+		// Keep a copy of the constraint islands, since pre-solving removes constraints from them.
+		if (island_cache.constraint_islands.size() < island_count) {
+			island_cache.constraint_islands.resize(island_count);
+		}
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			island_cache.constraint_islands[island_index] = constraint_islands[island_index];
+		}
+		island_cache.constraint_island_count = island_count;
+		island_cache.body_island_count = body_island_count;
+		island_cache.version = p_space->get_island_version();
+	}
 
-	uint32_t body_island_count = 0;
+	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
 
-	while (b) {
-		GodotBody2D *body = b->self();
+	const SelfList<GodotArea2D>::List &aml = p_space->get_moved_area_list();
 
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
+	while (aml.first()) {
+		for (GodotConstraint2D *E : aml.first()->self()->get_constraints()) {
+			GodotConstraint2D *constraint = E;
+			if (constraint->get_island_step() == _step) {
+				continue;
 			}
-			LocalVector<GodotBody2D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+			constraint->set_island_step(_step);
 
+			// Each constraint can be on a separate island for areas as there's no solving phase.
 			++island_count;
 			if (constraint_islands.size() < island_count) {
 				constraint_islands.resize(island_count);
 			}
 			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
 			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
 
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+			all_constraints.push_back(constraint);
+			constraint_island.push_back(constraint);
 		}
-		b = b->next();
+		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -297,7 +331,6 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 }
 
 GodotStep2D::GodotStep2D() {
-	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
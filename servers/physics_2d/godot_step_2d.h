@@ -41,7 +41,7 @@ class GodotStep2D {
 	int iterations = 0;
 	real_t delta = 0.0;
 
-	LocalVector<LocalVector<GodotBody2D *>> body_islands;
+	// Body islands are kept in the island cache of each space.
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
@@ -161,95 +161,6 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
-// _test_ccd prevents tunneling by slowing down a high velocity body that is about to collide so that next frame it will be at an appropriate location to collide (i.e. slight overlap)
-// Warning: the way velocity is adjusted down to cause a collision means the momentum will be weaker than it should for a bounce!
-// Process: only proceed if body A's motion is high relative to its size.
-// cast forward along motion vector to see if A is going to enter/pass B's collider next frame, only proceed if it does.
-// adjust the velocity of A down so that it will just slightly intersect the collider instead of blowing right past it.
-bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
-	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
-
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
-	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON) {
-		return false;
-	}
-
-	Vector3 mnormal = motion / mlen;
-
-	real_t min = 0.0, max = 0.0;
-	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
-
-	// Did it move enough in this direction to even attempt raycast?
-	// Let's say it should move more than 1/3 the size of the object in that axis.
-	bool fast_object = mlen > (max - min) * 0.3;
-	if (!fast_object) {
-		return false; // moving slow enough that there's no chance of tunneling.
-	}
-
-	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
-
-	// Roughly predict body B's position in the next frame (ignoring collisions).
-	Transform3D predicted_xform_B = p_xform_B.translated(p_B->get_linear_velocity() * p_step);
-
-	// Support points are the farthest forward points on A in the direction of the motion vector.
-	// i.e. the candidate points of which one should hit B first if any collision does occur.
-	static const int max_supports = 16;
-	Vector3 supports_A[max_supports];
-	int support_count_A;
-	GodotShape3D::FeatureType support_type_A;
-	// Convert mnormal into body A's local xform because get_supports requires (and returns) local coordinates.
-	shape_A_ptr->get_supports(p_xform_A.basis.xform_inv(mnormal).normalized(), max_supports, supports_A, support_count_A, support_type_A);
-
-	// Cast a segment from each support point of A in the motion direction.
-	int segment_support_idx = -1;
-	float segment_hit_length = FLT_MAX;
-	Vector3 segment_hit_local;
-	for (int i = 0; i < support_count_A; i++) {
-		supports_A[i] = p_xform_A.xform(supports_A[i]);
-
-		Vector3 from = supports_A[i];
-		Vector3 to = from + motion;
-
-		Transform3D from_inv = predicted_xform_B.affine_inverse();
-
-		// Back up 10% of the per-frame motion behind the support point and use that as the beginning of our cast.
-		// At high speeds, this may mean we're actually casting from well behind the body instead of inside it, which is odd.
-		// But it still works out.
-		Vector3 local_from = from_inv.xform(from - motion * 0.1);
-		Vector3 local_to = from_inv.xform(to);
-
-		Vector3 rpos, rnorm;
-		int fi = -1;
-		if (p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm, fi, true)) {
-			float hit_length = local_from.distance_to(rpos);
-			if (hit_length < segment_hit_length) {
-				segment_support_idx = i;
-				segment_hit_length = hit_length;
-				segment_hit_local = rpos;
-			}
-		}
-	}
-
-	if (segment_support_idx == -1) {
-		// There was no hit. Since the segment is the length of per-frame motion, this means the bodies will not
-		// actually collide yet on next frame. We'll probably check again next frame once they're closer.
-		return false;
-	}
-
-	Vector3 hitpos = predicted_xform_B.xform(segment_hit_local);
-
-	real_t newlen = hitpos.distance_to(supports_A[segment_support_idx]);
-	// Adding 1% of body length to the distance between collision and support point
-	// should cause body A's support point to arrive just within B's collider next frame.
-	newlen += (max - min) * 0.01;
-	// FIXME: This doesn't always work well when colliding with a triangle face of a trimesh shape.
-
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
-
-	return true;
-}
-
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -259,8 +170,6 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 }
 
 bool GodotBodyPair3D::setup(real_t p_step) {
-	check_ccd = false;
-
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
 		return false;
@@ -296,43 +205,11 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
-	if (!collided) {
-		if (A->is_continuous_collision_detection_enabled() && collide_A) {
-			check_ccd = true;
-			return true;
-		}
-
-		if (B->is_continuous_collision_detection_enabled() && collide_B) {
-			check_ccd = true;
-			return true;
-		}
-
-		return false;
-	}
-
-	return true;
+	return collided;
 }
 
 bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	if (!collided) {
-		if (check_ccd) {
-			const Vector3 &offset_A = A->get_transform().get_origin();
-			Transform3D xform_Au = Transform3D(A->get_transform().basis, Vector3());
-			Transform3D xform_A = xform_Au * A->get_shape_transform(shape_A);
-
-			Transform3D xform_Bu = B->get_transform();
-			xform_Bu.origin -= offset_A;
-			Transform3D xform_B = xform_Bu * B->get_shape_transform(shape_B);
-
-			if (A->is_continuous_collision_detection_enabled() && collide_A) {
-				_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
-			}
-
-			if (B->is_continuous_collision_detection_enabled() && collide_B) {
-				_test_ccd(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
-			}
-		}
-
 		return false;
 	}
 
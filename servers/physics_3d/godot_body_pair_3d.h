@@ -61,7 +61,6 @@ protected:
 
 	Vector3 sep_axis;
 	bool collided = false;
-	bool check_ccd = false;
 
 	GodotSpace3D *space = nullptr;
 
@@ -102,7 +101,6 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
-	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
 	virtual bool setup(real_t p_step) override;
@@ -66,6 +66,9 @@ public:
 
 	virtual void update() = 0;
 
+	// Allows spreading the work done in update() over WorkerThreadPool tasks, if supported.
+	virtual void set_threaded(bool p_enable) {}
+
 	virtual ~GodotBroadPhase3D();
 };
 
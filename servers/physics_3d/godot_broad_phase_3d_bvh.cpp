@@ -115,7 +115,15 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 }
 
 void GodotBroadPhase3DBVH::update() {
-	bvh.update();
+	if (threaded) {
+		bvh.update_threaded();
+	} else {
+		bvh.update();
+	}
+}
+
+void GodotBroadPhase3DBVH::set_threaded(bool p_enable) {
+	threaded = p_enable;
 }
 
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
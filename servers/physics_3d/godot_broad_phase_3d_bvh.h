@@ -73,6 +73,8 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	UnpairCallback unpair_callback = nullptr;
 	void *unpair_userdata = nullptr;
 
+	bool threaded = false;
+
 public:
 	// 0 is an invalid ID
 	virtual ID create(GodotCollisionObject3D *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) override;
@@ -92,6 +94,7 @@ public:
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
 
 	virtual void update() override;
+	virtual void set_threaded(bool p_enable) override;
 
 	static GodotBroadPhase3D *_create();
 	GodotBroadPhase3DBVH();
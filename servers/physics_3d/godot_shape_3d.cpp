@@ -1769,41 +1769,6 @@ _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_
 	return false;
 }
 
-_FORCE_INLINE_ bool _heightmap_chunk_cull_segment(_HeightmapSegmentCullParams &p_params, const _HeightmapGridCullState &p_state) {
-	const GodotHeightMapShape3D::Range &chunk = p_params.heightmap->_get_bounds_chunk(p_state.x, p_state.z);
-
-	Vector3 enter_pos;
-	Vector3 exit_pos;
-
-	if (p_state.length_flat > CMP_EPSILON) {
-		real_t flat_to_3d = p_state.length / p_state.length_flat;
-		real_t enter_param = p_state.prev_dist * flat_to_3d;
-		real_t exit_param = p_state.dist * flat_to_3d;
-		enter_pos = p_params.from + p_params.dir * enter_param;
-		exit_pos = p_params.from + p_params.dir * exit_param;
-	} else {
-		// Consider the ray vertical.
-		// (though we shouldn't reach this often because there is an early check up-front)
-		enter_pos = p_params.from;
-		exit_pos = p_params.to;
-	}
-
-	// Transform positions to heightmap space.
-	enter_pos *= GodotHeightMapShape3D::BOUNDS_CHUNK_SIZE;
-	exit_pos *= GodotHeightMapShape3D::BOUNDS_CHUNK_SIZE;
-
-	// We did enter the flat projection of the AABB,
-	// but we have to check if we intersect it on the vertical axis.
-	if ((enter_pos.y > chunk.max) && (exit_pos.y > chunk.max)) {
-		return false;
-	}
-	if ((enter_pos.y < chunk.min) && (exit_pos.y < chunk.min)) {
-		return false;
-	}
-
-	return p_params.heightmap->_intersect_grid_segment(_heightmap_cell_cull_segment, enter_pos, exit_pos, p_params.heightmap->width, p_params.heightmap->depth, p_params.heightmap->local_origin, p_params.result, p_params.normal);
-}
-
 template <typename ProcessFunction>
 bool GodotHeightMapShape3D::_intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const {
 	Vector3 delta = (p_end - p_begin);
@@ -1981,7 +1946,7 @@ bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vect
 			r_normal = params.normal;
 			return true;
 		}
-	} else if (bounds_grid.is_empty()) {
+	} else if (bounds_levels.is_empty()) {
 		// Process all cells intersecting the flat projection of the ray.
 		return _intersect_grid_segment(_heightmap_cell_cull_segment, p_begin, p_end, width, depth, local_origin, r_point, r_normal);
 	} else {
@@ -1991,11 +1956,96 @@ bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vect
 			// Don't use chunks, the ray is too short in the plane.
 			return _intersect_grid_segment(_heightmap_cell_cull_segment, p_begin, p_end, width, depth, local_origin, r_point, r_normal);
 		} else {
-			// The ray is long, run raycast on a higher-level grid.
-			Vector3 bounds_from = p_begin / BOUNDS_CHUNK_SIZE;
-			Vector3 bounds_to = p_end / BOUNDS_CHUNK_SIZE;
-			Vector3 bounds_offset = local_origin / BOUNDS_CHUNK_SIZE;
-			return _intersect_grid_segment(_heightmap_chunk_cull_segment, bounds_from, bounds_to, bounds_grid_width, bounds_grid_depth, bounds_offset, r_point, r_normal);
+			// The ray is long, descend the bounds pyramid from its single top range.
+			return _intersect_bounds_segment(bounds_levels.size() - 1, 0, 0, p_begin, p_end, r_point, r_normal);
+		}
+	}
+
+	return false;
+}
+
+bool GodotHeightMapShape3D::_clip_segment_to_bounds(int p_level, int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_delta, real_t &r_enter, real_t &r_exit) const {
+	const Range &range = _get_bounds(p_level, p_x, p_z);
+	const real_t size = BOUNDS_CHUNK_SIZE << p_level;
+
+	// Slightly grown, so that segments running along chunk borders aren't missed due to rounding.
+	const real_t margin = 0.01;
+	const Vector3 bounds_min(p_x * size - margin, range.min - margin, p_z * size - margin);
+	const Vector3 bounds_max((p_x + 1) * size + margin, range.max + margin, (p_z + 1) * size + margin);
+
+	r_enter = 0.0;
+	r_exit = 1.0;
+	for (int i = 0; i < 3; i++) {
+		if (Math::abs(p_delta[i]) < CMP_EPSILON) {
+			if (p_begin[i] < bounds_min[i] || p_begin[i] > bounds_max[i]) {
+				return false;
+			}
+			continue;
+		}
+
+		const real_t inv_delta = 1.0 / p_delta[i];
+		real_t near = (bounds_min[i] - p_begin[i]) * inv_delta;
+		real_t far = (bounds_max[i] - p_begin[i]) * inv_delta;
+		if (near > far) {
+			SWAP(near, far);
+		}
+		r_enter = MAX(r_enter, near);
+		r_exit = MIN(r_exit, far);
+		if (r_enter > r_exit) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool GodotHeightMapShape3D::_intersect_bounds_segment(int p_level, int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+	const Vector3 delta = p_end - p_begin;
+	const Vector3 local_begin = p_begin + local_origin;
+
+	real_t enter = 0.0;
+	real_t exit = 0.0;
+	if (!_clip_segment_to_bounds(p_level, p_x, p_z, local_begin, delta, enter, exit)) {
+		return false;
+	}
+
+	if (p_level == 0) {
+		// Walk the cells of this chunk covered by the segment.
+		return _intersect_grid_segment(_heightmap_cell_cull_segment, p_begin + delta * enter, p_begin + delta * exit, width, depth, local_origin, r_point, r_normal);
+	}
+
+	// Visit the children in the order the segment enters them, so the first hit is the closest one.
+	struct Child {
+		int x = 0;
+		int z = 0;
+		real_t enter = 0.0;
+	};
+	Child children[4];
+	int child_count = 0;
+
+	const BoundsLevel &child_level = bounds_levels[p_level - 1];
+	for (int z = p_z * 2; z < MIN(p_z * 2 + 2, child_level.depth); z++) {
+		for (int x = p_x * 2; x < MIN(p_x * 2 + 2, child_level.width); x++) {
+			real_t child_enter = 0.0;
+			real_t child_exit = 0.0;
+			if (!_clip_segment_to_bounds(p_level - 1, x, z, local_begin, delta, child_enter, child_exit)) {
+				continue;
+			}
+
+			int i = child_count++;
+			while (i > 0 && children[i - 1].enter > child_enter) {
+				children[i] = children[i - 1];
+				i--;
+			}
+			children[i].x = x;
+			children[i].z = z;
+			children[i].enter = child_enter;
+		}
+	}
+
+	for (int i = 0; i < child_count; i++) {
+		if (_intersect_bounds_segment(p_level - 1, children[i].x, children[i].z, p_begin, p_end, r_point, r_normal)) {
+			return true;
 		}
 	}
 
@@ -2053,26 +2103,67 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
+	if (bounds_levels.is_empty()) {
+		_cull_cells(start_x, end_x, start_z, end_z, face, p_callback, p_userdata);
+		return;
+	}
+
+	// Skip whole regions whose height range is above or below the AABB.
+	Rect2i cells(start_x, start_z, end_x - start_x, end_z - start_z);
+	_cull_bounds(bounds_levels.size() - 1, 0, 0, cells, local_aabb.position.y, local_aabb.position.y + local_aabb.size.y, face, p_callback, p_userdata);
+}
+
+bool GodotHeightMapShape3D::_cull_cells(int p_from_x, int p_to_x, int p_from_z, int p_to_z, GodotFaceShape3D &p_face, QueryCallback p_callback, void *p_userdata) const {
+	for (int z = p_from_z; z < p_to_z; z++) {
+		for (int x = p_from_x; x < p_to_x; x++) {
 			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+			_get_point(x, z, p_face.vertex[0]);
+			_get_point(x + 1, z, p_face.vertex[1]);
+			_get_point(x, z + 1, p_face.vertex[2]);
+			p_face.normal = Plane(p_face.vertex[0], p_face.vertex[1], p_face.vertex[2]).normal;
+			if (p_callback(p_userdata, &p_face)) {
+				return true;
 			}
 
 			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+			p_face.vertex[0] = p_face.vertex[1];
+			_get_point(x + 1, z + 1, p_face.vertex[1]);
+			p_face.normal = Plane(p_face.vertex[0], p_face.vertex[1], p_face.vertex[2]).normal;
+			if (p_callback(p_userdata, &p_face)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool GodotHeightMapShape3D::_cull_bounds(int p_level, int p_x, int p_z, const Rect2i &p_cells, real_t p_min_height, real_t p_max_height, GodotFaceShape3D &p_face, QueryCallback p_callback, void *p_userdata) const {
+	const int size = BOUNDS_CHUNK_SIZE << p_level;
+	const Rect2i node_cells = Rect2i(p_x * size, p_z * size, size, size).intersection(p_cells);
+	if (node_cells.size.x <= 0 || node_cells.size.y <= 0) {
+		return false;
+	}
+
+	const Range &range = _get_bounds(p_level, p_x, p_z);
+	if (range.max < p_min_height || range.min > p_max_height) {
+		return false;
+	}
+
+	if (p_level == 0) {
+		return _cull_cells(node_cells.position.x, node_cells.position.x + node_cells.size.x, node_cells.position.y, node_cells.position.y + node_cells.size.y, p_face, p_callback, p_userdata);
+	}
+
+	const BoundsLevel &child_level = bounds_levels[p_level - 1];
+	for (int z = p_z * 2; z < MIN(p_z * 2 + 2, child_level.depth); z++) {
+		for (int x = p_x * 2; x < MIN(p_x * 2 + 2, child_level.width); x++) {
+			if (_cull_bounds(p_level - 1, x, z, p_cells, p_min_height, p_max_height, p_face, p_callback, p_userdata)) {
+				return true;
 			}
 		}
 	}
+
+	return false;
 }
 
 Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -2086,72 +2177,129 @@ Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
 }
 
 void GodotHeightMapShape3D::_build_accelerator() {
-	bounds_grid.clear();
+	bounds_levels.clear();
 
-	bounds_grid_width = width / BOUNDS_CHUNK_SIZE;
-	bounds_grid_depth = depth / BOUNDS_CHUNK_SIZE;
+	int chunks_width = width / BOUNDS_CHUNK_SIZE;
+	int chunks_depth = depth / BOUNDS_CHUNK_SIZE;
 
 	if (width % BOUNDS_CHUNK_SIZE > 0) {
-		++bounds_grid_width; // In case terrain size isn't dividable by chunk size.
+		++chunks_width; // In case terrain size isn't dividable by chunk size.
 	}
 
 	if (depth % BOUNDS_CHUNK_SIZE > 0) {
-		++bounds_grid_depth;
+		++chunks_depth;
 	}
 
-	uint32_t bound_grid_size = (uint32_t)(bounds_grid_width * bounds_grid_depth);
-
-	if (bound_grid_size < 2) {
+	if (chunks_width * chunks_depth < 2) {
 		// Grid is empty or just one chunk.
 		return;
 	}
 
-	bounds_grid.resize(bound_grid_size);
-
-	// Compute min and max height for all chunks.
-	for (int cz = 0; cz < bounds_grid_depth; ++cz) {
-		int z0 = cz * BOUNDS_CHUNK_SIZE;
-
-		for (int cx = 0; cx < bounds_grid_width; ++cx) {
-			int x0 = cx * BOUNDS_CHUNK_SIZE;
-
-			Range r;
-
-			r.min = _get_height(x0, z0);
-			r.max = r.min;
-
-			// Compute min and max height for this chunk.
-			// We have to include one extra cell to account for neighbors.
-			// Here is why:
-			// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
-			//
-			//   Left        Right
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			//           x
-			//
-			// If the AABB for the Left chunk did not share vertices with the Right,
-			// then we would fail collision tests at x due to a gap.
-			//
-			int z_max = MIN(z0 + BOUNDS_CHUNK_SIZE + 1, depth);
-			int x_max = MIN(x0 + BOUNDS_CHUNK_SIZE + 1, width);
-			for (int z = z0; z < z_max; ++z) {
-				for (int x = x0; x < x_max; ++x) {
-					real_t height = _get_height(x, z);
-					if (height < r.min) {
-						r.min = height;
-					} else if (height > r.max) {
-						r.max = height;
-					}
-				}
+	// Allocate all levels, halving the resolution until a single range is left.
+	int level_width = chunks_width;
+	int level_depth = chunks_depth;
+	while (true) {
+		BoundsLevel level;
+		level.width = level_width;
+		level.depth = level_depth;
+		level.ranges.resize(level_width * level_depth);
+		bounds_levels.push_back(level);
+
+		if (level_width == 1 && level_depth == 1) {
+			break;
+		}
+		level_width = (level_width + 1) / 2;
+		level_depth = (level_depth + 1) / 2;
+	}
+
+	_update_accelerator(0, 0, width - 1, depth - 1);
+}
+
+void GodotHeightMapShape3D::_update_accelerator(int p_from_x, int p_from_z, int p_to_x, int p_to_z) {
+	if (bounds_levels.is_empty()) {
+		return;
+	}
+
+	// Chunks share their border vertices with their neighbors, see _update_bounds_chunk().
+	int from_x = MAX(p_from_x - 1, 0) / BOUNDS_CHUNK_SIZE;
+	int from_z = MAX(p_from_z - 1, 0) / BOUNDS_CHUNK_SIZE;
+	int to_x = MIN(p_to_x / BOUNDS_CHUNK_SIZE, bounds_levels[0].width - 1);
+	int to_z = MIN(p_to_z / BOUNDS_CHUNK_SIZE, bounds_levels[0].depth - 1);
+
+	for (int z = from_z; z <= to_z; ++z) {
+		for (int x = from_x; x <= to_x; ++x) {
+			_update_bounds_chunk(x, z);
+		}
+	}
+
+	for (uint32_t level = 1; level < bounds_levels.size(); ++level) {
+		from_x /= 2;
+		from_z /= 2;
+		to_x /= 2;
+		to_z /= 2;
+		for (int z = from_z; z <= to_z; ++z) {
+			for (int x = from_x; x <= to_x; ++x) {
+				_update_bounds_parent(level, x, z);
 			}
+		}
+	}
+}
 
-			bounds_grid[cx + cz * bounds_grid_width] = r;
+void GodotHeightMapShape3D::_update_bounds_chunk(int p_x, int p_z) {
+	int x0 = p_x * BOUNDS_CHUNK_SIZE;
+	int z0 = p_z * BOUNDS_CHUNK_SIZE;
+
+	Range r;
+
+	r.min = _get_height(x0, z0);
+	r.max = r.min;
+
+	// Compute min and max height for this chunk.
+	// We have to include one extra cell to account for neighbors.
+	// Here is why:
+	// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
+	//
+	//   Left        Right
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	//           x
+	//
+	// If the AABB for the Left chunk did not share vertices with the Right,
+	// then we would fail collision tests at x due to a gap.
+	//
+	int z_max = MIN(z0 + BOUNDS_CHUNK_SIZE + 1, depth);
+	int x_max = MIN(x0 + BOUNDS_CHUNK_SIZE + 1, width);
+	for (int z = z0; z < z_max; ++z) {
+		for (int x = x0; x < x_max; ++x) {
+			real_t height = _get_height(x, z);
+			if (height < r.min) {
+				r.min = height;
+			} else if (height > r.max) {
+				r.max = height;
+			}
 		}
 	}
+
+	bounds_levels[0].ranges[p_x + p_z * bounds_levels[0].width] = r;
+}
+
+void GodotHeightMapShape3D::_update_bounds_parent(int p_level, int p_x, int p_z) {
+	const BoundsLevel &child_level = bounds_levels[p_level - 1];
+
+	Range r = _get_bounds(p_level - 1, p_x * 2, p_z * 2);
+	for (int z = p_z * 2; z < MIN(p_z * 2 + 2, child_level.depth); ++z) {
+		for (int x = p_x * 2; x < MIN(p_x * 2 + 2, child_level.width); ++x) {
+			const Range &child = _get_bounds(p_level - 1, x, z);
+			r.min = MIN(r.min, child.min);
+			r.max = MAX(r.max, child.max);
+		}
+	}
+
+	BoundsLevel &level = bounds_levels[p_level];
+	level.ranges[p_x + p_z * level.width] = r;
 }
 
 void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
@@ -2175,6 +2323,47 @@ void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width,
 	configure(aabb_new);
 }
 
+void GodotHeightMapShape3D::_update_region(const Rect2i &p_region, const Vector<real_t> &p_heights) {
+	ERR_FAIL_COND_MSG(!Rect2i(0, 0, width, depth).encloses(p_region), "Heightmap region must be inside the heightmap.");
+	ERR_FAIL_COND(p_heights.size() != p_region.size.x * p_region.size.y);
+
+	if (p_region.size.x <= 0 || p_region.size.y <= 0) {
+		return;
+	}
+
+	real_t min_height = get_aabb().position.y;
+	real_t max_height = min_height + get_aabb().size.y;
+	bool bounds_grown = false;
+
+	real_t *w = heights.ptrw();
+	const real_t *r = p_heights.ptr();
+	for (int z = 0; z < p_region.size.y; ++z) {
+		real_t *row = &w[(p_region.position.y + z) * width + p_region.position.x];
+		for (int x = 0; x < p_region.size.x; ++x) {
+			real_t h = r[z * p_region.size.x + x];
+			row[x] = h;
+			if (h < min_height) {
+				min_height = h;
+				bounds_grown = true;
+			} else if (h > max_height) {
+				max_height = h;
+				bounds_grown = true;
+			}
+		}
+	}
+
+	_update_accelerator(p_region.position.x, p_region.position.y, p_region.position.x + p_region.size.x - 1, p_region.position.y + p_region.size.y - 1);
+
+	// The AABB only grows, so it stays valid without rescanning all heights.
+	AABB aabb_new = get_aabb();
+	if (bounds_grown) {
+		aabb_new.position.y = min_height;
+		aabb_new.size.y = max_height - min_height;
+	}
+	// Also lets the owners know that the faces changed.
+	configure(aabb_new);
+}
+
 void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(p_data.get_type() != Variant::DICTIONARY);
 
@@ -2189,6 +2378,14 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(width_new <= 0.0);
 	ERR_FAIL_COND(depth_new <= 0.0);
 
+	if (d.has("region")) {
+		// Partial update of an existing heightmap, "heights" only holds the region.
+		ERR_FAIL_COND_MSG(width_new != width || depth_new != depth, "Heightmap region updates can't change the heightmap size.");
+		Vector<real_t> region_heights = d["heights"];
+		_update_region(d["region"], region_heights);
+		return;
+	}
+
 	Variant heights_variant = d["heights"];
 	Vector<real_t> heights_buffer;
 #ifdef REAL_T_IS_DOUBLE
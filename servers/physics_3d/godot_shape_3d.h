@@ -394,14 +394,21 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 		real_t min = 0.0;
 		real_t max = 0.0;
 	};
-	LocalVector<Range> bounds_grid;
-	int bounds_grid_width = 0;
-	int bounds_grid_depth = 0;
+
+	// Min/max height pyramid. Level 0 holds the range of each chunk of BOUNDS_CHUNK_SIZE cells,
+	// each following level merges 2x2 ranges of the previous one, up to a single range.
+	struct BoundsLevel {
+		LocalVector<Range> ranges;
+		int width = 0;
+		int depth = 0;
+	};
+	LocalVector<BoundsLevel> bounds_levels;
 
 	static const int BOUNDS_CHUNK_SIZE = 16;
 
-	_FORCE_INLINE_ const Range &_get_bounds_chunk(int p_x, int p_z) const {
-		return bounds_grid[(p_z * bounds_grid_width) + p_x];
+	_FORCE_INLINE_ const Range &_get_bounds(int p_level, int p_x, int p_z) const {
+		const BoundsLevel &level = bounds_levels[p_level];
+		return level.ranges[(p_z * level.width) + p_x];
 	}
 
 	_FORCE_INLINE_ real_t _get_height(int p_x, int p_z) const {
@@ -417,11 +424,19 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
 
 	void _build_accelerator();
+	void _update_accelerator(int p_from_x, int p_from_z, int p_to_x, int p_to_z);
+	void _update_bounds_chunk(int p_x, int p_z);
+	void _update_bounds_parent(int p_level, int p_x, int p_z);
+	bool _clip_segment_to_bounds(int p_level, int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_delta, real_t &r_enter, real_t &r_exit) const;
+	bool _intersect_bounds_segment(int p_level, int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const;
+	bool _cull_cells(int p_from_x, int p_to_x, int p_from_z, int p_to_z, GodotFaceShape3D &p_face, QueryCallback p_callback, void *p_userdata) const;
+	bool _cull_bounds(int p_level, int p_x, int p_z, const Rect2i &p_cells, real_t p_min_height, real_t p_max_height, GodotFaceShape3D &p_face, QueryCallback p_callback, void *p_userdata) const;
 
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
 
 	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
+	void _update_region(const Rect2i &p_region, const Vector<real_t> &p_heights);
 
 public:
 	Vector<real_t> get_heights() const;
@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
@@ -54,6 +55,49 @@ subject to the following restrictions:
 */
 ///btSoftBody implementation by Nathanael Presson
 
+#define SOFT_BODY_LINK_CHUNK_SIZE 256
+
+void GodotSoftBody3D::Nodes::resize(uint32_t p_size) {
+	s.resize(p_size);
+	x.resize(p_size);
+	q.resize(p_size);
+	f.resize(p_size);
+	v.resize(p_size);
+	bv.resize(p_size);
+	n.resize(p_size);
+	area.resize(p_size);
+	im.resize(p_size);
+	leaf.resize(p_size);
+}
+
+void GodotSoftBody3D::Nodes::clear() {
+	s.clear();
+	x.clear();
+	q.clear();
+	f.clear();
+	v.clear();
+	bv.clear();
+	n.clear();
+	area.clear();
+	im.clear();
+	leaf.clear();
+}
+
+void GodotSoftBody3D::Links::clear() {
+	n.clear();
+	rl.clear();
+	c0.clear();
+	c1.clear();
+}
+
+void GodotSoftBody3D::Faces::clear() {
+	n.clear();
+	centroid.clear();
+	normal.clear();
+	ra.clear();
+	leaf.clear();
+}
+
 GodotSoftBody3D::GodotSoftBody3D() :
 		GodotCollisionObject3D(TYPE_SOFT_BODY),
 		active_list(this) {
@@ -154,34 +198,41 @@ void GodotSoftBody3D::update_rendering_server(PhysicsServer3DRenderingServerHand
 	const uint32_t vertex_count = map_visual_to_physics.size();
 	for (uint32_t i = 0; i < vertex_count; ++i) {
 		const uint32_t node_index = map_visual_to_physics[i];
-		const Node &node = nodes[node_index];
 
-		p_rendering_server_handler->set_vertex(i, node.x);
-		p_rendering_server_handler->set_normal(i, node.n);
+		p_rendering_server_handler->set_vertex(i, nodes.x[node_index]);
+		p_rendering_server_handler->set_normal(i, nodes.n[node_index]);
 	}
 
 	p_rendering_server_handler->set_aabb(bounds);
 }
 
 void GodotSoftBody3D::update_normals_and_centroids() {
-	for (Node &node : nodes) {
-		node.n = Vector3();
+	const uint32_t node_count = nodes.size();
+	Vector3 *node_normals = nodes.n.ptr();
+	const Vector3 *node_positions = nodes.x.ptr();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		node_normals[node_index] = Vector3();
 	}
 
-	for (Face &face : faces) {
-		const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
-		face.n[0]->n += n;
-		face.n[1]->n += n;
-		face.n[2]->n += n;
-		face.normal = n;
-		face.normal.normalize();
-		face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
+	const uint32_t face_count = faces.size();
+	const uint32_t *face_nodes = faces.n.ptr();
+	for (uint32_t face_index = 0; face_index < face_count; ++face_index) {
+		const uint32_t *fn = &face_nodes[face_index * 3];
+		const Vector3 &x0 = node_positions[fn[0]];
+		const Vector3 &x1 = node_positions[fn[1]];
+		const Vector3 &x2 = node_positions[fn[2]];
+		const Vector3 n = vec3_cross(x0 - x2, x0 - x1);
+		node_normals[fn[0]] += n;
+		node_normals[fn[1]] += n;
+		node_normals[fn[2]] += n;
+		faces.normal[face_index] = n.normalized();
+		faces.centroid[face_index] = 0.33333333333 * (x0 + x1 + x2);
 	}
 
-	for (Node &node : nodes) {
-		real_t len = node.n.length();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		real_t len = node_normals[node_index].length();
 		if (len > CMP_EPSILON) {
-			node.n /= len;
+			node_normals[node_index] /= len;
 		}
 	}
 }
@@ -201,15 +252,15 @@ void GodotSoftBody3D::update_bounds() {
 	bool first = true;
 	bool moved = false;
 	for (uint32_t node_index = 0; node_index < nodes_count; ++node_index) {
-		const Node &node = nodes[node_index];
-		if (!prev_bounds.has_point(node.x)) {
+		const Vector3 &x = nodes.x[node_index];
+		if (!prev_bounds.has_point(x)) {
 			moved = true;
 		}
 		if (first) {
-			bounds.position = node.x;
+			bounds.position = x;
 			first = false;
 		} else {
-			bounds.expand_to(node.x);
+			bounds.expand_to(x);
 		}
 	}
 
@@ -228,56 +279,61 @@ void GodotSoftBody3D::update_area() {
 	int i, ni;
 
 	// Face area.
-	for (Face &face : faces) {
-		const Vector3 &x0 = face.n[0]->x;
-		const Vector3 &x1 = face.n[1]->x;
-		const Vector3 &x2 = face.n[2]->x;
+	const uint32_t face_count = faces.size();
+	for (uint32_t face_index = 0; face_index < face_count; ++face_index) {
+		const uint32_t *fn = &faces.n[face_index * 3];
+		const Vector3 &x0 = nodes.x[fn[0]];
+		const Vector3 &x1 = nodes.x[fn[1]];
+		const Vector3 &x2 = nodes.x[fn[2]];
 
 		const Vector3 a = x1 - x0;
 		const Vector3 b = x2 - x0;
 		const Vector3 cr = vec3_cross(a, b);
-		face.ra = cr.length() * 0.5;
+		faces.ra[face_index] = cr.length() * 0.5;
 	}
 
 	// Node area.
-	LocalVector<int> counts;
+	FrameLocalVector<int> counts;
 	if (nodes.size() > 0) {
 		counts.resize(nodes.size());
 		memset(counts.ptr(), 0, counts.size() * sizeof(int));
 	}
 
-	for (Node &node : nodes) {
-		node.area = 0.0;
+	for (real_t &area : nodes.area) {
+		area = 0.0;
 	}
 
-	for (const Face &face : faces) {
+	for (uint32_t face_index = 0; face_index < face_count; ++face_index) {
 		for (int j = 0; j < 3; ++j) {
-			const int index = (int)(face.n[j] - &nodes[0]);
+			const uint32_t index = faces.n[face_index * 3 + j];
 			counts[index]++;
-			face.n[j]->area += Math::abs(face.ra);
+			nodes.area[index] += Math::abs(faces.ra[face_index]);
 		}
 	}
 
 	for (i = 0, ni = nodes.size(); i < ni; ++i) {
 		if (counts[i] > 0) {
-			nodes[i].area /= (real_t)counts[i];
+			nodes.area[i] /= (real_t)counts[i];
 		} else {
-			nodes[i].area = 0.0;
+			nodes.area[i] = 0.0;
 		}
 	}
 }
 
 void GodotSoftBody3D::reset_link_rest_lengths() {
-	for (Link &link : links) {
-		link.rl = (link.n[0]->x - link.n[1]->x).length();
-		link.c1 = link.rl * link.rl;
+	const uint32_t link_count = links.size();
+	for (uint32_t link_index = 0; link_index < link_count; ++link_index) {
+		const real_t rl = (nodes.x[links.n[link_index * 2]] - nodes.x[links.n[link_index * 2 + 1]]).length();
+		links.rl[link_index] = rl;
+		links.c1[link_index] = rl * rl;
 	}
 }
 
 void GodotSoftBody3D::update_link_constants() {
 	real_t inv_linear_stiffness = 1.0 / linear_stiffness;
-	for (Link &link : links) {
-		link.c0 = (link.n[0]->im + link.n[1]->im) * inv_linear_stiffness;
+	const uint32_t link_count = links.size();
+	for (uint32_t link_index = 0; link_index < link_count; ++link_index) {
+		links.c0[link_index] = (nodes.im[links.n[link_index * 2]] + nodes.im[links.n[link_index * 2 + 1]]) * inv_linear_stiffness;
 	}
 }
 
@@ -289,15 +345,14 @@ void GodotSoftBody3D::apply_nodes_transform(const Transform3D &p_transform) {
 	uint32_t node_count = nodes.size();
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
-
-		node.x = p_transform.xform(node.x);
-		node.q = node.x;
-		node.v = Vector3();
-		node.bv = Vector3();
+		const Vector3 x = p_transform.xform(nodes.x[node_index]);
+		nodes.x[node_index] = x;
+		nodes.q[node_index] = x;
+		nodes.v[node_index] = Vector3();
+		nodes.bv[node_index] = Vector3();
 
-		AABB node_aabb(node.x, leaf_size);
-		node_tree.update(node.leaf, node_aabb);
+		AABB node_aabb(x, leaf_size);
+		node_tree.update(nodes.leaf[node_index], node_aabb);
 	}
 
 	face_tree.clear();
@@ -318,7 +373,7 @@ Vector3 GodotSoftBody3D::get_vertex_position(int p_index) const {
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND_V(node_index >= nodes.size(), Vector3());
-	return nodes[node_index].x;
+	return nodes.x[node_index];
 }
 
 void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position) {
@@ -332,9 +387,8 @@ void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND(node_index >= nodes.size());
-	Node &node = nodes[node_index];
-	node.q = node.x;
-	node.x = p_position;
+	nodes.q[node_index] = nodes.x[node_index];
+	nodes.x[node_index] = p_position;
 }
 
 void GodotSoftBody3D::pin_vertex(int p_index) {
@@ -351,8 +405,7 @@ void GodotSoftBody3D::pin_vertex(int p_index) {
 		uint32_t node_index = map_visual_to_physics[p_index];
 
 		ERR_FAIL_COND(node_index >= nodes.size());
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		nodes.im[node_index] = 0.0;
 	}
 }
 
@@ -371,8 +424,7 @@ void GodotSoftBody3D::unpin_vertex(int p_index) {
 				ERR_FAIL_COND(node_index >= nodes.size());
 				real_t inv_node_mass = nodes.size() * inv_total_mass;
 
-				Node &node = nodes[node_index];
-				node.im = inv_node_mass;
+				nodes.im[node_index] = inv_node_mass;
 			}
 
 			return;
@@ -391,8 +443,7 @@ void GodotSoftBody3D::unpin_all_vertices() {
 			uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 			ERR_CONTINUE(node_index >= nodes.size());
-			Node &node = nodes[node_index];
-			node.im = inv_node_mass;
+			nodes.im[node_index] = inv_node_mass;
 		}
 	}
 
@@ -418,34 +469,32 @@ uint32_t GodotSoftBody3D::get_node_count() const {
 
 real_t GodotSoftBody3D::get_node_inv_mass(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), 0.0);
-	return nodes[p_node_index].im;
+	return nodes.im[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_position(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].x;
+	return nodes.x[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].v;
+	return nodes.v[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_biased_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].bv;
+	return nodes.bv[p_node_index];
 }
 
 void GodotSoftBody3D::apply_node_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.v += p_impulse * node.im;
+	nodes.v[p_node_index] += p_impulse * nodes.im[p_node_index];
 }
 
 void GodotSoftBody3D::apply_node_bias_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.bv += p_impulse * node.im;
+	nodes.bv[p_node_index] += p_impulse * nodes.im[p_node_index];
 }
 
 uint32_t GodotSoftBody3D::get_face_count() const {
@@ -454,15 +503,15 @@ uint32_t GodotSoftBody3D::get_face_count() const {
 
 void GodotSoftBody3D::get_face_points(uint32_t p_face_index, Vector3 &r_point_1, Vector3 &r_point_2, Vector3 &r_point_3) const {
 	ERR_FAIL_UNSIGNED_INDEX(p_face_index, faces.size());
-	const Face &face = faces[p_face_index];
-	r_point_1 = face.n[0]->x;
-	r_point_2 = face.n[1]->x;
-	r_point_3 = face.n[2]->x;
+	const uint32_t *fn = &faces.n[p_face_index * 3];
+	r_point_1 = nodes.x[fn[0]];
+	r_point_2 = nodes.x[fn[1]];
+	r_point_3 = nodes.x[fn[2]];
 }
 
 Vector3 GodotSoftBody3D::get_face_normal(uint32_t p_face_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_face_index, faces.size(), Vector3());
-	return faces[p_face_index].normal;
+	return faces.normal[p_face_index];
 }
 
 bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices) {
@@ -528,32 +577,30 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 	real_t inv_node_mass = node_count * inv_total_mass;
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t i = 0; i < node_count; ++i) {
-		Node &node = nodes[i];
-		node.s = vertices[i];
-		node.x = node.s;
-		node.q = node.s;
-		node.im = inv_node_mass;
+		nodes.s[i] = vertices[i];
+		nodes.x[i] = vertices[i];
+		nodes.q[i] = vertices[i];
+		nodes.f[i] = Vector3();
+		nodes.v[i] = Vector3();
+		nodes.bv[i] = Vector3();
+		nodes.n[i] = Vector3();
+		nodes.area[i] = 0.0;
+		nodes.im[i] = inv_node_mass;
 
-		AABB node_aabb(node.x, leaf_size);
-		node.leaf = node_tree.insert(node_aabb, &node);
-
-		node.index = i;
+		AABB node_aabb(vertices[i], leaf_size);
+		nodes.leaf[i] = node_tree.insert(node_aabb, (void *)(uintptr_t)i);
 	}
 
 	// Create links and faces from triangles.
-	LocalVector<bool> chks;
-	chks.resize(node_count * node_count);
-	memset(chks.ptr(), 0, chks.size() * sizeof(bool));
+	HashSet<uint64_t> edges;
 
 	for (uint32_t i = 0; i < triangle_count * 3; i += 3) {
 		const int idx[] = { triangles[i], triangles[i + 1], triangles[i + 2] };
 
 		for (int j = 2, k = 0; k < 3; j = k++) {
-			int chk = idx[k] * node_count + idx[j];
-			if (!chks[chk]) {
-				chks[chk] = true;
-				int inv_chk = idx[j] * node_count + idx[k];
-				chks[inv_chk] = true;
+			const uint64_t edge = ((uint64_t)MIN(idx[j], idx[k]) << 32) | (uint64_t)MAX(idx[j], idx[k]);
+			if (!edges.has(edge)) {
+				edges.insert(edge);
 
 				append_link(idx[j], idx[k]);
 			}
@@ -571,12 +618,11 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 		uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 		ERR_CONTINUE(node_index >= node_count);
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		nodes.im[node_index] = 0.0;
 	}
 
 	generate_bending_constraints(2);
-	reoptimize_link_order();
+	generate_link_batches();
 
 	update_constants();
 	update_normals_and_centroids();
@@ -586,239 +632,137 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 }
 
 void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
-	uint32_t i, j;
-
-	if (p_distance > 1) {
-		// Build graph.
-		const uint32_t n = nodes.size();
-		const unsigned inf = (~(unsigned)0) >> 1;
-		const uint32_t adj_size = n * n;
-		unsigned *adj = memnew_arr(unsigned, adj_size);
-
-#define IDX(_x_, _y_) ((_y_) * n + (_x_))
-		for (j = 0; j < n; ++j) {
-			for (i = 0; i < n; ++i) {
-				int idx_ij = j * n + i;
-				int idx_ji = i * n + j;
-				if (i != j) {
-					adj[idx_ij] = adj[idx_ji] = inf;
-				} else {
-					adj[idx_ij] = adj[idx_ji] = 0;
-				}
-			}
+	if (p_distance <= 1) {
+		return;
+	}
+
+	// Link every pair of nodes at exactly p_distance edges from each other.
+	// Breadth-first searches over the adjacency lists keep this linear in the
+	// node count, where a full distance matrix is quadratic in both time and memory.
+	const uint32_t n = nodes.size();
+	const uint32_t link_count = links.size();
+
+	LocalVector<LocalVector<uint32_t>> node_links;
+	node_links.resize(n);
+	for (uint32_t link_index = 0; link_index < link_count; ++link_index) {
+		const uint32_t ia = links.n[link_index * 2];
+		const uint32_t ib = links.n[link_index * 2 + 1];
+		if (node_links[ia].find(ib) == -1) {
+			node_links[ia].push_back(ib);
 		}
-		for (Link &link : links) {
-			const int ia = (int)(link.n[0] - &nodes[0]);
-			const int ib = (int)(link.n[1] - &nodes[0]);
-			int idx = ib * n + ia;
-			int idx_inv = ia * n + ib;
-			adj[idx] = 1;
-			adj[idx_inv] = 1;
+		if (node_links[ib].find(ia) == -1) {
+			node_links[ib].push_back(ia);
 		}
+	}
 
-		// Special optimized case for distance == 2.
-		if (p_distance == 2) {
-			LocalVector<LocalVector<int>> node_links;
+	const uint32_t unvisited = UINT32_MAX;
+	LocalVector<uint32_t> visited_from;
+	visited_from.resize(n);
+	for (uint32_t i = 0; i < n; ++i) {
+		visited_from[i] = unvisited;
+	}
 
-			// Build node links.
-			node_links.resize(nodes.size());
+	LocalVector<uint32_t> frontiers[2];
+	LocalVector<uint32_t> found;
 
-			for (Link &link : links) {
-				const int ia = (int)(link.n[0] - &nodes[0]);
-				const int ib = (int)(link.n[1] - &nodes[0]);
-				if (node_links[ia].find(ib) == -1) {
-					node_links[ia].push_back(ib);
-				}
+	for (uint32_t j = 0; j < n; ++j) {
+		LocalVector<uint32_t> *frontier = &frontiers[0];
+		LocalVector<uint32_t> *next_frontier = &frontiers[1];
+		frontier->clear();
+		frontier->push_back(j);
+		visited_from[j] = j;
 
-				if (node_links[ib].find(ia) == -1) {
-					node_links[ib].push_back(ia);
-				}
-			}
-			for (uint32_t ii = 0; ii < node_links.size(); ii++) {
-				for (uint32_t jj = 0; jj < node_links[ii].size(); jj++) {
-					int k = node_links[ii][jj];
-					for (const int &l : node_links[k]) {
-						if ((int)ii != l) {
-							int idx_ik = k * n + ii;
-							int idx_kj = l * n + k;
-							const unsigned sum = adj[idx_ik] + adj[idx_kj];
-							ERR_FAIL_COND(sum != 2);
-							int idx_ij = l * n + ii;
-							if (adj[idx_ij] > sum) {
-								int idx_ji = l * n + ii;
-								adj[idx_ij] = adj[idx_ji] = sum;
-							}
-						}
-					}
-				}
-			}
-		} else {
-			// Generic Floyd's algorithm.
-			for (uint32_t k = 0; k < n; ++k) {
-				for (j = 0; j < n; ++j) {
-					for (i = j + 1; i < n; ++i) {
-						int idx_ik = k * n + i;
-						int idx_kj = j * n + k;
-						const unsigned sum = adj[idx_ik] + adj[idx_kj];
-						int idx_ij = j * n + i;
-						if (adj[idx_ij] > sum) {
-							int idx_ji = j * n + i;
-							adj[idx_ij] = adj[idx_ji] = sum;
-						}
+		for (int depth = 0; depth < p_distance && !frontier->is_empty(); ++depth) {
+			next_frontier->clear();
+			for (uint32_t node : *frontier) {
+				for (uint32_t neighbor : node_links[node]) {
+					if (visited_from[neighbor] != j) {
+						visited_from[neighbor] = j;
+						next_frontier->push_back(neighbor);
 					}
 				}
 			}
+			SWAP(frontier, next_frontier);
 		}
 
-		// Build links.
-		for (j = 0; j < n; ++j) {
-			for (i = j + 1; i < n; ++i) {
-				int idx_ij = j * n + i;
-				if (adj[idx_ij] == (unsigned)p_distance) {
-					append_link(i, j);
-				}
+		// The frontier now holds the nodes at exactly p_distance.
+		found.clear();
+		for (uint32_t i : *frontier) {
+			if (i > j) {
+				found.push_back(i);
 			}
 		}
-		memdelete_arr(adj);
-	}
-}
-
-//===================================================================
-//
-//
-// This function takes in a list of interdependent Links and tries
-// to maximize the distance between calculation
-// of dependent links. This increases the amount of parallelism that can
-// be exploited by out-of-order instruction processors with large but
-// (inevitably) finite instruction windows.
-//
-//===================================================================
-
-// A small structure to track lists of dependent link calculations.
-class LinkDeps {
-public:
-	// A link calculation that is dependent on this one.
-	// Positive values = "input A" while negative values = "input B".
-	int value;
-	// Next dependence in the list.
-	LinkDeps *next;
-};
-typedef LinkDeps *LinkDepsPtr;
-
-void GodotSoftBody3D::reoptimize_link_order() {
-	const int reop_not_dependent = -1;
-	const int reop_node_complete = -2;
+		found.sort();
+		for (uint32_t i : found) {
+			append_link(i, j);
+		}
+	}
+}
 
-	uint32_t link_count = links.size();
-	uint32_t node_count = nodes.size();
+// Greedily colors the links so that no two links of the same color share a node,
+// and sorts them by color. Each color is then a batch of independent links which
+// can be solved without ordering constraints, either to keep more of them in flight
+// in the CPU pipeline or to spread them across threads.
+void GodotSoftBody3D::generate_link_batches() {
+	link_batches.clear();
 
-	if (link_count < 1 || node_count < 2) {
+	const uint32_t link_count = links.size();
+	const uint32_t node_count = nodes.size();
+	if (link_count == 0) {
 		return;
 	}
 
-	uint32_t i;
-	Link *lr;
-	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
-	LinkDepsPtr link_dep;
-	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
-
-	// Allocate temporary buffers.
-	int *node_written_at = memnew_arr(int, node_count + 1); // What link calculation produced this node's current values?
-	int *link_dep_A = memnew_arr(int, link_count); // Link calculation input is dependent upon prior calculation #N
-	int *link_dep_B = memnew_arr(int, link_count);
-	int *ready_list = memnew_arr(int, link_count); // List of ready-to-process link calculations (# of links, maximum)
-	LinkDeps *link_dep_free_list = memnew_arr(LinkDeps, 2 * link_count); // Dependent-on-me list elements (2x# of links, maximum)
-	LinkDepsPtr *link_dep_list_starts = memnew_arr(LinkDepsPtr, link_count); // Start nodes of dependent-on-me lists, one for each link
-
-	// Copy the original, unsorted links to a side buffer.
-	Link *link_buffer = memnew_arr(Link, link_count);
-	memcpy(link_buffer, &(links[0]), sizeof(Link) * link_count);
-
-	// Clear out the node setup and ready list.
-	for (i = 0; i < node_count + 1; i++) {
-		node_written_at[i] = reop_not_dependent;
-	}
-	for (i = 0; i < link_count; i++) {
-		link_dep_list_starts[i] = nullptr;
-	}
-	ready_list_head = ready_list_tail = link_dep_frees = 0;
-
-	// Initial link analysis to set up data structures.
-	for (i = 0; i < link_count; i++) {
-		// Note which prior link calculations we are dependent upon & build up dependence lists.
-		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
-		if (node_written_at[ar] > reop_not_dependent) {
-			link_dep_A[i] = node_written_at[ar];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = i;
-			link_dep->next = link_dep_list_starts[node_written_at[ar]];
-			link_dep_list_starts[node_written_at[ar]] = link_dep;
-		} else {
-			link_dep_A[i] = reop_not_dependent;
-		}
-		if (node_written_at[br] > reop_not_dependent) {
-			link_dep_B[i] = node_written_at[br];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = -(int)(i + 1);
-			link_dep->next = link_dep_list_starts[node_written_at[br]];
-			link_dep_list_starts[node_written_at[br]] = link_dep;
-		} else {
-			link_dep_B[i] = reop_not_dependent;
-		}
-
-		// Add this link to the initial ready list, if it is not dependent on any other links.
-		if ((link_dep_A[i] == reop_not_dependent) && (link_dep_B[i] == reop_not_dependent)) {
-			ready_list[ready_list_tail++] = i;
-			link_dep_A[i] = link_dep_B[i] = reop_node_complete; // Probably not needed now.
-		}
-
-		// Update the nodes to mark which ones are calculated by this link.
-		node_written_at[ar] = node_written_at[br] = i;
-	}
-
-	// Process the ready list and create the sorted list of links:
-	// -- By treating the ready list as a queue, we maximize the distance between any
-	//    inter-dependent node calculations.
-	// -- All other (non-related) nodes in the ready list will automatically be inserted
-	//    in between each set of inter-dependent link calculations by this loop.
-	i = 0;
-	while (ready_list_head != ready_list_tail) {
-		// Use ready list to select the next link to process.
-		link_num = ready_list[ready_list_head++];
-		// Copy the next-to-calculate link back into the original link array.
-		links[i++] = link_buffer[link_num];
-
-		// Free up any link inputs that are dependent on this one.
-		link_dep = link_dep_list_starts[link_num];
-		while (link_dep) {
-			dep_link = link_dep->value;
-			if (dep_link >= 0) {
-				link_dep_A[dep_link] = reop_not_dependent;
-			} else {
-				dep_link = -dep_link - 1;
-				link_dep_B[dep_link] = reop_not_dependent;
-			}
-			// Add this dependent link calculation to the ready list if *both* inputs are clear.
-			if ((link_dep_A[dep_link] == reop_not_dependent) && (link_dep_B[dep_link] == reop_not_dependent)) {
-				ready_list[ready_list_tail++] = dep_link;
-				link_dep_A[dep_link] = link_dep_B[dep_link] = reop_node_complete; // Probably not needed now.
+	LocalVector<uint32_t> node_batch;
+	node_batch.resize(node_count);
+	for (uint32_t i = 0; i < node_count; ++i) {
+		node_batch[i] = UINT32_MAX;
+	}
+
+	LocalVector<uint32_t> link_lists[2];
+	LocalVector<uint32_t> *remaining = &link_lists[0];
+	LocalVector<uint32_t> *deferred = &link_lists[1];
+	remaining->resize(link_count);
+	for (uint32_t i = 0; i < link_count; ++i) {
+		(*remaining)[i] = i;
+	}
+
+	LocalVector<uint32_t> order;
+	order.reserve(link_count);
+
+	uint32_t batch = 0;
+	while (!remaining->is_empty()) {
+		link_batches.push_back(order.size());
+		deferred->clear();
+		for (uint32_t link_index : *remaining) {
+			const uint32_t ia = links.n[link_index * 2];
+			const uint32_t ib = links.n[link_index * 2 + 1];
+			if (node_batch[ia] == batch || node_batch[ib] == batch) {
+				deferred->push_back(link_index);
+				continue;
 			}
-			link_dep = link_dep->next;
+			node_batch[ia] = batch;
+			node_batch[ib] = batch;
+			order.push_back(link_index);
 		}
-	}
-
-	// Delete the temporary buffers.
-	memdelete_arr(node_written_at);
-	memdelete_arr(link_dep_A);
-	memdelete_arr(link_dep_B);
-	memdelete_arr(ready_list);
-	memdelete_arr(link_dep_free_list);
-	memdelete_arr(link_dep_list_starts);
-	memdelete_arr(link_buffer);
+		SWAP(remaining, deferred);
+		batch++;
+	}
+	link_batches.push_back(order.size());
+
+	Links sorted;
+	sorted.n.resize(link_count * 2);
+	sorted.rl.resize(link_count);
+	sorted.c0.resize(link_count);
+	sorted.c1.resize(link_count);
+	for (uint32_t i = 0; i < link_count; ++i) {
+		const uint32_t link_index = order[i];
+		sorted.n[i * 2] = links.n[link_index * 2];
+		sorted.n[i * 2 + 1] = links.n[link_index * 2 + 1];
+		sorted.rl[i] = links.rl[link_index];
+		sorted.c0[i] = links.c0[link_index];
+		sorted.c1[i] = links.c1[link_index];
+	}
+	links = sorted;
 }
 
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -826,15 +770,11 @@ void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-
-	Link link;
-	link.n[0] = node1;
-	link.n[1] = node2;
-	link.rl = (node1->x - node2->x).length();
-
-	links.push_back(link);
+	links.n.push_back(p_node1);
+	links.n.push_back(p_node2);
+	links.rl.push_back((nodes.x[p_node1] - nodes.x[p_node2]).length());
+	links.c0.push_back(0.0);
+	links.c1.push_back(0.0);
 }
 
 void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3) {
@@ -848,18 +788,13 @@ void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-	Node *node3 = &nodes[p_node3];
-
-	Face face;
-	face.n[0] = node1;
-	face.n[1] = node2;
-	face.n[2] = node3;
-
-	face.index = faces.size();
-
-	faces.push_back(face);
+	faces.n.push_back(p_node1);
+	faces.n.push_back(p_node2);
+	faces.n.push_back(p_node3);
+	faces.centroid.push_back(Vector3());
+	faces.normal.push_back(Vector3());
+	faces.ra.push_back(0.0);
+	faces.leaf.push_back(DynamicBVH::ID());
 }
 
 void GodotSoftBody3D::set_iteration_count(int p_val) {
@@ -875,8 +810,7 @@ void GodotSoftBody3D::set_total_mass(real_t p_val) {
 
 	uint32_t node_count = nodes.size();
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
-		node.im *= mass_factor;
+		nodes.im[node_index] *= mass_factor;
 	}
 
 	update_constants();
@@ -903,14 +837,15 @@ void GodotSoftBody3D::set_drag_coefficient(real_t p_val) {
 }
 
 void GodotSoftBody3D::add_velocity(const Vector3 &p_velocity) {
-	for (Node &node : nodes) {
-		if (node.im > 0) {
-			node.v += p_velocity;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		if (nodes.im[node_index] > 0) {
+			nodes.v[node_index] += p_velocity;
 		}
 	}
 }
 
-void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_areas) {
+void GodotSoftBody3D::apply_forces(const FrameLocalVector<GodotArea3D *> &p_wind_areas) {
 	if (nodes.is_empty()) {
 		return;
 	}
@@ -918,24 +853,25 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	int32_t j;
 
 	real_t volume = 0.0;
-	const Vector3 &org = nodes[0].x;
+	const Vector3 &org = nodes.x[0];
 
 	// Iterate over faces (try not to iterate elsewhere if possible).
-	for (const Face &face : faces) {
+	const uint32_t face_count = faces.size();
+	for (uint32_t face_index = 0; face_index < face_count; ++face_index) {
+		const uint32_t *fn = &faces.n[face_index * 3];
 		Vector3 wind_force(0, 0, 0);
 
 		// Compute volume.
-		volume += vec3_dot(face.n[0]->x - org, vec3_cross(face.n[1]->x - org, face.n[2]->x - org));
+		volume += vec3_dot(nodes.x[fn[0]] - org, vec3_cross(nodes.x[fn[1]] - org, nodes.x[fn[2]] - org));
 
 		// Compute nodal forces from area winds.
 		if (!p_wind_areas.is_empty()) {
 			for (const GodotArea3D *area : p_wind_areas) {
-				wind_force += _compute_area_windforce(area, &face);
+				wind_force += _compute_area_windforce(area, face_index);
 			}
 
 			for (j = 0; j < 3; j++) {
-				Node *current_node = face.n[j];
-				current_node->f += wind_force;
+				nodes.f[fn[j]] += wind_force;
 			}
 		}
 	}
@@ -944,24 +880,26 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	// Apply nodal pressure forces.
 	if (pressure_coefficient > CMP_EPSILON) {
 		real_t ivolumetp = 1.0 / Math::abs(volume) * pressure_coefficient;
-		for (Node &node : nodes) {
-			if (node.im > 0) {
-				node.f += node.n * (node.area * ivolumetp);
+		const uint32_t node_count = nodes.size();
+		for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+			if (nodes.im[node_index] > 0) {
+				nodes.f[node_index] += nodes.n[node_index] * (nodes.area[node_index] * ivolumetp);
 			}
 		}
 	}
 }
 
-Vector3 GodotSoftBody3D::_compute_area_windforce(const GodotArea3D *p_area, const Face *p_face) {
+Vector3 GodotSoftBody3D::_compute_area_windforce(const GodotArea3D *p_area, uint32_t p_face_index) {
 	real_t wfm = p_area->get_wind_force_magnitude();
 	real_t waf = p_area->get_wind_attenuation_factor();
 	const Vector3 &wd = p_area->get_wind_direction();
 	const Vector3 &ws = p_area->get_wind_source();
-	real_t projection_on_tri_normal = vec3_dot(p_face->normal, wd);
-	real_t projection_toward_centroid = vec3_dot(p_face->centroid - ws, wd);
+	const Vector3 &normal = faces.normal[p_face_index];
+	real_t projection_on_tri_normal = vec3_dot(normal, wd);
+	real_t projection_toward_centroid = vec3_dot(faces.centroid[p_face_index] - ws, wd);
 	real_t attenuation_over_distance = pow(projection_toward_centroid, -waf);
-	real_t nodal_force_magnitude = wfm * 0.33333333333 * p_face->ra * projection_on_tri_normal * attenuation_over_distance;
-	return nodal_force_magnitude * p_face->normal;
+	real_t nodal_force_magnitude = wfm * 0.33333333333 * faces.ra[p_face_index] * projection_on_tri_normal * attenuation_over_distance;
+	return nodal_force_magnitude * normal;
 }
 
 void GodotSoftBody3D::predict_motion(real_t p_delta) {
@@ -972,7 +910,7 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	bool gravity_done = false;
 	Vector3 gravity;
 
-	LocalVector<GodotArea3D *> wind_areas;
+	FrameLocalVector<GodotArea3D *> wind_areas;
 
 	int ac = areas.size();
 	if (ac) {
@@ -1029,27 +967,33 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	real_t clamp_delta_v = max_displacement * inv_delta;
 
 	// Integrate.
-	for (Node &node : nodes) {
-		node.q = node.x;
-		Vector3 delta_v = node.f * node.im * p_delta;
+	const uint32_t node_count = nodes.size();
+	Vector3 *x = nodes.x.ptr();
+	Vector3 *q = nodes.q.ptr();
+	Vector3 *v = nodes.v.ptr();
+	Vector3 *f = nodes.f.ptr();
+	const real_t *im = nodes.im.ptr();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		q[node_index] = x[node_index];
+		Vector3 delta_v = f[node_index] * im[node_index] * p_delta;
 		for (int c = 0; c < 3; c++) {
 			delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
 		}
-		node.v += delta_v;
-		node.x += node.v * p_delta;
-		node.f = Vector3();
+		v[node_index] += delta_v;
+		x[node_index] += v[node_index] * p_delta;
+		f[node_index] = Vector3();
 	}
 
 	// Bounds and tree update.
 	update_bounds();
 
 	// Node tree update.
-	for (const Node &node : nodes) {
-		AABB node_aabb(node.x, Vector3());
-		node_aabb.expand_to(node.x + node.v * p_delta);
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		AABB node_aabb(x[node_index], Vector3());
+		node_aabb.expand_to(x[node_index] + v[node_index] * p_delta);
 		node_aabb.grow_by(collision_margin);
 
-		node_tree.update(node.leaf, node_aabb);
+		node_tree.update(nodes.leaf[node_index], node_aabb);
 	}
 
 	// Face tree update.
@@ -1062,48 +1006,78 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_parallel) {
 	const real_t inv_delta = 1.0 / p_delta;
 
-	for (Link &link : links) {
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
-	}
+	const uint32_t node_count = nodes.size();
+	Vector3 *x = nodes.x.ptr();
+	Vector3 *q = nodes.q.ptr();
+	Vector3 *v = nodes.v.ptr();
+	Vector3 *bv = nodes.bv.ptr();
 
 	// Solve velocities.
-	for (Node &node : nodes) {
-		node.x = node.q + node.v * p_delta;
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		x[node_index] = q[node_index] + v[node_index] * p_delta;
 	}
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
-		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		solve_links(1.0, p_parallel);
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (Node &node : nodes) {
-		node.x += node.bv * p_delta;
-		node.bv = Vector3();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		x[node_index] += bv[node_index] * p_delta;
+		bv[node_index] = Vector3();
 
-		node.v = (node.x - node.q) * vc;
+		v[node_index] = (x[node_index] - q[node_index]) * vc;
 
-		node.q = node.x;
+		q[node_index] = x[node_index];
 	}
 
 	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
+void GodotSoftBody3D::_solve_link_chunk(uint32_t p_chunk_index, const LinkBatch *p_batch) {
+	const uint32_t from = p_batch->from + p_chunk_index * SOFT_BODY_LINK_CHUNK_SIZE;
+	const uint32_t to = MIN(from + SOFT_BODY_LINK_CHUNK_SIZE, p_batch->to);
+	const real_t kst = p_batch->kst;
+
+	const uint32_t *link_nodes = links.n.ptr();
+	const real_t *c0 = links.c0.ptr();
+	const real_t *c1 = links.c1.ptr();
+	Vector3 *x = nodes.x.ptr();
+	const real_t *im = nodes.im.ptr();
+
+	for (uint32_t link_index = from; link_index < to; ++link_index) {
+		if (c0[link_index] > 0) {
+			const uint32_t a = link_nodes[link_index * 2];
+			const uint32_t b = link_nodes[link_index * 2 + 1];
+			const Vector3 del = x[b] - x[a];
 			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+			if (c1[link_index] + len > CMP_EPSILON) {
+				const real_t k = ((c1[link_index] - len) / (c0[link_index] * (c1[link_index] + len))) * kst;
+				x[a] -= del * (k * im[a]);
+				x[b] += del * (k * im[b]);
+			}
+		}
+	}
+}
+
+void GodotSoftBody3D::solve_links(real_t kst, bool p_parallel) {
+	const uint32_t batch_count = link_batches.is_empty() ? 0 : link_batches.size() - 1;
+	for (uint32_t batch_index = 0; batch_index < batch_count; ++batch_index) {
+		LinkBatch batch;
+		batch.from = link_batches[batch_index];
+		batch.to = link_batches[batch_index + 1];
+		batch.kst = kst;
+
+		const uint32_t chunk_count = (batch.to - batch.from + SOFT_BODY_LINK_CHUNK_SIZE - 1) / SOFT_BODY_LINK_CHUNK_SIZE;
+		if (p_parallel && chunk_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSoftBody3D::_solve_link_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DSoftBodyLinks"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+				_solve_link_chunk(chunk_index, &batch);
 			}
 		}
 	}
@@ -1153,38 +1127,39 @@ void GodotSoftBody3D::query_ray(const Vector3 &p_from, const Vector3 &p_to, Godo
 
 void GodotSoftBody3D::initialize_face_tree() {
 	face_tree.clear();
-	for (Face &face : faces) {
+	const uint32_t face_count = faces.size();
+	for (uint32_t face_index = 0; face_index < face_count; ++face_index) {
+		const uint32_t *fn = &faces.n[face_index * 3];
 		AABB face_aabb;
 
-		face_aabb.position = face.n[0]->x;
-		face_aabb.expand_to(face.n[1]->x);
-		face_aabb.expand_to(face.n[2]->x);
+		face_aabb.position = nodes.x[fn[0]];
+		face_aabb.expand_to(nodes.x[fn[1]]);
+		face_aabb.expand_to(nodes.x[fn[2]]);
 
 		face_aabb.grow_by(collision_margin);
 
-		face.leaf = face_tree.insert(face_aabb, &face);
+		faces.leaf[face_index] = face_tree.insert(face_aabb, (void *)(uintptr_t)face_index);
 	}
 }
 
 void GodotSoftBody3D::update_face_tree(real_t p_delta) {
-	for (const Face &face : faces) {
+	const uint32_t face_count = faces.size();
+	for (uint32_t face_index = 0; face_index < face_count; ++face_index) {
+		const uint32_t *fn = &faces.n[face_index * 3];
 		AABB face_aabb;
 
-		const Node *node0 = face.n[0];
-		face_aabb.position = node0->x;
-		face_aabb.expand_to(node0->x + node0->v * p_delta);
+		face_aabb.position = nodes.x[fn[0]];
+		face_aabb.expand_to(nodes.x[fn[0]] + nodes.v[fn[0]] * p_delta);
 
-		const Node *node1 = face.n[1];
-		face_aabb.expand_to(node1->x);
-		face_aabb.expand_to(node1->x + node1->v * p_delta);
+		face_aabb.expand_to(nodes.x[fn[1]]);
+		face_aabb.expand_to(nodes.x[fn[1]] + nodes.v[fn[1]] * p_delta);
 
-		const Node *node2 = face.n[2];
-		face_aabb.expand_to(node2->x);
-		face_aabb.expand_to(node2->x + node2->v * p_delta);
+		face_aabb.expand_to(nodes.x[fn[2]]);
+		face_aabb.expand_to(nodes.x[fn[2]] + nodes.v[fn[2]] * p_delta);
 
 		face_aabb.grow_by(collision_margin);
 
-		face_tree.update(face.leaf, face_aabb);
+		face_tree.update(faces.leaf[face_index], face_aabb);
 	}
 }
 
@@ -1217,6 +1192,7 @@ void GodotSoftBody3D::destroy() {
 	nodes.clear();
 	links.clear();
 	faces.clear();
+	link_batches.clear();
 
 	bounds = AABB();
 	deinitialize_shape();
@@ -37,6 +37,7 @@
 #include "core/math/aabb.h"
 #include "core/math/dynamic_bvh.h"
 #include "core/math/vector3.h"
+#include "core/os/frame_arena.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/vset.h"
@@ -46,41 +47,60 @@ class GodotConstraint3D;
 class GodotSoftBody3D : public GodotCollisionObject3D {
 	RID soft_mesh;
 
-	struct Node {
-		Vector3 s; // Source position
-		Vector3 x; // Position
-		Vector3 q; // Previous step position/Test position
-		Vector3 f; // Force accumulator
-		Vector3 v; // Velocity
-		Vector3 bv; // Biased Velocity
-		Vector3 n; // Normal
-		real_t area = 0.0; // Area
-		real_t im = 0.0; // 1/mass
-		DynamicBVH::ID leaf; // Leaf data
-		uint32_t index = 0;
+	// Nodes, links and faces are stored as structures of arrays indexed by node, link or face,
+	// so the solver loops only stream through the fields they use.
+	struct Nodes {
+		LocalVector<Vector3> s; // Source position
+		LocalVector<Vector3> x; // Position
+		LocalVector<Vector3> q; // Previous step position/Test position
+		LocalVector<Vector3> f; // Force accumulator
+		LocalVector<Vector3> v; // Velocity
+		LocalVector<Vector3> bv; // Biased Velocity
+		LocalVector<Vector3> n; // Normal
+		LocalVector<real_t> area; // Area
+		LocalVector<real_t> im; // 1/mass
+		LocalVector<DynamicBVH::ID> leaf; // Leaf data
+
+		_FORCE_INLINE_ uint32_t size() const { return x.size(); }
+		_FORCE_INLINE_ bool is_empty() const { return x.is_empty(); }
+		void resize(uint32_t p_size);
+		void clear();
 	};
 
-	struct Link {
-		Vector3 c3; // gradient
-		Node *n[2] = { nullptr, nullptr }; // Node pointers
-		real_t rl = 0.0; // Rest length
-		real_t c0 = 0.0; // (ima+imb)*kLST
-		real_t c1 = 0.0; // rl^2
-		real_t c2 = 0.0; // |gradient|^2/c0
+	struct Links {
+		LocalVector<uint32_t> n; // Node indices, two per link
+		LocalVector<real_t> rl; // Rest length
+		LocalVector<real_t> c0; // (ima+imb)*kLST
+		LocalVector<real_t> c1; // rl^2
+
+		_FORCE_INLINE_ uint32_t size() const { return rl.size(); }
+		void clear();
+	};
+
+	struct Faces {
+		LocalVector<uint32_t> n; // Node indices, three per face
+		LocalVector<Vector3> centroid;
+		LocalVector<Vector3> normal; // Normal
+		LocalVector<real_t> ra; // Rest area
+		LocalVector<DynamicBVH::ID> leaf; // Leaf data
+
+		_FORCE_INLINE_ uint32_t size() const { return ra.size(); }
+		void clear();
 	};
 
-	struct Face {
-		Vector3 centroid;
-		Node *n[3] = { nullptr, nullptr, nullptr }; // Node pointers
-		Vector3 normal; // Normal
-		real_t ra = 0.0; // Rest area
-		DynamicBVH::ID leaf; // Leaf data
-		uint32_t index = 0;
+	struct LinkBatch {
+		uint32_t from = 0;
+		uint32_t to = 0;
+		real_t kst = 0.0;
 	};
 
-	LocalVector<Node> nodes;
-	LocalVector<Link> links;
-	LocalVector<Face> faces;
+	Nodes nodes;
+	Links links;
+	Faces faces;
+
+	// Links are sorted by color, so that the links of a batch never share a node
+	// and can be solved in any order, or in parallel. Holds batch count + 1 offsets.
+	LocalVector<uint32_t> link_batches;
 
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
@@ -111,7 +131,9 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
-	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, const Face *p_face);
+	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, uint32_t p_face_index);
+
+	void _solve_link_chunk(uint32_t p_chunk_index, const LinkBatch *p_batch);
 
 public:
 	GodotSoftBody3D();
@@ -201,11 +223,15 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	_FORCE_INLINE_ uint32_t get_link_count() const { return links.size(); }
+
 	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	// With p_parallel, large link batches are split across the WorkerThreadPool.
+	// Results don't depend on it, since the links of a batch are independent.
+	void solve_constraints(real_t p_delta, bool p_parallel = false);
 
-	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
-	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
+	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return (uint32_t)(uintptr_t)p_node; }
+	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return (uint32_t)(uintptr_t)p_face; }
 
 	// Return true to stop the query.
 	// p_index is the node index for AABB query, face index for Ray query.
@@ -229,15 +255,15 @@ private:
 
 	void add_velocity(const Vector3 &p_velocity);
 
-	void apply_forces(const LocalVector<GodotArea3D *> &p_wind_areas);
+	void apply_forces(const FrameLocalVector<GodotArea3D *> &p_wind_areas);
 
 	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
-	void reoptimize_link_order();
+	void generate_link_batches();
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
-	void solve_links(real_t kst, real_t ti);
+	void solve_links(real_t kst, bool p_parallel);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
@@ -105,46 +105,52 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
+_FORCE_INLINE_ static bool _can_ray_query(GodotCollisionObject3D *p_object, const PhysicsDirectSpaceState3D::RayParameters &p_parameters) {
+	if (!_can_collide_with(p_object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		return false;
+	}
 
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
+	if (p_parameters.pick_ray && !p_object->is_ray_pickable()) {
+		return false;
+	}
+
+	if (p_parameters.exclude.has(p_object->get_self())) {
+		return false;
+	}
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	return true;
+}
+
+// Orders the shapes a ray hits at the same distance, so the result doesn't depend on the order they were culled in.
+static _FORCE_INLINE_ bool _is_ray_tie_preferred(const GodotCollisionObject3D *p_object, int p_shape, const GodotCollisionObject3D *p_other_object, int p_other_shape) {
+	if (p_object->get_self() != p_other_object->get_self()) {
+		return p_object->get_self() < p_other_object->get_self();
+	}
+	return p_shape < p_other_shape;
+}
+
+// Finds the closest hit along the segment among shapes that already passed the ray query filters.
+static bool _intersect_ray_shapes(const Vector3 &p_begin, const Vector3 &p_end, bool p_hit_from_inside, bool p_hit_back_faces, GodotCollisionObject3D *const *p_objects, const int *p_shapes, int p_amount, PhysicsDirectSpaceState3D::RayResult &r_result) {
+	Vector3 normal = (p_end - p_begin).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
+	bool inside = false;
 	Vector3 res_point, res_normal;
 	int res_face_index = -1;
 	int res_shape = -1;
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
-			continue;
-		}
-
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue;
-		}
-
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_shapes[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
-		Vector3 local_from = inv_xform.xform(begin);
-		Vector3 local_to = inv_xform.xform(end);
+		Vector3 local_from = inv_xform.xform(p_begin);
+		Vector3 local_to = inv_xform.xform(p_end);
 
 		const GodotShape3D *shape = col_obj->get_shape(shape_idx);
 
@@ -152,28 +158,33 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 		int shape_face_index = -1;
 
 		if (shape->intersect_point(local_from)) {
-			if (p_parameters.hit_from_inside) {
+			if (p_hit_from_inside && (!inside || _is_ray_tie_preferred(col_obj, shape_idx, res_obj, res_shape))) {
 				// Hit shape at starting point.
 				min_d = 0;
-				res_point = begin;
+				res_point = p_begin;
 				res_normal = Vector3();
+				res_face_index = -1;
 				res_shape = shape_idx;
 				res_obj = col_obj;
 				collided = true;
-				break;
-			} else {
-				// Ignore shape when starting inside.
-				continue;
+				inside = true;
 			}
+			// Otherwise, ignore shape when starting inside.
+			continue;
 		}
 
-		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, p_parameters.hit_back_faces)) {
+		if (inside) {
+			// Already hit a shape at the starting point, only other shapes containing it matter.
+			continue;
+		}
+
+		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, p_hit_back_faces)) {
 			Transform3D xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 			shape_point = xform.xform(shape_point);
 
 			real_t ld = normal.dot(shape_point);
 
-			if (ld < min_d) {
+			if (ld < min_d || (ld == min_d && collided && _is_ray_tie_preferred(col_obj, shape_idx, res_obj, res_shape))) {
 				min_d = ld;
 				res_point = shape_point;
 				res_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
@@ -205,6 +216,118 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::_cast_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result) {
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	// Compact the candidates in place, keeping only those that pass the query filters.
+	int candidates = 0;
+	for (int i = 0; i < amount; i++) {
+		if (!_can_ray_query(space->intersection_query_results[i], p_parameters)) {
+			continue;
+		}
+		space->intersection_query_results[candidates] = space->intersection_query_results[i];
+		space->intersection_query_subindex_results[candidates] = space->intersection_query_subindex_results[i];
+		candidates++;
+	}
+
+	return _intersect_ray_shapes(p_from, p_to, p_parameters.hit_from_inside, p_parameters.hit_back_faces, space->intersection_query_results, space->intersection_query_subindex_results, candidates, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	return _cast_ray(p_parameters, p_parameters.from, p_parameters.to, r_result);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_ray_count <= 0) {
+		return 0;
+	}
+	ERR_FAIL_NULL_V(p_from, 0);
+	ERR_FAIL_NULL_V(p_to, 0);
+	ERR_FAIL_NULL_V(r_results, 0);
+	ERR_FAIL_NULL_V(r_hits, 0);
+
+	// Per-ray candidate lists, filled from the packet candidates that overlap each segment.
+	GodotCollisionObject3D **ray_objects = (GodotCollisionObject3D **)alloca(sizeof(GodotCollisionObject3D *) * GodotSpace3D::INTERSECTION_QUERY_MAX);
+	int *ray_shapes = (int *)alloca(sizeof(int) * GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	int hit_count = 0;
+
+	for (int packet_begin = 0; packet_begin < p_ray_count; packet_begin += RAY_PACKET_SIZE) {
+		int packet_end = MIN(packet_begin + RAY_PACKET_SIZE, p_ray_count);
+
+		AABB ray_aabbs[RAY_PACKET_SIZE];
+		AABB packet_aabb(p_from[packet_begin], Vector3());
+		real_t ray_size_max = 0.0;
+		for (int i = packet_begin; i < packet_end; i++) {
+			AABB &ray_aabb = ray_aabbs[i - packet_begin];
+			ray_aabb = AABB(p_from[i], Vector3());
+			ray_aabb.expand_to(p_to[i]);
+			packet_aabb.merge_with(ray_aabb);
+			ray_size_max = MAX(ray_size_max, ray_aabb.get_longest_axis_size());
+		}
+
+		// Compare the volumes with some margin, so rays along an axis or in a plane still have one.
+		const real_t margin = ray_size_max * 0.25;
+		real_t rays_volume = 0.0;
+		for (int i = 0; i < packet_end - packet_begin; i++) {
+			rays_volume += ray_aabbs[i].grow(margin).get_volume();
+		}
+		const bool scattered = packet_aabb.grow(margin).get_volume() > RAY_PACKET_MAX_SPREAD * rays_volume;
+
+		int amount = 0;
+		if (!scattered) {
+			amount = space->broadphase->cull_aabb(packet_aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		}
+
+		if (scattered || amount >= GodotSpace3D::INTERSECTION_QUERY_MAX) {
+			// The packet bounds are mostly empty space between the rays, or too crowded to be culled at once,
+			// query each ray separately so no candidate is dropped or tested against rays far from it.
+			for (int i = packet_begin; i < packet_end; i++) {
+				r_hits[i] = _cast_ray(p_parameters, p_from[i], p_to[i], r_results[i]);
+				if (r_hits[i]) {
+					hit_count++;
+				}
+			}
+			continue;
+		}
+
+		int candidates = 0;
+		for (int i = 0; i < amount; i++) {
+			if (!_can_ray_query(space->intersection_query_results[i], p_parameters)) {
+				continue;
+			}
+			space->intersection_query_results[candidates] = space->intersection_query_results[i];
+			space->intersection_query_subindex_results[candidates] = space->intersection_query_subindex_results[i];
+			candidates++;
+		}
+
+		for (int i = packet_begin; i < packet_end; i++) {
+			// Same rejection the broadphase does for a single segment, against the cached shape bounds.
+			int ray_amount = 0;
+			for (int j = 0; j < candidates; j++) {
+				GodotCollisionObject3D *col_obj = space->intersection_query_results[j];
+				int shape_idx = space->intersection_query_subindex_results[j];
+				if (!col_obj->get_shape_aabb(shape_idx).intersects_segment(p_from[i], p_to[i])) {
+					continue;
+				}
+				ray_objects[ray_amount] = col_obj;
+				ray_shapes[ray_amount] = shape_idx;
+				ray_amount++;
+			}
+
+			r_hits[i] = _intersect_ray_shapes(p_from[i], p_to[i], p_parameters.hit_from_inside, p_parameters.hit_back_faces, ray_objects, ray_shapes, ray_amount, r_results[i]);
+			if (r_hits[i]) {
+				hit_count++;
+			}
+		}
+	}
+
+	return hit_count;
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1266,6 +1389,7 @@ GodotSpace3D::GodotSpace3D() {
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
+	broadphase->set_threaded(GLOBAL_GET("physics/3d/solver/threaded_broadphase"));
 
 	direct_access = memnew(GodotPhysicsDirectSpaceState3D);
 	direct_access->space = this;
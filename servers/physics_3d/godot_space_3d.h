@@ -46,11 +46,19 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// Rays batched by intersect_rays() share one broadphase cull per packet of this size.
+	static constexpr int RAY_PACKET_SIZE = 16;
+	// Packets whose bounds are this many times larger than the bounds of their rays are queried one ray at a time.
+	static constexpr real_t RAY_PACKET_MAX_SPREAD = 4.0;
+
+	bool _cast_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -125,6 +133,7 @@ private:
 	int contact_debug_count = 0;
 
 	friend class GodotPhysicsDirectSpaceState3D;
+	friend class GodotStep3D;
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
 
@@ -30,6 +30,7 @@
 
 #include "godot_step_3d.h"
 
+#include "godot_collision_solver_3d.h"
 #include "godot_joint_3d.h"
 
 #include "core/object/worker_thread_pool.h"
@@ -40,6 +41,14 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define CONSTRAINT_SETUP_BATCH_SIZE 16
+#define SOFT_BODY_COUNT_RESERVE 16
+#define SOFT_BODY_PARALLEL_LINK_COUNT 8192
+#define CCD_BODY_COUNT_RESERVE 64
+#define CCD_CANDIDATE_COUNT_RESERVE 512
+// Shapes moving less than this fraction of their own size along the motion can't tunnel.
+#define CCD_MIN_MOTION_RATIO 0.3
+#define CCD_BISECTION_STEPS 8
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,9 +121,14 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
-	constraint->setup(delta);
+void GodotStep3D::_setup_constraint_batch(uint32_t p_batch_index, void *p_userdata) {
+	// Constraints are processed in small batches, so that threads don't contend
+	// on the group index for every single pair while still balancing the load.
+	uint32_t from = p_batch_index * CONSTRAINT_SETUP_BATCH_SIZE;
+	uint32_t to = MIN(from + CONSTRAINT_SETUP_BATCH_SIZE, all_constraints.size());
+	for (uint32_t constraint_index = from; constraint_index < to; ++constraint_index) {
+		all_constraints[constraint_index]->setup(delta);
+	}
 }
 
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
@@ -182,6 +196,166 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 	}
 }
 
+// Returns the fraction of p_motion at which the shapes first overlap, or 1.0 if they don't collide along the
+// whole motion. Shapes that already overlap are skipped too, their contacts are handled by the solver.
+static real_t _ccd_time_of_impact(GodotShape3D *p_shape, const Transform3D &p_xform, const Vector3 &p_motion, const GodotShape3D *p_other_shape, const Transform3D &p_other_xform) {
+	if (p_motion.is_zero_approx()) {
+		return 1.0;
+	}
+
+	AABB aabb = p_xform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size));
+
+	Transform3D xform_inv = p_xform.affine_inverse();
+	GodotMotionShape3D mshape;
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
+
+	Vector3 motion_normal = p_motion.normalized();
+	Vector3 point_A, point_B;
+
+	Vector3 sep_axis = motion_normal;
+	if (GodotCollisionSolver3D::solve_distance(&mshape, p_xform, p_other_shape, p_other_xform, point_A, point_B, aabb, &sep_axis)) {
+		return 1.0; // No collision along the whole motion.
+	}
+
+	sep_axis = motion_normal;
+	if (!GodotCollisionSolver3D::solve_distance(p_shape, p_xform, p_other_shape, p_other_xform, point_A, point_B, aabb, &sep_axis)) {
+		return 1.0; // Already overlapping.
+	}
+
+	// Same conservative bisection as cast_motion(), converging faster towards the side that keeps being hit.
+	real_t low = 0.0;
+	real_t hi = 1.0;
+	real_t fraction_coeff = 0.5;
+	for (int i = 0; i < CCD_BISECTION_STEPS; i++) {
+		real_t fraction = low + (hi - low) * fraction_coeff;
+
+		mshape.motion = xform_inv.basis.xform(p_motion * fraction);
+
+		Vector3 sep = motion_normal;
+		bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_xform, p_other_shape, p_other_xform, point_A, point_B, aabb, &sep);
+
+		if (collided) {
+			hi = fraction;
+			fraction_coeff = ((i == 0) || (low > 0.0)) ? 0.5 : 0.25;
+		} else {
+			low = fraction;
+			fraction_coeff = ((i == 0) || (hi < 1.0)) ? 0.5 : 0.75;
+		}
+	}
+
+	return hi;
+}
+
+void GodotStep3D::_gather_ccd_body(GodotSpace3D *p_space, GodotBody3D *p_body) {
+	Vector3 motion = p_body->get_linear_velocity() * delta;
+	real_t motion_length = motion.length();
+	if (motion_length < CMP_EPSILON) {
+		return;
+	}
+	Vector3 motion_normal = motion / motion_length;
+
+	const Transform3D &body_transform = p_body->get_transform();
+
+	bool fast = false;
+	bool first_shape = true;
+	AABB body_aabb;
+	for (int i = 0; i < p_body->get_shape_count(); i++) {
+		if (p_body->is_shape_disabled(i)) {
+			continue;
+		}
+
+		const GodotShape3D *shape = p_body->get_shape(i);
+		Transform3D shape_xform = body_transform * p_body->get_shape_transform(i);
+
+		real_t min = 0.0, max = 0.0;
+		shape->project_range(motion_normal, shape_xform, min, max);
+		if (motion_length > (max - min) * CCD_MIN_MOTION_RATIO) {
+			fast = true;
+		}
+
+		AABB shape_aabb = shape_xform.xform(shape->get_aabb());
+		if (first_shape) {
+			body_aabb = shape_aabb;
+			first_shape = false;
+		} else {
+			body_aabb.merge_with(shape_aabb);
+		}
+	}
+
+	if (!fast) {
+		return;
+	}
+
+	AABB swept_aabb = body_aabb.merge(AABB(body_aabb.position + motion, body_aabb.size));
+	int amount = p_space->_cull_aabb_for_body(p_body, swept_aabb);
+	if (amount == 0) {
+		return;
+	}
+
+	CCDBody ccd_body;
+	ccd_body.body = p_body;
+	ccd_body.motion = motion;
+	ccd_body.candidate_from = ccd_candidates.size();
+	ccd_body.candidate_count = amount;
+
+	for (int i = 0; i < amount; i++) {
+		CCDCandidate candidate;
+		candidate.body = static_cast<const GodotBody3D *>(p_space->intersection_query_results[i]);
+		candidate.shape = p_space->intersection_query_subindex_results[i];
+		ccd_candidates.push_back(candidate);
+	}
+
+	ccd_bodies.push_back(ccd_body);
+}
+
+void GodotStep3D::_sweep_ccd_body(uint32_t p_ccd_body_index, void *p_userdata) {
+	CCDBody &ccd_body = ccd_bodies[p_ccd_body_index];
+	const GodotBody3D *body = ccd_body.body;
+	const Transform3D &body_transform = body->get_transform();
+
+	real_t motion_length = ccd_body.motion.length();
+	Vector3 motion_normal = ccd_body.motion / motion_length;
+
+	real_t best_fraction = 1.0;
+
+	for (int i = 0; i < body->get_shape_count(); i++) {
+		if (body->is_shape_disabled(i)) {
+			continue;
+		}
+
+		GodotShape3D *shape = body->get_shape(i);
+		Transform3D shape_xform = body_transform * body->get_shape_transform(i);
+
+		real_t min = 0.0, max = 0.0;
+		shape->project_range(motion_normal, shape_xform, min, max);
+		if (motion_length <= (max - min) * CCD_MIN_MOTION_RATIO) {
+			continue; // Slow enough to be caught by regular contacts.
+		}
+
+		for (uint32_t candidate_index = 0; candidate_index < ccd_body.candidate_count; ++candidate_index) {
+			const CCDCandidate &candidate = ccd_candidates[ccd_body.candidate_from + candidate_index];
+			const GodotShape3D *other_shape = candidate.body->get_shape(candidate.shape);
+			Transform3D other_xform = candidate.body->get_transform() * candidate.body->get_shape_transform(candidate.shape);
+
+			// Sweep relative to the other body, which is assumed to move linearly during the step.
+			Vector3 motion = ccd_body.motion - candidate.body->get_linear_velocity() * delta;
+
+			real_t fraction = _ccd_time_of_impact(shape, shape_xform, motion, other_shape, other_xform);
+			if (fraction < best_fraction) {
+				best_fraction = fraction;
+			}
+		}
+	}
+
+	ccd_body.impact_fraction = best_fraction;
+}
+
+void GodotStep3D::_solve_soft_body(uint32_t p_soft_body_index, void *p_userdata) {
+	soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -344,7 +518,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	uint32_t constraint_batch_count = (total_constraint_count + CONSTRAINT_SETUP_BATCH_SIZE - 1) / CONSTRAINT_SETUP_BATCH_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint_batch, nullptr, constraint_batch_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -373,6 +548,35 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	/* CONTINUOUS COLLISION DETECTION */
+
+	// Gathering culls the broadphase with the space's query buffers, so it's done serially.
+	b = body_list->first();
+	while (b) {
+		GodotBody3D *body = b->self();
+		if (body->is_continuous_collision_detection_enabled() && body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			_gather_ccd_body(p_space, body);
+		}
+		b = b->next();
+	}
+
+	if (!ccd_bodies.is_empty()) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_sweep_ccd_body, nullptr, ccd_bodies.size(), -1, true, SNAME("Physics3DContinuousCollision"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Velocities are only changed once all sweeps are done, since they read the velocities of other bodies.
+		for (const CCDBody &ccd_body : ccd_bodies) {
+			if (ccd_body.impact_fraction < 1.0) {
+				// Only move up to the first impact, so the contact is found and solved on the next step instead of tunneling.
+				// Warning: like any velocity clamping, this makes the momentum weaker than it should be for a bounce.
+				ccd_body.body->set_linear_velocity(ccd_body.body->get_linear_velocity() * ccd_body.impact_fraction);
+			}
+		}
+
+		ccd_bodies.clear();
+		ccd_candidates.clear();
+	}
+
 	/* INTEGRATE VELOCITIES */
 
 	b = body_list->first();
@@ -390,12 +594,28 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
+	// Large soft bodies spread their own link batches across threads, one body at a time.
+	// The others are solved in parallel with each other, each on a single thread.
 	sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->solve_constraints(p_delta);
+		GodotSoftBody3D *soft_body = sb->self();
+		if (soft_body->get_link_count() >= SOFT_BODY_PARALLEL_LINK_COUNT) {
+			soft_body->solve_constraints(p_delta, true);
+		} else {
+			soft_bodies.push_back(soft_body);
+		}
 		sb = sb->next();
 	}
 
+	if (soft_bodies.size() > 1) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body, nullptr, soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodySolve"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (soft_bodies.size() == 1) {
+		_solve_soft_body(0);
+	}
+
+	soft_bodies.clear();
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
@@ -412,6 +632,9 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	ccd_bodies.reserve(CCD_BODY_COUNT_RESERVE);
+	ccd_candidates.reserve(CCD_CANDIDATE_COUNT_RESERVE);
+	soft_bodies.reserve(SOFT_BODY_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -45,12 +45,35 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	struct CCDCandidate {
+		const GodotBody3D *body = nullptr;
+		int shape = 0;
+	};
+
+	struct CCDBody {
+		GodotBody3D *body = nullptr;
+		Vector3 motion;
+		uint32_t candidate_from = 0;
+		uint32_t candidate_count = 0;
+		real_t impact_fraction = 1.0;
+	};
+
+	// Fast bodies with continuous collision detection, swept against the shapes their motion overlaps.
+	LocalVector<CCDBody> ccd_bodies;
+	LocalVector<CCDCandidate> ccd_candidates;
+
+	// Soft bodies small enough to be solved on a single thread each.
+	LocalVector<GodotSoftBody3D *> soft_bodies;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _setup_constraint_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _gather_ccd_body(GodotSpace3D *p_space, GodotBody3D *p_body);
+	void _sweep_ccd_body(uint32_t p_ccd_body_index, void *p_userdata = nullptr);
+	void _solve_soft_body(uint32_t p_soft_body_index, void *p_userdata = nullptr);
 
 public:
 	void step(GodotSpace3D *p_space, real_t p_delta);
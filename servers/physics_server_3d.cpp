@@ -377,6 +377,62 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	int ray_count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(ray_count);
+	Vector<uint8_t> hits;
+	hits.resize(ray_count);
+
+	int hit_count = intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), ray_count, results.ptrw(), (bool *)hits.ptrw());
+
+	PackedInt32Array ray_index;
+	ray_index.resize(hit_count);
+	PackedVector3Array position;
+	position.resize(hit_count);
+	PackedVector3Array normal;
+	normal.resize(hit_count);
+	PackedInt64Array collider_id;
+	collider_id.resize(hit_count);
+	Array rid;
+	rid.resize(hit_count);
+	PackedInt32Array shape;
+	shape.resize(hit_count);
+	PackedInt32Array face_index;
+	face_index.resize(hit_count);
+
+	int hit = 0;
+	for (int i = 0; i < ray_count && hit < hit_count; i++) {
+		if (!hits[i]) {
+			continue;
+		}
+		const RayResult &result = results[i];
+		ray_index.write[hit] = i;
+		position.write[hit] = result.position;
+		normal.write[hit] = result.normal;
+		collider_id.write[hit] = (int64_t)result.collider_id;
+		rid[hit] = result.rid;
+		shape.write[hit] = result.shape;
+		face_index.write[hit] = result.face_index;
+		hit++;
+	}
+
+	Dictionary d;
+	d["ray_index"] = ray_index;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["rid"] = rid;
+	d["shape"] = shape;
+	d["face_index"] = face_index;
+
+	return d;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
 	ERR_FAIL_COND_V(p_point_query.is_null(), TypedArray<Dictionary>());
 
@@ -476,12 +532,27 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+int PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -1135,6 +1206,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/threaded_broadphase", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
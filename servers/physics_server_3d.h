@@ -124,6 +124,7 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters3D> &p_ray_query);
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
@@ -160,6 +161,8 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Casts p_ray_count rays sharing the filters in p_parameters (its from/to are ignored). Fills r_hits[i] and, on a hit, r_results[i]; returns the number of hits.
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits);
 
 	struct ShapeResult {
 		RID rid;
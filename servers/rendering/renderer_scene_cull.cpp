@@ -2315,6 +2315,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 	bool animated_material_found = false;
 
+	// Casters of each shadow pass, reused by the passes of this light.
+	FrameLocalVector<Instance *> instance_shadow_cull_result;
+
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
@@ -2346,7 +2349,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
 
 					struct CullConvex {
-						PagedArray<Instance *> *result;
+						FrameLocalVector<Instance *> *result;
 						_FORCE_INLINE_ bool operator()(void *p_data) {
 							Instance *p_instance = (Instance *)p_data;
 							result->push_back(p_instance);
@@ -2428,7 +2431,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
 
 					struct CullConvex {
-						PagedArray<Instance *> *result;
+						FrameLocalVector<Instance *> *result;
 						_FORCE_INLINE_ bool operator()(void *p_data) {
 							Instance *p_instance = (Instance *)p_data;
 							result->push_back(p_instance);
@@ -2495,7 +2498,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
 
 			struct CullConvex {
-				PagedArray<Instance *> *result;
+				FrameLocalVector<Instance *> *result;
 				_FORCE_INLINE_ bool operator()(void *p_data) {
 					Instance *p_instance = (Instance *)p_data;
 					result->push_back(p_instance);
@@ -3084,7 +3087,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	{
 		cull.shadow_count = 0;
 
-		Vector<Instance *> lights_with_shadow;
+		FrameLocalVector<Instance *> lights_with_shadow;
 
 		for (Instance *E : scenario->directional_lights) {
 			if (!E->visible) {
@@ -3110,7 +3113,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 		RSG::light_storage->set_directional_shadow_count(lights_with_shadow.size());
 
-		for (int i = 0; i < lights_with_shadow.size(); i++) {
+		for (uint32_t i = 0; i < lights_with_shadow.size(); i++) {
 			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect);
 		}
 	}
@@ -4243,7 +4246,6 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4274,7 +4276,6 @@ RendererSceneCull::RendererSceneCull() {
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
@@ -32,6 +32,7 @@
 #define RENDERER_SCENE_CULL_H
 
 #include "core/math/dynamic_bvh.h"
+#include "core/os/frame_arena.h"
 #include "core/templates/bin_sorted_array.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
@@ -879,7 +880,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -138,7 +138,7 @@ public:
 	bool prepare_regular_light(const RendererSceneCull::Instance &p_instance) { return _prepare_light(p_instance, -1); }
 
 	// Cull according to the regular light planes that were setup in the previous call to prepare_regular_light.
-	void cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result);
+	void cull_regular_light(FrameLocalVector<RendererSceneCull::Instance *> &r_instance_shadow_cull_result);
 
 	// Directional lights are prepared in advance, and can be culled multithreaded chopping and changing between
 	// different directional_light_id.
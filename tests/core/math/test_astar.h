@@ -32,6 +32,9 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 
 #include "tests/test_macros.h"
 
@@ -213,6 +216,96 @@ TEST_CASE("[AStar3D] Add/Remove") {
 	// It's been great work, cheers. \(^ ^)/
 }
 
+TEST_CASE("[AStar3D] Closest point and segment") {
+	// Random tests against a linear search, with sparse ids and moved, disabled and removed points.
+	const int N = 200;
+	Math::seed(0);
+
+	AStar3D a;
+	int64_t ids[N];
+	Vector3 p[N];
+	bool enabled[N];
+	bool present[N];
+	for (int u = 0; u < N; u++) {
+		ids[u] = u % 4 == 0 ? 1000000 + u * 1000 : u;
+		p[u] = Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100);
+		enabled[u] = true;
+		present[u] = true;
+		a.add_point(ids[u], p[u]);
+	}
+	for (int u = 1; u < N; u++) {
+		a.connect_points(ids[u - 1], ids[u], u % 3 != 0);
+	}
+
+	for (int i = 0; i < 2000; i++) {
+		const int u = Math::rand() % N;
+		switch (Math::rand() % 4) {
+			case 0:
+				p[u] = Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100);
+				if (present[u]) {
+					a.set_point_position(ids[u], p[u]);
+				}
+				break;
+			case 1:
+				if (present[u]) {
+					enabled[u] = !enabled[u];
+					a.set_point_disabled(ids[u], !enabled[u]);
+				}
+				break;
+			case 2:
+				if (present[u] && i % 8 == 0) {
+					a.remove_point(ids[u]);
+					present[u] = false;
+				}
+				break;
+		}
+
+		const Vector3 query(Math::rand() % 120 - 10, Math::rand() % 120 - 10, Math::rand() % 120 - 10);
+		for (int include_disabled = 0; include_disabled < 2; include_disabled++) {
+			int64_t closest_id = -1;
+			real_t closest_dist = 1e20;
+			for (int v = 0; v < N; v++) {
+				if (!present[v] || (!include_disabled && !enabled[v])) {
+					continue;
+				}
+				const real_t d = query.distance_squared_to(p[v]);
+				if (d < closest_dist || (d == closest_dist && ids[v] < closest_id)) {
+					closest_dist = d;
+					closest_id = ids[v];
+				}
+			}
+			CHECK(a.get_closest_point(query, include_disabled) == closest_id);
+		}
+
+		real_t closest_dist = 1e20;
+		for (int v = 1; v < N; v++) {
+			if (!present[v - 1] || !present[v] || !enabled[v - 1] || !enabled[v]) {
+				continue;
+			}
+			Vector3 segment[2] = { p[v - 1], p[v] };
+			closest_dist = MIN(closest_dist, query.distance_squared_to(Geometry3D::get_closest_point_to_segment(query, segment)));
+		}
+		if (closest_dist < 1e20) {
+			CHECK(query.distance_squared_to(a.get_closest_position_in_segment(query)) == doctest::Approx(closest_dist));
+		}
+	}
+
+	a.clear();
+	CHECK(a.get_closest_point(Vector3()) == -1);
+	a.add_point(5, Vector3(1, 2, 3));
+	CHECK(a.get_closest_point(Vector3(100, 100, 100)) == 5);
+	// Non-finite positions fall back to checking everything instead of growing the search forever.
+	CHECK(a.get_closest_point(Vector3(NAN, 0, 0)) == -1);
+	CHECK(a.get_closest_point(Vector3(INFINITY, 0, 0)) == -1);
+	a.add_point(6, Vector3(4, 2, 3));
+	a.connect_points(5, 6);
+	CHECK(a.get_closest_position_in_segment(Vector3(NAN, 0, 0)) == Vector3());
+	CHECK(a.get_closest_position_in_segment(Vector3(0, -INFINITY, 0)) == Vector3());
+	a.add_point(7, Vector3(INFINITY, 0, 0));
+	CHECK(a.get_closest_point(Vector3(100, 100, 100)) == 6);
+	CHECK(a.get_closest_position_in_segment(Vector3(2, 5, 3)) == Vector3(2, 2, 3));
+}
+
 TEST_CASE("[Stress][AStar3D] Find paths") {
 	// Random stress tests with Floyd-Warshall.
 	const int N = 30;
@@ -357,6 +450,64 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+struct GridPathQueries {
+	AStarGrid2D *grid = nullptr;
+	LocalVector<Vector2i> from;
+	LocalVector<Vector2i> to;
+
+	void solve(uint32_t p_index, LocalVector<Vector<Vector2>> *r_paths) {
+		const uint32_t query = p_index % from.size();
+		(*r_paths)[p_index] = grid->get_point_path(from[query], to[query], query % 2 == 0);
+	}
+};
+
+TEST_CASE("[Stress][AStarGrid2D] Concurrent path queries") {
+	Math::seed(0);
+
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(-64, -32, 256, 192));
+	grid->update();
+	for (int i = 0; i < 400; i++) {
+		grid->fill_solid_region(Rect2i(Math::rand() % 256 - 64, Math::rand() % 192 - 32, Math::rand() % 12 + 1, Math::rand() % 12 + 1));
+	}
+	for (int i = 0; i < 100; i++) {
+		grid->fill_weight_scale_region(Rect2i(Math::rand() % 256 - 64, Math::rand() % 192 - 32, Math::rand() % 20 + 1, Math::rand() % 20 + 1), 1 + Math::rand() % 4);
+	}
+
+	GridPathQueries queries;
+	queries.grid = grid.ptr();
+	for (int i = 0; i < 64; i++) {
+		queries.from.push_back(Vector2i(Math::rand() % 256 - 64, Math::rand() % 192 - 32));
+		queries.to.push_back(Vector2i(Math::rand() % 256 - 64, Math::rand() % 192 - 32));
+	}
+
+	for (int jumping = 0; jumping < 2; jumping++) {
+		grid->set_jumping_enabled(jumping);
+
+		LocalVector<Vector<Vector2>> serial_paths;
+		serial_paths.resize(queries.from.size());
+		for (uint32_t i = 0; i < queries.from.size(); i++) {
+			queries.solve(i, &serial_paths);
+		}
+
+		// Every query runs several times, so the same grid is always searched by multiple threads.
+		LocalVector<Vector<Vector2>> concurrent_paths;
+		concurrent_paths.resize(queries.from.size() * 8);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&queries, &GridPathQueries::solve, &concurrent_paths, concurrent_paths.size(), -1, true, SNAME("AStarGrid2DPathQueries"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		bool match = true;
+		for (uint32_t i = 0; i < concurrent_paths.size(); i++) {
+			if (concurrent_paths[i] != serial_paths[i % serial_paths.size()]) {
+				match = false;
+				break;
+			}
+		}
+		CHECK_MESSAGE(match, "Concurrent path queries should return the same paths as serial ones.");
+	}
+}
+
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/os/frame_arena.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Last allocation is resized and released in place") {
+	uint8_t *first = (uint8_t *)FrameArena::alloc(100);
+	uint8_t *second = (uint8_t *)FrameArena::alloc(100);
+	CHECK((uintptr_t)first % alignof(max_align_t) == 0);
+	CHECK((uintptr_t)second % alignof(max_align_t) == 0);
+	CHECK(second > first);
+
+	memset(second, 7, 100);
+	CHECK_MESSAGE(FrameArena::realloc(second, 1000) == second, "Growing the last allocation should not move it.");
+	CHECK(second[99] == 7);
+
+	FrameArena::free(second);
+	uint8_t *third = (uint8_t *)FrameArena::alloc(16);
+	CHECK_MESSAGE(third == second, "Freeing the last allocation should give its space back.");
+
+	// Not the last one anymore, so growing copies.
+	memset(first, 3, 100);
+	uint8_t *moved = (uint8_t *)FrameArena::realloc(first, 200);
+	CHECK(moved != first);
+	CHECK(moved[0] == 3);
+	CHECK(moved[99] == 3);
+
+	FrameArena::free(third);
+	FrameArena::free(moved);
+
+	// Everything was released, so the arena starts over.
+	uint8_t *rewound = (uint8_t *)FrameArena::alloc(8);
+	CHECK(rewound == first);
+	FrameArena::free(rewound);
+}
+
+TEST_CASE("[FrameArena] Containers") {
+	FrameLocalVector<int> vector;
+	FrameHashMap<int, int> map;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+		map[i % 1000] = i;
+	}
+
+	bool vector_valid = true;
+	for (int i = 0; i < 10000; i++) {
+		vector_valid &= vector[i] == i;
+	}
+	CHECK(vector_valid);
+
+	CHECK(map.size() == 1000);
+	bool map_valid = true;
+	for (int i = 0; i < 1000; i++) {
+		map_valid &= map.has(i) && map[i] == 9000 + i;
+	}
+	CHECK(map_valid);
+
+	map.erase(5);
+	CHECK_FALSE(map.has(5));
+	vector.reset();
+	map.clear();
+}
+
+static void use_frame_arena(uint32_t p_bytes) {
+	FrameLocalVector<uint8_t> buffer;
+	buffer.resize(p_bytes);
+}
+
+TEST_CASE("[FrameArena] Chunks follow the peak usage of the previous frame") {
+	FrameArena::begin_frame();
+	use_frame_arena(4 * 1024 * 1024);
+	use_frame_arena(16);
+	const uint64_t big_reserved = FrameArena::get_thread_reserved();
+	CHECK(big_reserved >= 4 * 1024 * 1024);
+
+	// The previous frame needed the big chunk, so it is kept.
+	FrameArena::begin_frame();
+	use_frame_arena(16);
+	CHECK(FrameArena::get_thread_reserved() == big_reserved);
+
+	// Now it was mostly idle, so the chunk is given back.
+	FrameArena::begin_frame();
+	use_frame_arena(16);
+	CHECK(FrameArena::get_thread_reserved() < big_reserved);
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
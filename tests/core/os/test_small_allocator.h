@@ -0,0 +1,151 @@
+/**************************************************************************/
+/*  test_small_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_ALLOCATOR_H
+#define TEST_SMALL_ALLOCATOR_H
+
+#include "core/os/small_allocator.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallAllocator {
+
+static bool is_filled(const void *p_memory, size_t p_bytes, uint8_t p_value) {
+	const uint8_t *bytes = (const uint8_t *)p_memory;
+	for (size_t i = 0; i < p_bytes; i++) {
+		if (bytes[i] != p_value) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SmallAllocator] Size classes") {
+	for (uint32_t i = 0; i < SmallAllocator::CLASS_COUNT; i++) {
+		CHECK(SmallAllocator::get_class_size(i) == SmallAllocator::MIN_SMALL_SIZE << i);
+	}
+	CHECK(SmallAllocator::get_class_size(SmallAllocator::CLASS_COUNT - 1) == SmallAllocator::MAX_SMALL_SIZE);
+}
+
+TEST_CASE("[SmallAllocator] Allocate, reallocate and free") {
+	bool aligned = true;
+	bool preserved = true;
+	for (size_t size = 1; size <= SmallAllocator::MAX_SMALL_SIZE + 64; size += 7) {
+		uint8_t value = size & 0xFF;
+		void *memory = SmallAllocator::alloc(size);
+		aligned &= (uintptr_t)memory % alignof(max_align_t) == 0;
+		memset(memory, value, size);
+
+		// Grow out of the small classes, then shrink back into the smallest one.
+		memory = SmallAllocator::realloc(memory, size * 3);
+		preserved &= is_filled(memory, size, value);
+		memset(memory, value, size * 3);
+		memory = SmallAllocator::realloc(memory, 8);
+		preserved &= is_filled(memory, 8, value);
+
+		SmallAllocator::free(memory);
+	}
+	CHECK_MESSAGE(aligned, "Blocks should be aligned like the system allocator.");
+	CHECK_MESSAGE(preserved, "Reallocation should preserve the contents.");
+
+	CHECK(SmallAllocator::realloc(SmallAllocator::alloc(32), 0) == nullptr);
+}
+
+TEST_CASE("[SmallAllocator] Usage statistics") {
+	const uint32_t last_class = SmallAllocator::CLASS_COUNT - 1;
+	const uint64_t usage = SmallAllocator::get_class_usage(last_class);
+
+	void *blocks[200];
+	for (void *&block : blocks) {
+		block = SmallAllocator::alloc(SmallAllocator::MAX_SMALL_SIZE - 100);
+	}
+	CHECK(SmallAllocator::get_class_usage(last_class) == usage + 200 * SmallAllocator::MAX_SMALL_SIZE);
+	CHECK(SmallAllocator::get_class_reserved(last_class) >= 200 * SmallAllocator::MAX_SMALL_SIZE);
+	CHECK(SmallAllocator::get_reserved() >= SmallAllocator::get_class_reserved(last_class));
+
+	for (void *block : blocks) {
+		SmallAllocator::free(block);
+	}
+	CHECK(SmallAllocator::get_class_usage(last_class) == usage);
+
+	ERR_PRINT_OFF;
+	CHECK(SmallAllocator::get_class_usage(SmallAllocator::CLASS_COUNT) == 0);
+	ERR_PRINT_ON;
+}
+
+static constexpr int REMOTE_BLOCKS = 5000;
+static void *remote_blocks[REMOTE_BLOCKS];
+
+static void allocate_remote_blocks(void *p_userdata) {
+	for (int i = 0; i < REMOTE_BLOCKS; i++) {
+		remote_blocks[i] = SmallAllocator::alloc(48);
+		memset(remote_blocks[i], i & 0xFF, 48);
+	}
+}
+
+static void free_remote_blocks(void *p_userdata) {
+	for (int i = 0; i < REMOTE_BLOCKS; i++) {
+		SmallAllocator::free(remote_blocks[i]);
+	}
+}
+
+TEST_CASE("[SmallAllocator] Blocks freed by other threads") {
+	const uint64_t usage = SmallAllocator::get_class_usage(2);
+
+	// Blocks outlive the thread that allocated them.
+	Thread thread;
+	thread.start(allocate_remote_blocks, nullptr);
+	thread.wait_to_finish();
+	CHECK(SmallAllocator::get_class_usage(2) == usage + REMOTE_BLOCKS * 64);
+
+	bool preserved = true;
+	for (int i = 0; i < REMOTE_BLOCKS; i++) {
+		preserved &= is_filled(remote_blocks[i], 48, i & 0xFF);
+		SmallAllocator::free(remote_blocks[i]);
+	}
+	CHECK(preserved);
+	CHECK(SmallAllocator::get_class_usage(2) == usage);
+
+	// Blocks owned by this thread, returned by another one and reused here.
+	allocate_remote_blocks(nullptr);
+	thread.start(free_remote_blocks, nullptr);
+	thread.wait_to_finish();
+	CHECK(SmallAllocator::get_class_usage(2) == usage);
+
+	allocate_remote_blocks(nullptr);
+	CHECK(SmallAllocator::get_class_usage(2) == usage + REMOTE_BLOCKS * 64);
+	free_remote_blocks(nullptr);
+	CHECK(SmallAllocator::get_class_usage(2) == usage);
+}
+
+} // namespace TestSmallAllocator
+
+#endif // TEST_SMALL_ALLOCATOR_H
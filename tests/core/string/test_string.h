@@ -31,6 +31,7 @@
 #ifndef TEST_STRING_H
 #define TEST_STRING_H
 
+#include "core/os/thread.h"
 #include "core/string/ustring.h"
 
 #include "tests/test_macros.h"
@@ -84,6 +85,35 @@ TEST_CASE("[String] Assign from char32_t string (copycon)") {
 	CHECK(u32scmp(s.get_data(), U"Wool") == 0);
 }
 
+TEST_CASE("[String] Single Latin-1 character strings share their buffer") {
+	const String a = "a";
+	String b = String::chr('a');
+	String c;
+	c += U'a';
+	CHECK(a.ptr() == b.ptr());
+	CHECK(a.ptr() == c.ptr());
+	CHECK(a.ptr() == String("ab").substr(0, 1).ptr());
+	CHECK(String::chr(U'\u00e9').ptr() == String(U"\u00e9").ptr());
+	CHECK(String::chr(U'\u3042').ptr() != String::chr(U'\u3042').ptr());
+
+	// Writes must not leak into the shared buffer.
+	b += "b";
+	c[0] = 'z';
+	CHECK(a == "a");
+	CHECK(b == "ab");
+	CHECK(c == "z");
+	CHECK(String::chr('a') == "a");
+	CHECK(String::chr('a').length() == 1);
+
+	// Other threads build their own, so they don't contend on the shared reference counts.
+	String from_thread;
+	Thread thread;
+	thread.start([](void *p_userdata) { *static_cast<String *>(p_userdata) = String::chr('a'); }, &from_thread);
+	thread.wait_to_finish();
+	CHECK(from_thread == a);
+	CHECK(from_thread.ptr() != a.ptr());
+}
+
 TEST_CASE("[String] UTF8") {
 	/* how can i embed UTF in here? */
 	static const char32_t u32str[] = { 0x0045, 0x0020, 0x304A, 0x360F, 0x3088, 0x3046, 0x1F3A4, 0 };
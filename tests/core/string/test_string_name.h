@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_cstring = "test_string_name_interning";
+	const StringName from_string = String("test_string_name_interning");
+	const StringName from_static = _scs_create("test_string_name_interning");
+
+	CHECK(from_cstring == from_string);
+	CHECK(from_cstring == from_static);
+	CHECK(from_cstring.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_cstring != StringName("test_string_name_interning_other"));
+	CHECK(StringName::search("test_string_name_interning") == from_cstring);
+	CHECK(String(from_static) == "test_string_name_interning");
+}
+
+TEST_CASE("[StringName] Released names are removed") {
+	{
+		StringName name = "test_string_name_released";
+		CHECK(StringName::search("test_string_name_released") == name);
+	}
+	CHECK(StringName::search("test_string_name_released") == StringName());
+}
+
+struct InterningThread {
+	static constexpr int SHARED_NAMES = 256;
+
+	Thread thread;
+	int index = 0;
+	int iterations = 0;
+	LocalVector<StringName> shared;
+
+	// Looks up names every thread uses, and creates and drops names only this
+	// thread uses, like nodes and scripts being set up on separate threads.
+	static void run(void *p_userdata) {
+		InterningThread *self = static_cast<InterningThread *>(p_userdata);
+		self->shared.resize(SHARED_NAMES);
+		for (int i = 0; i < self->iterations; i++) {
+			const int shared_index = i % SHARED_NAMES;
+			self->shared[shared_index] = StringName(String("shared_name_") + itos(shared_index));
+			const StringName unique = String("unique_name_") + itos(self->index) + "_" + itos(i);
+		}
+	}
+};
+
+static uint64_t _intern_on_threads(int p_threads, int p_iterations, bool &r_consistent) {
+	LocalVector<InterningThread> threads;
+	threads.resize(p_threads);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_threads; i++) {
+		threads[i].index = i;
+		threads[i].iterations = p_iterations;
+		threads[i].thread.start(InterningThread::run, &threads[i]);
+	}
+	for (InterningThread &thread : threads) {
+		thread.thread.wait_to_finish();
+	}
+	const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Every thread must have found the same data for the same name.
+	r_consistent = true;
+	for (int i = 0; i < InterningThread::SHARED_NAMES; i++) {
+		for (const InterningThread &thread : threads) {
+			r_consistent &= thread.shared[i] == threads[0].shared[i];
+			r_consistent &= String(thread.shared[i]) == String("shared_name_") + itos(i);
+		}
+	}
+	return usec;
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	bool consistent = false;
+	_intern_on_threads(4, 2000, consistent);
+	CHECK(consistent);
+}
+
+TEST_CASE("[Stress][StringName] Concurrent interning performance") {
+	// Same total amount of work, spread over more threads.
+	const int total_iterations = 800000;
+	const int thread_counts[] = { 1, 2, 4, 8 };
+	for (int threads : thread_counts) {
+		bool consistent = false;
+		const uint64_t usec = _intern_on_threads(threads, total_iterations / threads, consistent);
+		MESSAGE(vformat("%d thread(s): %d usec for %d StringName constructions.", threads, usec, total_iterations * 2));
+		CHECK(consistent);
+	}
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -0,0 +1,253 @@
+/**************************************************************************/
+/*  test_dense_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DENSE_HASH_MAP_H
+#define TEST_DENSE_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/dense_hash_map.h"
+#include "core/templates/hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDenseHashMap {
+
+TEST_CASE("[DenseHashMap] Insert element") {
+	DenseHashMap<int, int> map;
+	DenseHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[DenseHashMap] Overwrite element") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+}
+
+TEST_CASE("[DenseHashMap] Erase via element") {
+	DenseHashMap<int, int> map;
+	DenseHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[DenseHashMap] Erase via key") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[DenseHashMap] Size") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 84);
+	map.insert(123, 84);
+	map.insert(0, 84);
+	map.insert(123485, 84);
+
+	CHECK(map.size() == 4);
+}
+
+TEST_CASE("[DenseHashMap] Iteration") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == expected.size());
+}
+
+TEST_CASE("[DenseHashMap] Const iteration") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	const DenseHashMap<int, int> const_map = map;
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == expected.size());
+}
+
+TEST_CASE("[DenseHashMap] Erasing keeps the insertion order") {
+	DenseHashMap<int, String> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, itos(i));
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		map.erase(i);
+	}
+	// Inserting more compacts the erased pairs away.
+	for (int i = 1000; i < 3000; i++) {
+		map.insert(i, itos(i));
+	}
+	CHECK(map.size() == 3000 - 334);
+
+	bool ordered = true;
+	int previous = -1;
+	for (const KeyValue<int, String> &E : map) {
+		if (E.key <= previous || (E.key % 3 == 0 && E.key < 1000) || E.value != itos(E.key)) {
+			ordered = false;
+			break;
+		}
+		previous = E.key;
+	}
+	CHECK_MESSAGE(ordered, "The remaining pairs should keep their insertion order and values.");
+
+	DenseHashMap<int, String>::Iterator last = map.last();
+	REQUIRE(last);
+	CHECK(last->key == 2999);
+	--last;
+	CHECK(last->key == 2998);
+}
+
+TEST_CASE("[DenseHashMap] Erasing while iterating") {
+	DenseHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i);
+	}
+
+	int visited = 0;
+	for (DenseHashMap<int, int>::Iterator E = map.begin(); E; ++E) {
+		if (E->key % 2 == 0) {
+			map.erase(E->key);
+		}
+		visited++;
+	}
+	CHECK(visited == 100);
+	CHECK(map.size() == 50);
+	CHECK(!map.has(98));
+	CHECK(map.has(99));
+}
+
+TEST_CASE("[DenseHashMap] Pointers to values stay valid") {
+	DenseHashMap<int, String> map;
+	map.insert(-1, "first");
+	String *first = map.getptr(-1);
+
+	// Grow, compact and reuse erased pairs around the first one.
+	for (int i = 0; i < 5000; i++) {
+		map.insert(i, itos(i));
+		if (i % 3 == 0) {
+			map.erase(i);
+		}
+	}
+	for (int i = 5000; i < 6000; i++) {
+		map.insert(i, itos(i));
+	}
+
+	CHECK(map.getptr(-1) == first);
+	CHECK(*first == "first");
+	CHECK(map[4999] == "4999");
+	CHECK(!map.has(4998 - 4998 % 3));
+	CHECK(map.begin()->key == -1);
+
+	map.clear();
+	map.insert(7, "seven");
+	CHECK(map.size() == 1);
+	CHECK(map[7] == "seven");
+}
+
+template <typename M>
+static uint64_t _build_and_iterate_maps(int p_maps, int p_elements, int64_t &r_checksum) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_maps; i++) {
+		M map;
+		for (int j = 0; j < p_elements; j++) {
+			map.insert(j * 7, j);
+		}
+		for (const KeyValue<int, int> &E : map) {
+			r_checksum += E.value;
+		}
+		for (int j = 0; j < p_elements; j += 2) {
+			map.erase(j * 7);
+		}
+		for (int j = 0; j < p_elements; j++) {
+			const int *value = map.getptr(j * 7);
+			r_checksum += value ? *value : 0;
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+TEST_CASE("[Stress][DenseHashMap] Performance compared to HashMap") {
+	// Many small maps, like scripts building dictionaries every frame, and a few large ones.
+	const int sizes[] = { 8, 64, 1000, 100000 };
+	for (int size : sizes) {
+		const int maps = 2000000 / size;
+		int64_t hash_map_checksum = 0;
+		int64_t dense_hash_map_checksum = 0;
+		const uint64_t hash_map_usec = _build_and_iterate_maps<HashMap<int, int>>(maps, size, hash_map_checksum);
+		const uint64_t dense_hash_map_usec = _build_and_iterate_maps<DenseHashMap<int, int>>(maps, size, dense_hash_map_checksum);
+
+		MESSAGE(vformat("%d maps of %d elements: HashMap %d usec, DenseHashMap %d usec.", maps, size, hash_map_usec, dense_hash_map_usec));
+		CHECK(hash_map_checksum == dense_hash_map_checksum);
+	}
+}
+
+} // namespace TestDenseHashMap
+
+#endif // TEST_DENSE_HASH_MAP_H
@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_DEQUE_H
+#define TEST_WORK_STEALING_DEQUE_H
+
+#include "core/os/thread.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops LIFO, thieves steal FIFO") {
+	WorkStealingDeque<uintptr_t, 8> deque;
+	uintptr_t value = 0;
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK(deque.steal(value) == WorkStealingDeque<uintptr_t, 8>::STEAL_EMPTY);
+
+	for (uintptr_t i = 1; i <= 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.is_empty());
+
+	CHECK(deque.pop(value));
+	CHECK(value == 4);
+	CHECK(deque.steal(value) == WorkStealingDeque<uintptr_t, 8>::STEAL_SUCCESS);
+	CHECK(value == 1);
+	CHECK(deque.pop(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value) == WorkStealingDeque<uintptr_t, 8>::STEAL_SUCCESS);
+	CHECK(value == 2);
+	CHECK(deque.is_empty());
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<uintptr_t, 4> deque;
+	for (uintptr_t i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(4));
+
+	uintptr_t value = 0;
+	CHECK(deque.steal(value) == WorkStealingDeque<uintptr_t, 4>::STEAL_SUCCESS);
+	CHECK(value == 0);
+	// Slot freed by the thief can be reused.
+	CHECK(deque.push(4));
+}
+
+static const uint32_t CONCURRENT_ITEMS = 100000;
+static WorkStealingDeque<uintptr_t, 64> concurrent_deque;
+static LocalVector<SafeNumeric<uint32_t>> concurrent_counts;
+static SafeFlag concurrent_done;
+
+static void concurrent_thief(void *p_userdata) {
+	uintptr_t value = 0;
+	while (true) {
+		bool done = concurrent_done.is_set(); // Read before stealing so that nothing is left behind.
+		WorkStealingDeque<uintptr_t, 64>::StealResult result = concurrent_deque.steal(value);
+		if (result == WorkStealingDeque<uintptr_t, 64>::STEAL_SUCCESS) {
+			concurrent_counts[value].increment();
+		} else if (result == WorkStealingDeque<uintptr_t, 64>::STEAL_EMPTY && done) {
+			break;
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingDeque] Every element is taken exactly once under concurrent stealing") {
+	concurrent_counts.clear();
+	concurrent_counts.resize(CONCURRENT_ITEMS);
+	concurrent_done.clear();
+
+	Thread thieves[3];
+	for (Thread &thief : thieves) {
+		thief.start(concurrent_thief, nullptr);
+	}
+
+	uintptr_t next = 0;
+	uintptr_t value = 0;
+	while (next < CONCURRENT_ITEMS) {
+		for (int i = 0; i < 16 && next < CONCURRENT_ITEMS; i++) {
+			if (!concurrent_deque.push(next)) {
+				break;
+			}
+			next++;
+		}
+		for (int i = 0; i < 4; i++) {
+			if (concurrent_deque.pop(value)) {
+				concurrent_counts[value].increment();
+			}
+		}
+	}
+	concurrent_done.set();
+
+	for (Thread &thief : thieves) {
+		thief.wait_to_finish();
+	}
+	while (concurrent_deque.pop(value)) {
+		concurrent_counts[value].increment();
+	}
+
+	bool all_taken_once = true;
+	for (uint32_t i = 0; i < CONCURRENT_ITEMS; i++) {
+		all_taken_once &= concurrent_counts[i].get() == 1;
+	}
+	CHECK(all_taken_once);
+}
+
+} // namespace TestWorkStealingDeque
+
+#endif // TEST_WORK_STEALING_DEQUE_H
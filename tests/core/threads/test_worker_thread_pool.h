@@ -106,6 +106,189 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static SafeNumeric<int> stage_count[3];
+static SafeFlag stage_order_broken;
+
+static void static_stage_a_test(void *p_arg, uint32_t p_index) {
+	stage_count[0].increment();
+}
+static void static_stage_b_test(void *p_arg) {
+	if (stage_count[0].get() != (int)(uintptr_t)p_arg) {
+		stage_order_broken.set();
+	}
+	stage_count[1].increment();
+}
+static void static_stage_c_test(void *p_arg, uint32_t p_index) {
+	if (stage_count[1].get() != 1) {
+		stage_order_broken.set();
+	}
+	stage_count[2].increment();
+}
+TEST_CASE("[WorkerThreadPool] Tasks with dependencies run after them") {
+	for (int iterations = 0; iterations < 200; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		for (int i = 0; i < 3; i++) {
+			stage_count[i].set(0);
+		}
+		stage_order_broken.clear();
+
+		// C depends on B, which depends on A. Dependencies are declared upfront and only C is awaited.
+		WorkerThreadPool::GroupID group_a = WorkerThreadPool::get_singleton()->add_native_group_task(static_stage_a_test, nullptr, count, -1, !low_priority);
+		Vector<int64_t> dependencies;
+		dependencies.push_back(group_a);
+		WorkerThreadPool::TaskID task_b = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_stage_b_test, (void *)(uintptr_t)count, dependencies, low_priority);
+		dependencies.clear();
+		dependencies.push_back(task_b);
+		WorkerThreadPool::GroupID group_c = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_stage_c_test, nullptr, dependencies, count, -1, !low_priority);
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_c);
+
+		CHECK(WorkerThreadPool::get_singleton()->is_group_task_completed(group_a));
+		CHECK(WorkerThreadPool::get_singleton()->is_task_completed(task_b));
+		CHECK(stage_count[2].get() == count);
+		CHECK_FALSE(stage_order_broken.is_set());
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_a);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_b);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Dependencies already completed are satisfied") {
+	counter.clear();
+	counter.resize(1);
+
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)0, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+	Vector<int64_t> dependencies;
+	dependencies.push_back(task); // Already waited for, so no longer known.
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_group_test, (void *)0, dependencies, 1);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(counter[0].get() == 4); // 3 from the task, 1 from the group.
+}
+
+TEST_CASE("[WorkerThreadPool] Invalid dependencies are rejected") {
+	counter.clear();
+	counter.resize(1);
+
+	Vector<int64_t> dependencies;
+	dependencies.push_back(WorkerThreadPool::INVALID_TASK_ID);
+	dependencies.push_back(int64_t(1) << 40); // Never issued.
+	ERR_PRINT_OFF;
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_test, (void *)0, dependencies, true);
+	ERR_PRINT_ON;
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+	CHECK(counter[0].get() == 3);
+}
+
+static const int NESTED_SUBTASKS = 16;
+
+static void static_nested_subtask(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	// Runs on a pool thread, so the subtasks go to its local queue and may be stolen by other threads.
+	WorkerThreadPool::TaskID subtasks[NESTED_SUBTASKS];
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		subtasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_subtask, (void *)(uintptr_t)p_index, true);
+	}
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(subtasks[i]);
+	}
+}
+TEST_CASE("[WorkerThreadPool] Process tasks spawned from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 6.0f));
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, nullptr, count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		bool all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			all_run_once &= counter[i].get() == NESTED_SUBTASKS;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_reinit_test(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+static bool run_reinit_tasks(int p_count) {
+	counter.clear();
+	counter.resize(p_count);
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_reinit_test, (void *)(uintptr_t)i, i % 2);
+	}
+	for (int i = 0; i < p_count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+	bool all_run_once = true;
+	for (int i = 0; i < p_count; i++) {
+		all_run_once &= counter[i].get() == 1;
+	}
+	return all_run_once;
+}
+TEST_CASE("[WorkerThreadPool] Shrinking the pool after finish") {
+	// Restarting with fewer threads must not keep dispatch state from the larger pool.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(8);
+	CHECK(run_reinit_tasks(64));
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(1);
+	CHECK(WorkerThreadPool::get_singleton()->get_thread_count() == 1);
+	CHECK(run_reinit_tasks(64));
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+}
+
+static void static_tiny_task_test(void *p_arg) {
+	counter[(uint64_t)p_arg & 0xFF].increment();
+}
+static void static_fan_out_test(void *p_arg, uint32_t p_index) {
+	// Waiting on individual tasks lets this pool thread process other tasks meanwhile.
+	WorkerThreadPool::TaskID subtasks[NESTED_SUBTASKS];
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		subtasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_tiny_task_test, (void *)(uintptr_t)(p_index * NESTED_SUBTASKS + i), true);
+	}
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(subtasks[i]);
+	}
+}
+TEST_CASE("[Stress][WorkerThreadPool] Queue contention benchmark") {
+	// Many tiny tasks spawned from every pool thread at once stress task posting and dispatching,
+	// which is where queue contention shows. Timings are reported rather than checked.
+	const int fan_out = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 64;
+	const int rounds = 50;
+
+	counter.clear();
+	counter.resize(256);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < rounds; i++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_fan_out_test, nullptr, fan_out, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int total = 0;
+	for (int i = 0; i < 256; i++) {
+		total += counter[i].get();
+	}
+	CHECK(total == rounds * fan_out * NESTED_SUBTASKS);
+	MESSAGE("Ran ", rounds * fan_out * NESTED_SUBTASKS, " nested tasks on ", WorkerThreadPool::get_singleton()->get_thread_count(), " threads in ", elapsed, " usec.");
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -132,6 +132,18 @@ TEST_CASE("[Dictionary] getptr()") {
 	CHECK(key == nullptr);
 }
 
+TEST_CASE("[Dictionary] getptr() stays valid while inserting") {
+	// GDExtension hands out raw value pointers, e.g. for `d["new"] = d["old"]`.
+	Dictionary map;
+	map["old"] = 42;
+	Variant *value = map.getptr("old");
+	for (int i = 0; i < 1000; i++) {
+		map[i] = i;
+	}
+	CHECK(value == map.getptr("old"));
+	CHECK(int(*value) == 42);
+}
+
 TEST_CASE("[Dictionary] get_valid()") {
 	Dictionary map;
 	map[1] = 3;
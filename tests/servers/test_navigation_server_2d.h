@@ -31,6 +31,10 @@
 #ifndef TEST_NAVIGATION_SERVER_2D_H
 #define TEST_NAVIGATION_SERVER_2D_H
 
+#include "scene/2d/mesh_instance_2d.h"
+#include "scene/2d/multimesh_instance_2d.h"
+#include "scene/2d/physics/static_body_2d.h"
+#include "scene/resources/2d/rectangle_shape_2d.h"
 #include "servers/navigation_server_2d.h"
 
 #include "tests/test_macros.h"
@@ -41,6 +45,88 @@ TEST_SUITE("[Navigation]") {
 		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer2D][SceneTree] Server should parse many nodes in scene tree order") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+
+		// Enough nodes sharing one mesh and one shape to spread the extraction over several worker chunks.
+		const int node_count = 200;
+		const int multimesh_instance_count = 100;
+		Node2D *node_2d = memnew(Node2D);
+		SceneTree::get_singleton()->get_root()->add_child(node_2d);
+
+		// A 10x10 square made of two triangles, merged into a single outline by the parser.
+		PackedVector2Array square_vertices;
+		square_vertices.push_back(Vector2(-5, -5));
+		square_vertices.push_back(Vector2(5, -5));
+		square_vertices.push_back(Vector2(5, 5));
+		square_vertices.push_back(Vector2(-5, -5));
+		square_vertices.push_back(Vector2(5, 5));
+		square_vertices.push_back(Vector2(-5, 5));
+		Array arrays;
+		arrays.resize(Mesh::ARRAY_MAX);
+		arrays[Mesh::ARRAY_VERTEX] = square_vertices;
+		Ref<ArrayMesh> square_mesh = memnew(ArrayMesh);
+		square_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+
+		for (int i = 0; i < node_count; i++) {
+			MeshInstance2D *mesh_instance = memnew(MeshInstance2D);
+			mesh_instance->set_mesh(square_mesh);
+			mesh_instance->set_position(Vector2(i * 20.0, 0.0));
+			node_2d->add_child(mesh_instance);
+		}
+
+		Ref<MultiMesh> multimesh = memnew(MultiMesh);
+		multimesh->set_transform_format(MultiMesh::TRANSFORM_2D);
+		multimesh->set_mesh(square_mesh);
+		multimesh->set_instance_count(multimesh_instance_count);
+		for (int i = 0; i < multimesh_instance_count; i++) {
+			multimesh->set_instance_transform_2d(i, Transform2D(0.0, Vector2(i * 20.0, 0.0)));
+		}
+		MultiMeshInstance2D *multimesh_instance = memnew(MultiMeshInstance2D);
+		multimesh_instance->set_multimesh(multimesh);
+		multimesh_instance->set_position(Vector2(0.0, 100.0));
+		node_2d->add_child(multimesh_instance);
+
+		Ref<RectangleShape2D> square_shape = memnew(RectangleShape2D);
+		square_shape->set_size(Vector2(10.0, 10.0));
+		for (int i = 0; i < node_count; i++) {
+			StaticBody2D *static_body = memnew(StaticBody2D);
+			static_body->shape_owner_add_shape(static_body->create_shape_owner(static_body), square_shape);
+			static_body->set_position(Vector2(i * 20.0, 200.0));
+			node_2d->add_child(static_body);
+		}
+
+		Ref<NavigationPolygon> navigation_polygon = memnew(NavigationPolygon);
+		navigation_polygon->set_parsed_geometry_type(NavigationPolygon::PARSED_GEOMETRY_BOTH);
+		Ref<NavigationMeshSourceGeometryData2D> source_geometry = memnew(NavigationMeshSourceGeometryData2D);
+		navigation_server->parse_source_geometry_data(navigation_polygon, source_geometry, node_2d);
+
+		const Vector<Vector<Vector2>> &outlines = source_geometry->_get_obstruction_outlines();
+		REQUIRE_EQ(outlines.size(), node_count * 2 + multimesh_instance_count);
+
+		// Every square should be in its own place after the chunks are merged, meshes first, then the multimesh, then the bodies.
+		bool in_order = true;
+		for (int i = 0; i < outlines.size(); i++) {
+			Vector2 expected_center;
+			if (i < node_count) {
+				expected_center = Vector2(i * 20.0, 0.0);
+			} else if (i < node_count + multimesh_instance_count) {
+				expected_center = Vector2((i - node_count) * 20.0, 100.0);
+			} else {
+				expected_center = Vector2((i - node_count - multimesh_instance_count) * 20.0, 200.0);
+			}
+
+			Rect2 outline_bounds(outlines[i][0], Vector2());
+			for (const Vector2 &point : outlines[i]) {
+				outline_bounds.expand_to(point);
+			}
+			in_order = in_order && outline_bounds.get_center().is_equal_approx(expected_center) && outline_bounds.size.is_equal_approx(Vector2(10.0, 10.0));
+		}
+		CHECK(in_order);
+
+		memdelete(node_2d);
+	}
 }
 } //namespace TestNavigationServer2D
 
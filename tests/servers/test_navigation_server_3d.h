@@ -31,6 +31,7 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -51,6 +52,20 @@ public:
 	Variant function1_latest_arg0{};
 };
 
+// Records the safe velocity reported to the avoidance callback of each agent in a crowd.
+class SafeVelocityRecorder : public Object {
+	GDCLASS(SafeVelocityRecorder, Object);
+
+public:
+	void record(Vector3 p_safe_velocity, int p_index) {
+		safe_velocities[p_index] = p_safe_velocity;
+		calls[p_index]++;
+	}
+
+	LocalVector<Vector3> safe_velocities;
+	LocalVector<uint32_t> calls;
+};
+
 static inline Array build_array() {
 	return Array();
 }
@@ -61,6 +76,82 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+// Builds a 40x40 map from a 4x4 grid of regions with 10x10 unit quads each, and a wall at x=19
+// that forces paths from the left to the right side to detour along the far edge at z=40.
+static inline RID create_grid_map(NavigationServer3D *p_navigation_server, LocalVector<RID> &r_regions) {
+	const int region_grid_size = 4;
+	const int region_quad_count = 10;
+	const int wall_x = region_grid_size * region_quad_count / 2 - 1;
+	const int wall_length = region_grid_size * region_quad_count - 4;
+
+	RID map = p_navigation_server->map_create();
+	p_navigation_server->map_set_active(map, true);
+
+	for (int region_z = 0; region_z < region_grid_size; region_z++) {
+		for (int region_x = 0; region_x < region_grid_size; region_x++) {
+			Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+			Vector<Vector3> vertices;
+			for (int z = 0; z <= region_quad_count; z++) {
+				for (int x = 0; x <= region_quad_count; x++) {
+					vertices.push_back(Vector3(region_x * region_quad_count + x, 0, region_z * region_quad_count + z));
+				}
+			}
+			navigation_mesh->set_vertices(vertices);
+
+			for (int z = 0; z < region_quad_count; z++) {
+				for (int x = 0; x < region_quad_count; x++) {
+					if (region_x * region_quad_count + x == wall_x && region_z * region_quad_count + z < wall_length) {
+						continue;
+					}
+					const int index = z * (region_quad_count + 1) + x;
+					Vector<int> polygon;
+					polygon.push_back(index);
+					polygon.push_back(index + region_quad_count + 1);
+					polygon.push_back(index + region_quad_count + 2);
+					polygon.push_back(index + 1);
+					navigation_mesh->add_polygon(polygon);
+				}
+			}
+
+			RID region = p_navigation_server->region_create();
+			p_navigation_server->region_set_map(region, map);
+			p_navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			r_regions.push_back(region);
+		}
+	}
+
+	return map;
+}
+
+// Creates a map that uses either the RVO2 or the grid backend for 3D avoidance.
+static inline RID create_avoidance_map(NavigationServer3D *p_navigation_server, bool p_use_grid_avoidance) {
+	const Variant use_grid_avoidance = GLOBAL_GET("navigation/avoidance/3d/use_grid_avoidance");
+	ProjectSettings::get_singleton()->set_setting("navigation/avoidance/3d/use_grid_avoidance", p_use_grid_avoidance);
+	RID map = p_navigation_server->map_create();
+	ProjectSettings::get_singleton()->set_setting("navigation/avoidance/3d/use_grid_avoidance", use_grid_avoidance);
+	return map;
+}
+
+// Adds a square crowd of `p_side * p_side` agents that all walk towards the crowd center.
+static inline void add_avoidance_crowd(NavigationServer3D *p_navigation_server, RID p_map, int p_side, LocalVector<RID> &r_agents) {
+	const Vector3 center = Vector3(p_side * 0.75, 0, p_side * 0.75);
+	for (int i = 0; i < p_side * p_side; i++) {
+		const Vector3 position = Vector3((i % p_side) * 1.5 + Math::abs(Math::sin(i * 12.9898)) * 0.4, Math::abs(Math::sin(i * 4.1414)) * 0.2, (i / p_side) * 1.5 + Math::abs(Math::sin(i * 78.233)) * 0.4);
+
+		RID agent = p_navigation_server->agent_create();
+		p_navigation_server->agent_set_map(agent, p_map);
+		p_navigation_server->agent_set_use_3d_avoidance(agent, true);
+		p_navigation_server->agent_set_avoidance_enabled(agent, true);
+		p_navigation_server->agent_set_position(agent, position);
+		p_navigation_server->agent_set_radius(agent, 0.5);
+		p_navigation_server->agent_set_max_speed(agent, 2.0);
+		p_navigation_server->agent_set_neighbor_distance(agent, 5.0);
+		p_navigation_server->agent_set_max_neighbors(agent, 10);
+		p_navigation_server->agent_set_velocity(agent, (center - position).normalized() * 2.0);
+		r_agents.push_back(agent);
+	}
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -427,6 +518,114 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Grid avoidance should make agents avoid each other") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = create_avoidance_map(navigation_server, true);
+		RID agent_1 = navigation_server->agent_create();
+		RID agent_2 = navigation_server->agent_create();
+
+		navigation_server->map_set_active(map, true);
+
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_use_3d_avoidance(agent_1, true);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_position(agent_1, Vector3(0, 0, 0));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_velocity(agent_1, Vector3(1, 0, 0));
+		CallableMock agent_1_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_1, callable_mp(&agent_1_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_use_3d_avoidance(agent_2, true);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_position(agent_2, Vector3(2.5, 0, 0.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_velocity(agent_2, Vector3(-1, 0, 0));
+		CallableMock agent_2_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_2, callable_mp(&agent_2_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->process(0.1);
+		CHECK_EQ(agent_1_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_2_avoidance_callback_mock.function1_calls, 1);
+		Vector3 agent_1_safe_velocity = agent_1_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_2_safe_velocity = agent_2_avoidance_callback_mock.function1_latest_arg0;
+		CHECK_MESSAGE(agent_1_safe_velocity.x > 0, "agent 1 should move a bit along desired velocity (+X)");
+		CHECK_MESSAGE(agent_2_safe_velocity.x < 0, "agent 2 should move a bit along desired velocity (-X)");
+		CHECK_MESSAGE(agent_1_safe_velocity.z < 0, "agent 1 should move a bit to the side so that it avoids agent 2");
+		CHECK_MESSAGE(agent_2_safe_velocity.z > 0, "agent 2 should move a bit to the side so that it avoids agent 1");
+		CHECK_MESSAGE(agent_1_safe_velocity.is_equal_approx(-agent_2_safe_velocity), "Both agents are solved against the same state, so their symmetric setup should give mirrored velocities.");
+
+		navigation_server->free(agent_2);
+		navigation_server->free(agent_1);
+		navigation_server->free(map);
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Grid avoidance should handle crowds of 10000 agents") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		LocalVector<RID> rvo_agents;
+		LocalVector<RID> grid_agents;
+		RID rvo_map = create_avoidance_map(navigation_server, false);
+		RID grid_map = create_avoidance_map(navigation_server, true);
+		add_avoidance_crowd(navigation_server, rvo_map, 100, rvo_agents);
+		add_avoidance_crowd(navigation_server, grid_map, 100, grid_agents);
+
+		SafeVelocityRecorder grid_recorder;
+		grid_recorder.safe_velocities.resize(grid_agents.size());
+		grid_recorder.calls.resize(grid_agents.size());
+		for (uint32_t i = 0; i < grid_agents.size(); i++) {
+			grid_recorder.calls[i] = 0;
+			navigation_server->agent_set_avoidance_callback(grid_agents[i], callable_mp(&grid_recorder, &SafeVelocityRecorder::record).bind(i));
+		}
+
+		// Only one map is active at a time so each measurement only covers one backend.
+		const int step_count = 10;
+		navigation_server->map_set_active(rvo_map, true);
+		navigation_server->process(0.0);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int step = 0; step < step_count; step++) {
+			navigation_server->process(0.1);
+		}
+		const uint64_t rvo_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		navigation_server->map_set_active(rvo_map, false);
+
+		navigation_server->map_set_active(grid_map, true);
+		navigation_server->process(0.0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int step = 0; step < step_count; step++) {
+			navigation_server->process(0.1);
+		}
+		const uint64_t grid_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		navigation_server->map_set_active(grid_map, false);
+
+		// The velocities set on the agents are only the input, check the safe velocities the grid computed.
+		bool all_solved = true;
+		int adjusted_count = 0;
+		for (uint32_t i = 0; i < grid_agents.size(); i++) {
+			const Vector3 &safe_velocity = grid_recorder.safe_velocities[i];
+			all_solved &= grid_recorder.calls[i] > 0 && safe_velocity.is_finite() && safe_velocity.length() <= 2.0 + CMP_EPSILON;
+			if (!safe_velocity.is_equal_approx(navigation_server->agent_get_velocity(grid_agents[i]))) {
+				adjusted_count++;
+			}
+		}
+		CHECK(all_solved);
+		// The crowd converges on its center, so many agents must deviate from their desired velocity.
+		CHECK_GT(adjusted_count, 0);
+
+		MESSAGE("Stepped avoidance of ", grid_agents.size(), " agents ", step_count, " times in ", rvo_usec, " usec with RVO2 and in ", grid_usec, " usec with the grid backend.");
+
+		for (const RID &agent : rvo_agents) {
+			navigation_server->free(agent);
+		}
+		for (const RID &agent : grid_agents) {
+			navigation_server->free(agent);
+		}
+		navigation_server->free(rvo_map);
+		navigation_server->free(grid_map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -623,6 +822,45 @@ TEST_SUITE("[Navigation]") {
 		memdelete(node_3d);
 	}
 
+	TEST_CASE("[NavigationServer3D][SceneTree] Server should parse many nodes in scene tree order") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Enough nodes sharing one mesh to spread the extraction over several worker chunks.
+		const int mesh_instance_count = 500;
+		Node3D *node_3d = memnew(Node3D);
+		SceneTree::get_singleton()->get_root()->add_child(node_3d);
+		Ref<PlaneMesh> plane_mesh = memnew(PlaneMesh);
+		plane_mesh->set_size(Size2(1.0, 1.0));
+		for (int i = 0; i < mesh_instance_count; i++) {
+			MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+			mesh_instance->set_mesh(plane_mesh);
+			mesh_instance->set_position(Vector3(i * 2.0, 0.0, 0.0));
+			node_3d->add_child(mesh_instance);
+		}
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+
+		const Vector<float> vertices = source_geometry->get_vertices();
+		const Vector<int> indices = source_geometry->get_indices();
+		REQUIRE_EQ(vertices.size(), mesh_instance_count * 12);
+		REQUIRE_EQ(indices.size(), mesh_instance_count * 6);
+
+		// Every quad should be in its own place and point at its own vertices after the chunks are merged.
+		bool in_order = true;
+		for (int i = 0; i < mesh_instance_count; i++) {
+			const float quad_center_x = (vertices[i * 12 + 0] + vertices[i * 12 + 3] + vertices[i * 12 + 6] + vertices[i * 12 + 9]) * 0.25f;
+			in_order = in_order && Math::is_equal_approx(quad_center_x, i * 2.0f);
+			for (int j = 0; j < 6; j++) {
+				in_order = in_order && indices[i * 6 + j] >= i * 4 && indices[i * 6 + j] < (i + 1) * 4;
+			}
+		}
+		CHECK(in_order);
+
+		memdelete(node_3d);
+	}
+
 	// This test case uses only public APIs on purpose - other test cases use simplified baking.
 	TEST_CASE("[NavigationServer3D][SceneTree] Server should be able to bake map correctly") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -764,6 +1002,362 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should run batched path queries asynchronously") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		TypedArray<NavigationPathQueryParameters3D> query_parameters;
+		TypedArray<NavigationPathQueryResult3D> query_results;
+		for (int i = 0; i < 64; i++) {
+			Ref<NavigationPathQueryParameters3D> parameters = memnew(NavigationPathQueryParameters3D);
+			parameters->set_map(map);
+			parameters->set_start_position(Vector3(-4.5 + (i % 8), 0, -4.5));
+			parameters->set_target_position(Vector3(4.5, 0, -4.5 + (i / 8)));
+			query_parameters.push_back(parameters);
+			query_results.push_back(memnew(NavigationPathQueryResult3D));
+		}
+
+		CallableMock mock;
+		const uint32_t batch_id = navigation_server->query_path_batch_async(query_parameters, query_results, callable_mp(&mock, &CallableMock::function1));
+		CHECK_NE(batch_id, 0);
+
+		// Results are only delivered on sync, after all queries of the batch finished.
+		for (int i = 0; i < 10000 && navigation_server->is_path_query_batch_pending(batch_id); i++) {
+			OS::get_singleton()->delay_usec(100);
+			navigation_server->sync();
+		}
+		REQUIRE_FALSE(navigation_server->is_path_query_batch_pending(batch_id));
+		CHECK_EQ(mock.function1_calls, 1);
+		CHECK_EQ(int64_t(mock.function1_latest_arg0), batch_id);
+
+		for (int i = 0; i < query_parameters.size(); i++) {
+			Ref<NavigationPathQueryResult3D> expected_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(query_parameters[i], expected_result);
+			const Ref<NavigationPathQueryResult3D> result = query_results[i];
+			CHECK_NE(result->get_path().size(), 0);
+			CHECK_EQ(result->get_path(), expected_result->get_path());
+			CHECK_EQ(result->get_path_rids(), expected_result->get_path_rids());
+		}
+
+		SUBCASE("Mismatched parameter and result counts should be rejected") {
+			query_results.pop_back();
+			ERR_PRINT_OFF;
+			CHECK_EQ(navigation_server->query_path_batch_async(query_parameters, query_results), 0);
+			ERR_PRINT_ON;
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical path queries should match flat A* results") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		LocalVector<RID> regions;
+		RID map = create_grid_map(navigation_server, regions);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start_positions[] = { Vector3(1.5, 0, 1.5), Vector3(0.5, 0, 38.5), Vector3(5.5, 0, 20.5) };
+		const Vector3 target_positions[] = { Vector3(38.5, 0, 1.5), Vector3(38.5, 0, 0.5), Vector3(30.5, 0, 12.5) };
+
+		for (int i = 0; i < 3; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(start_positions[i]);
+			query_parameters->set_target_position(target_positions[i]);
+
+			Ref<NavigationPathQueryResult3D> flat_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(query_parameters, flat_result);
+
+			query_parameters->set_pathfinding_algorithm(NavigationPathQueryParameters3D::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR);
+			Ref<NavigationPathQueryResult3D> hierarchical_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(query_parameters, hierarchical_result);
+
+			const Vector<Vector3> flat_path = flat_result->get_path();
+			const Vector<Vector3> hierarchical_path = hierarchical_result->get_path();
+			REQUIRE_GE(flat_path.size(), 2);
+			REQUIRE_GE(hierarchical_path.size(), 2);
+			CHECK(hierarchical_path[0].is_equal_approx(flat_path[0]));
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(flat_path[flat_path.size() - 1]));
+			CHECK_NE(hierarchical_result->get_path_rids().size(), 0);
+
+			real_t flat_length = 0.0;
+			for (int j = 1; j < flat_path.size(); j++) {
+				flat_length += flat_path[j - 1].distance_to(flat_path[j]);
+			}
+			real_t hierarchical_length = 0.0;
+			for (int j = 1; j < hierarchical_path.size(); j++) {
+				hierarchical_length += hierarchical_path[j - 1].distance_to(hierarchical_path[j]);
+			}
+			CHECK_LE(hierarchical_length, flat_length * 1.1);
+		}
+
+		// Targets outside of the map should end at the closest point on the map, like flat queries do.
+		Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(1.5, 0, 1.5));
+		query_parameters->set_target_position(Vector3(60, 0, 60));
+		query_parameters->set_pathfinding_algorithm(NavigationPathQueryParameters3D::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR);
+		Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+		navigation_server->query_path(query_parameters, query_result);
+		const Vector<Vector3> path = query_result->get_path();
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(40, 0, 40)));
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Flow field directions should lead to a shared destination") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		LocalVector<RID> regions;
+		RID map = create_grid_map(navigation_server, regions);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 destination = Vector3(38.5, 0, 1.5);
+		const Vector3 start_positions[] = { Vector3(1.5, 0, 1.5), Vector3(10.5, 0, 30.5), Vector3(25.5, 0, 20.5) };
+
+		// Walk along the sampled directions like an agent would, all of them share the flow field of the destination.
+		for (const Vector3 &start_position : start_positions) {
+			Vector3 position = start_position;
+			real_t walked_length = 0.0;
+			for (int step = 0; step < 1000 && position.distance_to(destination) > 0.25; step++) {
+				const Vector3 direction = navigation_server->map_get_flow_field_direction(map, position, destination);
+				if (direction.is_zero_approx()) {
+					break;
+				}
+				const Vector3 next_position = navigation_server->map_get_closest_point(map, position + direction * 0.2);
+				walked_length += position.distance_to(next_position);
+				position = next_position;
+			}
+			CHECK_LE(position.distance_to(destination), 0.25);
+
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start_position, destination, true);
+			real_t path_length = 0.0;
+			for (int i = 1; i < path.size(); i++) {
+				path_length += path[i - 1].distance_to(path[i]);
+			}
+			CHECK_LE(walked_length, path_length * 1.1 + 1.0);
+		}
+
+		CHECK(navigation_server->map_get_flow_field_direction(map, destination, destination).is_zero_approx());
+		CHECK(navigation_server->map_get_flow_field_direction(map, start_positions[0], destination, 2).is_zero_approx());
+
+		SUBCASE("Flow fields should be computed again when the map changes") {
+			CHECK_FALSE(navigation_server->map_get_flow_field_direction(map, start_positions[0], destination).is_zero_approx());
+
+			// This region contains the only way around the wall.
+			navigation_server->region_set_enabled(regions[13], false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->map_get_flow_field_direction(map, start_positions[0], destination).is_zero_approx());
+
+			navigation_server->region_set_enabled(regions[13], true);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_FALSE(navigation_server->map_get_flow_field_direction(map, start_positions[0], destination).is_zero_approx());
+		}
+
+		SUBCASE("Flow fields should be computed again when travel costs or layers change") {
+			// Walks from next to the wall and returns the smallest x reached on the way to the destination.
+			auto walk_min_x = [&]() {
+				Vector3 position = Vector3(15.5, 0, 1.5);
+				real_t min_x = position.x;
+				for (int step = 0; step < 2000 && position.distance_to(destination) > 0.25; step++) {
+					const Vector3 direction = navigation_server->map_get_flow_field_direction(map, position, destination);
+					if (direction.is_zero_approx()) {
+						break;
+					}
+					position = navigation_server->map_get_closest_point(map, position + direction * 0.2);
+					min_x = MIN(min_x, position.x);
+				}
+				CHECK_LE(position.distance_to(destination), 0.25);
+				return min_x;
+			};
+			CHECK_GT(walk_min_x(), 14.0);
+
+			// Make the column of regions along the wall expensive, leaving it to the west is cheaper.
+			for (int i = 1; i < 12; i += 4) {
+				navigation_server->region_set_travel_cost(regions[i], 1000.0);
+			}
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_LT(walk_min_x(), 10.0);
+
+			for (int i = 1; i < 12; i += 4) {
+				navigation_server->region_set_travel_cost(regions[i], 1.0);
+			}
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_GT(walk_min_x(), 14.0);
+
+			// The region with the only way around the wall no longer matches the default layers.
+			navigation_server->region_set_navigation_layers(regions[13], 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->map_get_flow_field_direction(map, start_positions[0], destination).is_zero_approx());
+			navigation_server->region_set_navigation_layers(regions[13], 1);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_FALSE(navigation_server->map_get_flow_field_direction(map, start_positions[0], destination).is_zero_approx());
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Closest point queries should find the nearest polygon on large maps") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		LocalVector<RID> regions;
+		RID map = create_grid_map(navigation_server, regions);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(10.3, 2, 7.7)).is_equal_approx(Vector3(10.3, 0, 7.7)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(60, 5, 60)).is_equal_approx(Vector3(40, 0, 40)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(-100, 0, 20.5)).is_equal_approx(Vector3(0, 0, 20.5)));
+		CHECK(Math::is_equal_approx(navigation_server->map_get_closest_point(map, Vector3(19.5, 0, 10)).distance_to(Vector3(19.5, 0, 10)), (real_t)0.5));
+		CHECK(Math::is_equal_approx(Math::abs(navigation_server->map_get_closest_point_normal(map, Vector3(10.3, 2, 7.7)).y), (real_t)1.0));
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(35.5, 1, 35.5)), regions[regions.size() - 1]);
+
+		// Points on the edge between two regions resolve to the region that was added to the map first.
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(10, 1, 5)), regions[0]);
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(25, 1, 10)), regions[2]);
+
+		// Non-finite points don't match any polygon.
+		CHECK_EQ(navigation_server->map_get_closest_point(map, Vector3(NAN, 0, 0)), Vector3());
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(INFINITY, 0, 0)), RID());
+
+		CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(5, 5, 5), Vector3(5, -5, 5)).is_equal_approx(Vector3(5, 0, 5)));
+		CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(-10, 0, -10), Vector3(-5, 0, -10)).is_equal_approx(Vector3(0, 0, 0)));
+
+		// Start and end of a path are snapped to the closest polygons as well.
+		const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-5, 0, 2.5), Vector3(45, 3, 2.5), true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[0].is_equal_approx(Vector3(0, 0, 2.5)));
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(40, 0, 2.5)));
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Map sync should only reprocess changed regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// 1000 regions of 2x2 quads, merged with their neighbors along the shared edges.
+		const int region_columns = 40;
+		const int region_rows = 25;
+		LocalVector<RID> regions;
+		for (int region_z = 0; region_z < region_rows; region_z++) {
+			for (int region_x = 0; region_x < region_columns; region_x++) {
+				Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+				Vector<Vector3> vertices;
+				for (int z = 0; z <= 2; z++) {
+					for (int x = 0; x <= 2; x++) {
+						vertices.push_back(Vector3(region_x * 2 + x, 0, region_z * 2 + z));
+					}
+				}
+				navigation_mesh->set_vertices(vertices);
+				for (int z = 0; z < 2; z++) {
+					for (int x = 0; x < 2; x++) {
+						const int index = z * 3 + x;
+						Vector<int> polygon;
+						polygon.push_back(index);
+						polygon.push_back(index + 3);
+						polygon.push_back(index + 4);
+						polygon.push_back(index + 1);
+						navigation_mesh->add_polygon(polygon);
+					}
+				}
+
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				regions.push_back(region);
+			}
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const int polygon_count = navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT);
+		const int edge_count = navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT);
+		const int edge_merge_count = navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT);
+		const int edge_free_count = navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		CHECK_EQ(polygon_count, region_columns * region_rows * 4);
+		CHECK_EQ(edge_count, (region_columns * 2 + 1) * region_rows * 2 + (region_rows * 2 + 1) * region_columns * 2);
+		CHECK_EQ(edge_free_count, (region_columns + region_rows) * 4);
+		CHECK_EQ(edge_merge_count, edge_count - edge_free_count);
+
+		const Vector3 path_start = Vector3(0.5, 0, 25.5);
+		const Vector3 path_end = Vector3(79.5, 0, 25.5);
+		const Vector<Vector3> path = navigation_server->map_get_path(map, path_start, path_end, true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(path_end));
+
+		// Toggle a region in the middle of the map, which sits right on the path.
+		const RID toggled_region = regions[12 * region_columns + 20];
+		const Vector3 toggled_region_center = Vector3(41, 0, 25);
+
+		navigation_server->region_set_enabled(toggled_region, false);
+		navigation_server->map_force_update(map);
+		navigation_server->process(0.0);
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), polygon_count - 4);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), edge_free_count + 8);
+		CHECK_NE(navigation_server->map_get_closest_point_owner(map, toggled_region_center), toggled_region);
+
+		const Vector<Vector3> detour = navigation_server->map_get_path(map, path_start, path_end, true);
+		REQUIRE_GE(detour.size(), 3);
+		CHECK(detour[detour.size() - 1].is_equal_approx(path_end));
+		for (const Vector3 &point : detour) {
+			CHECK_FALSE((point.x > 40.0 && point.x < 42.0 && point.z > 24.0 && point.z < 26.0));
+		}
+
+		navigation_server->region_set_enabled(toggled_region, true);
+		navigation_server->map_force_update(map);
+		navigation_server->process(0.0);
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), polygon_count);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), edge_count);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), edge_merge_count);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), edge_free_count);
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, toggled_region_center), toggled_region);
+		CHECK_EQ(navigation_server->map_get_path(map, path_start, path_end, true), path);
+
+		// Changing a map setting still rebuilds all regions.
+		navigation_server->map_set_edge_connection_margin(map, 0.5);
+		navigation_server->map_force_update(map);
+		navigation_server->process(0.0);
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), polygon_count);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), edge_merge_count);
+		CHECK_EQ(navigation_server->map_get_path(map, path_start, path_end, true), path);
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
@@ -781,6 +1375,90 @@ TEST_SUITE("[Navigation]") {
 		CHECK_EQ(navigation_mesh->get_polygon_count(), 0);
 		CHECK_EQ(navigation_mesh->get_vertices().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake tiles that merge on the map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 20.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+
+		Dictionary tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, 5.0);
+		REQUIRE_EQ(tiles.size(), 16);
+		CHECK(tiles.has(Vector2i(-2, -2)));
+		CHECK(tiles.has(Vector2i(1, 1)));
+		CHECK_EQ(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		LocalVector<RID> regions;
+		const Array tile_meshes = tiles.values();
+		for (int i = 0; i < tile_meshes.size(); i++) {
+			Ref<NavigationMesh> tile_mesh = tile_meshes[i];
+			REQUIRE(tile_mesh.is_valid());
+			CHECK_GT(tile_mesh->get_polygon_count(), 0);
+
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, tile_mesh);
+			regions.push_back(region);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths should cross the tile borders") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-8, 0, -8), Vector3(8, 0, 7), true);
+			REQUIRE_GE(path.size(), 2);
+			const Vector3 path_end = path[path.size() - 1];
+			CHECK(Math::is_equal_approx(path_end.x, (real_t)8.0));
+			CHECK(Math::is_equal_approx(path_end.z, (real_t)7.0));
+		}
+
+		SUBCASE("Only the tiles next to a change should be baked again") {
+			Dictionary changed_tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, 5.0, AABB(Vector3(1, 0, 1), Vector3(0.5, 1, 0.5)));
+			CHECK_EQ(changed_tiles.size(), 4);
+			CHECK(changed_tiles.has(Vector2i(-1, -1)));
+			CHECK(changed_tiles.has(Vector2i(0, 0)));
+			CHECK_FALSE(changed_tiles.has(Vector2i(1, 1)));
+
+			Ref<NavigationMesh> changed_tile = changed_tiles[Vector2i(0, 0)];
+			Ref<NavigationMesh> tile = tiles[Vector2i(0, 0)];
+			REQUIRE(changed_tile.is_valid());
+			CHECK_EQ(changed_tile->get_vertices(), tile->get_vertices());
+		}
+
+		SUBCASE("Tiles should be clipped to the filter baking AABB") {
+			Ref<NavigationMesh> filtered_navigation_mesh = navigation_mesh->duplicate();
+			filtered_navigation_mesh->set_filter_baking_aabb(AABB(Vector3(-3, -1, -3), Vector3(6, 2, 6)));
+			filtered_navigation_mesh->set_filter_baking_aabb_offset(Vector3(0.1, 0, 0.1));
+			Dictionary filtered_tiles = navigation_server->bake_tiles_from_source_geometry_data(filtered_navigation_mesh, source_geometry, 5.0);
+			CHECK_EQ(filtered_tiles.size(), 4);
+			CHECK(filtered_tiles.has(Vector2i(-1, -1)));
+			CHECK(filtered_tiles.has(Vector2i(0, 0)));
+
+			const real_t cell_size = filtered_navigation_mesh->get_cell_size();
+			const Array filtered_tile_meshes = filtered_tiles.values();
+			for (int i = 0; i < filtered_tile_meshes.size(); i++) {
+				Ref<NavigationMesh> tile_mesh = filtered_tile_meshes[i];
+				REQUIRE(tile_mesh.is_valid());
+				CHECK_GT(tile_mesh->get_polygon_count(), 0);
+				for (const Vector3 &vertex : tile_mesh->get_vertices()) {
+					CHECK(vertex.x >= -2.9 - cell_size);
+					CHECK(vertex.x <= 3.1 + cell_size);
+					CHECK(vertex.z >= -2.9 - cell_size);
+					CHECK(vertex.z <= 3.1 + cell_size);
+				}
+			}
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
 }
 } //namespace TestNavigationServer3D
 
@@ -0,0 +1,356 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hashfuncs.h"
+#include "servers/physics_2d/godot_physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+static uint32_t hash_body_state(PhysicsServer2D *p_server, const LocalVector<RID> &p_bodies) {
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (const RID &body : p_bodies) {
+		Transform2D transform = p_server->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		Vector2 linear_velocity = p_server->body_get_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		real_t angular_velocity = p_server->body_get_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+		for (int i = 0; i < 3; i++) {
+			hash = hash_murmur3_one_real(transform.columns[i].x, hash);
+			hash = hash_murmur3_one_real(transform.columns[i].y, hash);
+		}
+		hash = hash_murmur3_one_real(linear_velocity.x, hash);
+		hash = hash_murmur3_one_real(linear_velocity.y, hash);
+		hash = hash_murmur3_one_real(angular_velocity, hash);
+	}
+	return hash_fmix32(hash);
+}
+
+// Drops several stacks of boxes and circles, so the solver gets multiple islands to spread across threads,
+// and returns a hash of the final body states.
+static uint32_t simulate_stacks(int p_thread_count) {
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(p_thread_count);
+
+	GodotPhysicsServer2D *server = memnew(GodotPhysicsServer2D);
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID ground_shape = server->world_boundary_shape_create();
+	Array ground_data;
+	ground_data.push_back(Vector2(0, -1));
+	ground_data.push_back(0);
+	server->shape_set_data(ground_shape, ground_data);
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(10, 10));
+	RID circle_shape = server->circle_shape_create();
+	server->shape_set_data(circle_shape, 8);
+
+	RID ground = server->body_create();
+	server->body_set_mode(ground, PhysicsServer2D::BODY_MODE_STATIC);
+	server->body_add_shape(ground, ground_shape);
+	server->body_set_space(ground, space);
+
+	LocalVector<RID> bodies;
+	for (int stack = 0; stack < 6; stack++) {
+		for (int level = 0; level < 8; level++) {
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			server->body_add_shape(body, (level % 3 == 2) ? circle_shape : box_shape);
+			// Slightly offset and rotated so the stacks topple and keep colliding.
+			Transform2D transform(0.1 * level, Vector2(stack * 200.0 + 1.5 * level, -12.0 - level * 21.0));
+			server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, transform);
+			server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	for (int frame = 0; frame < 240; frame++) {
+		server->step(1.0 / 60.0);
+	}
+
+	uint32_t hash = hash_body_state(server, bodies);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(ground);
+	server->free(circle_shape);
+	server->free(box_shape);
+	server->free(ground_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+
+	return hash;
+}
+
+TEST_CASE("[PhysicsServer2D] Simulation doesn't depend on the thread count") {
+	uint32_t single_thread_hash = simulate_stacks(1);
+	uint32_t multi_thread_hash = simulate_stacks(4);
+	uint32_t repeated_hash = simulate_stacks(4);
+
+	// Restore the default pool for the following tests.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	CHECK_MESSAGE(multi_thread_hash == repeated_hash, "Stepping the same scene twice should give bit-identical results.");
+	CHECK_MESSAGE(single_thread_hash == multi_thread_hash, "Stepping with 1 and 4 threads should give bit-identical results.");
+}
+
+// Adds a box that rests on the ground of the space, and never sleeps so it keeps its island.
+static RID add_resting_box(PhysicsServer2D *p_server, RID p_space, RID p_shape, real_t p_x) {
+	RID body = p_server->body_create();
+	p_server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+	p_server->body_add_shape(body, p_shape);
+	p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(p_x, -9.9)));
+	p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+	p_server->body_set_space(body, p_space);
+	return body;
+}
+
+TEST_CASE("[PhysicsServer2D] Cached islands follow added and removed bodies") {
+	GodotPhysicsServer2D *server = memnew(GodotPhysicsServer2D);
+	server->init();
+	server->set_active(true);
+
+	RID ground_shape = server->world_boundary_shape_create();
+	Array ground_data;
+	ground_data.push_back(Vector2(0, -1));
+	ground_data.push_back(0);
+	server->shape_set_data(ground_shape, ground_data);
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(10, 10));
+
+	// Both spaces are stepped by the same stepper, each must keep its own islands.
+	RID spaces[2];
+	RID grounds[2];
+	for (int i = 0; i < 2; i++) {
+		spaces[i] = server->space_create();
+		server->space_set_active(spaces[i], true);
+		grounds[i] = server->body_create();
+		server->body_set_mode(grounds[i], PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(grounds[i], ground_shape);
+		server->body_set_space(grounds[i], spaces[i]);
+	}
+
+	// Each box only touches the ground, so each one is an island.
+	LocalVector<RID> boxes;
+	boxes.push_back(add_resting_box(server, spaces[0], box_shape, 0));
+	boxes.push_back(add_resting_box(server, spaces[0], box_shape, 100));
+	boxes.push_back(add_resting_box(server, spaces[1], box_shape, 0));
+	for (int frame = 0; frame < 10; frame++) {
+		server->step(1.0 / 60.0);
+	}
+	CHECK(server->get_process_info(PhysicsServer2D::INFO_ISLAND_COUNT) == 3);
+
+	RID added_box = add_resting_box(server, spaces[0], box_shape, 200);
+	boxes.push_back(added_box);
+	for (int frame = 0; frame < 30; frame++) {
+		server->step(1.0 / 60.0);
+	}
+	CHECK(server->get_process_info(PhysicsServer2D::INFO_ISLAND_COUNT) == 4);
+	// Solving the contact of the new box keeps it on the ground.
+	Transform2D added_transform = server->body_get_state(added_box, PhysicsServer2D::BODY_STATE_TRANSFORM);
+	CHECK(added_transform.get_origin().y == doctest::Approx(-10).epsilon(0.05));
+
+	server->free(boxes[1]);
+	boxes.remove_at(1);
+	for (int frame = 0; frame < 10; frame++) {
+		server->step(1.0 / 60.0);
+	}
+	CHECK(server->get_process_info(PhysicsServer2D::INFO_ISLAND_COUNT) == 3);
+
+	for (const RID &box : boxes) {
+		server->free(box);
+	}
+	for (int i = 0; i < 2; i++) {
+		server->free(grounds[i]);
+		server->free(spaces[i]);
+	}
+	server->free(box_shape);
+	server->free(ground_shape);
+	server->finish();
+	memdelete(server);
+}
+
+// Casts the rays in a single batch and checks each result against a single ray query.
+// Returns the number of hits, and the batched results in r_results.
+static int check_batched_rays(PhysicsDirectSpaceState2D *p_space_state, const PhysicsDirectSpaceState2D::RayParameters &p_parameters, const LocalVector<Vector2> &p_from, const LocalVector<Vector2> &p_to, LocalVector<PhysicsDirectSpaceState2D::RayResult> &r_results) {
+	const int ray_count = p_from.size();
+	r_results.resize(ray_count);
+	LocalVector<bool> hits;
+	hits.resize(ray_count);
+	int hit_count = p_space_state->intersect_rays(p_parameters, p_from.ptr(), p_to.ptr(), ray_count, r_results.ptr(), hits.ptr());
+
+	int expected_hit_count = 0;
+	for (int i = 0; i < ray_count; i++) {
+		PhysicsDirectSpaceState2D::RayParameters ray = p_parameters;
+		ray.from = p_from[i];
+		ray.to = p_to[i];
+		PhysicsDirectSpaceState2D::RayResult expected;
+		bool expected_hit = p_space_state->intersect_ray(ray, expected);
+
+		INFO("Ray ", i, " from ", p_from[i], " to ", p_to[i]);
+		REQUIRE(hits[i] == expected_hit);
+		if (!expected_hit) {
+			continue;
+		}
+		expected_hit_count++;
+		CHECK(r_results[i].position.is_equal_approx(expected.position));
+		CHECK(r_results[i].normal.is_equal_approx(expected.normal));
+		CHECK(r_results[i].rid == expected.rid);
+		CHECK(r_results[i].shape == expected.shape);
+	}
+
+	CHECK(hit_count == expected_hit_count);
+	return hit_count;
+}
+
+TEST_CASE("[PhysicsServer2D] Batched ray queries match single ray queries") {
+	GodotPhysicsServer2D *server = memnew(GodotPhysicsServer2D);
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	// A 48x48 grid of small boxes, more than a single packet can cull at once.
+	const int grid_size = 48;
+	RID small_box_shape = server->rectangle_shape_create();
+	server->shape_set_data(small_box_shape, Vector2(4, 4));
+	RID grid = server->body_create();
+	server->body_set_mode(grid, PhysicsServer2D::BODY_MODE_STATIC);
+	for (int y = 0; y < grid_size; y++) {
+		for (int x = 0; x < grid_size; x++) {
+			server->body_add_shape(grid, small_box_shape, Transform2D(0.0, Vector2(x * 20, y * 20)));
+		}
+	}
+	server->body_set_space(grid, space);
+
+	// A single large box away from the grid, for packets with few candidates.
+	RID large_box_shape = server->rectangle_shape_create();
+	server->shape_set_data(large_box_shape, Vector2(40, 40));
+	RID block = server->body_create();
+	server->body_set_mode(block, PhysicsServer2D::BODY_MODE_STATIC);
+	server->body_add_shape(block, large_box_shape);
+	server->body_set_state(block, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(2000, 0)));
+	server->body_set_space(block, space);
+
+	// Two overlapping bodies, to resolve rays starting inside both of them.
+	RID overlapping_shape = server->rectangle_shape_create();
+	server->shape_set_data(overlapping_shape, Vector2(20, 20));
+	RID overlapping_bodies[2];
+	for (int i = 0; i < 2; i++) {
+		overlapping_bodies[i] = server->body_create();
+		server->body_set_mode(overlapping_bodies[i], PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(overlapping_bodies[i], overlapping_shape);
+		server->body_set_state(overlapping_bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(4000, i * 10)));
+		server->body_set_space(overlapping_bodies[i], space);
+	}
+
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	// First packet: rays along the grid rows, spanning the whole grid so the packet falls back to one query per ray.
+	// Odd rays pass between two rows and miss.
+	for (int i = 0; i < 16; i++) {
+		real_t y = i * 60 + (i % 2 == 1 ? 10.0 : 0.0);
+		from.push_back(Vector2(-20, y));
+		to.push_back(Vector2(grid_size * 20, y));
+	}
+	// Second packet: rays falling onto the large box, the outer ones miss it.
+	for (int i = 0; i < 16; i++) {
+		real_t x = 1910 + i * 12;
+		from.push_back(Vector2(x, -100));
+		to.push_back(Vector2(x, 100));
+	}
+	// Last partial packet: rays falling onto a few grid cells, alternately on a box and between two boxes.
+	for (int i = 0; i < 5; i++) {
+		real_t x = 200 + i * 10;
+		from.push_back(Vector2(x, 190));
+		to.push_back(Vector2(x, 230));
+	}
+
+	// Scattered packet: short rays far apart from each other, only the one above the large box hits.
+	for (int i = 0; i < 16; i++) {
+		real_t x = i * 800 - 6010;
+		from.push_back(Vector2(x, -100));
+		to.push_back(Vector2(x, 100));
+	}
+
+	PhysicsDirectSpaceState2D *space_state = server->space_get_direct_state(space);
+	PhysicsDirectSpaceState2D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState2D::RayResult> results;
+	const int hit_count = check_batched_rays(space_state, parameters, from, to, results);
+	CHECK(hit_count > 0);
+	CHECK(hit_count < (int)from.size());
+
+	// Rays starting inside both overlapping bodies.
+	LocalVector<Vector2> inside_from;
+	LocalVector<Vector2> inside_to;
+	for (int i = 0; i < 4; i++) {
+		inside_from.push_back(Vector2(3990 + i * 5, 5));
+		inside_to.push_back(Vector2(3990 + i * 5, 100));
+	}
+
+	// Without hit_from_inside, the rays leave both bodies and hit nothing else.
+	LocalVector<PhysicsDirectSpaceState2D::RayResult> inside_results;
+	CHECK(check_batched_rays(space_state, parameters, inside_from, inside_to, inside_results) == 0);
+	// With it, both bodies contain the start of each ray, the same one has to be reported either way.
+	parameters.hit_from_inside = true;
+	CHECK(check_batched_rays(space_state, parameters, inside_from, inside_to, inside_results) == (int)inside_from.size());
+
+	// The first ray hits the first box of the first row.
+	CHECK(results[0].rid == grid);
+	CHECK(results[0].shape == 0);
+	CHECK(results[0].position.is_equal_approx(Vector2(-4, 0)));
+
+	for (int i = 0; i < 2; i++) {
+		server->free(overlapping_bodies[i]);
+	}
+	server->free(overlapping_shape);
+	server->free(block);
+	server->free(grid);
+	server->free(large_box_shape);
+	server->free(small_box_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
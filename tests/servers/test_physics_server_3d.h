@@ -0,0 +1,533 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hashfuncs.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+static uint32_t hash_body_state(PhysicsServer3D *p_server, const LocalVector<RID> &p_bodies) {
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (const RID &body : p_bodies) {
+		Transform3D transform = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		Vector3 linear_velocity = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		Vector3 angular_velocity = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+		for (int i = 0; i < 3; i++) {
+			hash = hash_murmur3_one_real(transform.basis[i].x, hash);
+			hash = hash_murmur3_one_real(transform.basis[i].y, hash);
+			hash = hash_murmur3_one_real(transform.basis[i].z, hash);
+			hash = hash_murmur3_one_real(transform.origin[i], hash);
+			hash = hash_murmur3_one_real(linear_velocity[i], hash);
+			hash = hash_murmur3_one_real(angular_velocity[i], hash);
+		}
+	}
+	return hash_fmix32(hash);
+}
+
+// Drops several stacks of boxes and spheres, so the solver gets multiple islands to spread across threads,
+// and returns a hash of the final body states.
+static uint32_t simulate_stacks(int p_thread_count) {
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(p_thread_count);
+
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID ground_shape = server->world_boundary_shape_create();
+	server->shape_set_data(ground_shape, Plane(Vector3(0, 1, 0), 0));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = server->sphere_shape_create();
+	server->shape_set_data(sphere_shape, 0.4);
+
+	RID ground = server->body_create();
+	server->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(ground, ground_shape);
+	server->body_set_space(ground, space);
+
+	LocalVector<RID> bodies;
+	for (int stack = 0; stack < 6; stack++) {
+		for (int level = 0; level < 8; level++) {
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			server->body_add_shape(body, (level % 3 == 2) ? sphere_shape : box_shape);
+			// Slightly offset and rotated so the stacks topple and keep colliding.
+			Transform3D transform(Basis(Vector3(0, 1, 0), 0.1 * level), Vector3(stack * 10.0 + 0.07 * level, 0.6 + level * 1.05, 0.03 * stack));
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, transform);
+			server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	for (int frame = 0; frame < 240; frame++) {
+		server->step(1.0 / 60.0);
+	}
+
+	uint32_t hash = hash_body_state(server, bodies);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(ground);
+	server->free(sphere_shape);
+	server->free(box_shape);
+	server->free(ground_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+
+	return hash;
+}
+
+TEST_CASE("[PhysicsServer3D] Simulation doesn't depend on the thread count") {
+	uint32_t single_thread_hash = simulate_stacks(1);
+	uint32_t multi_thread_hash = simulate_stacks(4);
+	uint32_t repeated_hash = simulate_stacks(4);
+
+	// Restore the default pool for the following tests.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	CHECK_MESSAGE(multi_thread_hash == repeated_hash, "Stepping the same scene twice should give bit-identical results.");
+	CHECK_MESSAGE(single_thread_hash == multi_thread_hash, "Stepping with 1 and 4 threads should give bit-identical results.");
+}
+
+// Shoots a small bullet at a thin wall, fast enough to cross it within a single step, and returns its final position along the shot.
+static real_t shoot_through_wall(PhysicsServer3D::ShapeType p_bullet_shape_type, bool p_continuous_cd) {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID wall_shape = server->box_shape_create();
+	server->shape_set_data(wall_shape, Vector3(0.025, 5, 5));
+	RID bullet_shape;
+	switch (p_bullet_shape_type) {
+		case PhysicsServer3D::SHAPE_BOX: {
+			bullet_shape = server->box_shape_create();
+			server->shape_set_data(bullet_shape, Vector3(0.1, 0.1, 0.1));
+		} break;
+		case PhysicsServer3D::SHAPE_CAPSULE: {
+			Dictionary capsule_data;
+			capsule_data["radius"] = 0.1;
+			capsule_data["height"] = 0.4;
+			bullet_shape = server->capsule_shape_create();
+			server->shape_set_data(bullet_shape, capsule_data);
+		} break;
+		default: {
+			bullet_shape = server->sphere_shape_create();
+			server->shape_set_data(bullet_shape, 0.1);
+		} break;
+	}
+
+	RID wall = server->body_create();
+	server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(wall, wall_shape);
+	server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(10, 0, 0)));
+	server->body_set_space(wall, space);
+
+	RID bullet = server->body_create();
+	server->body_set_mode(bullet, PhysicsServer3D::BODY_MODE_RIGID);
+	server->body_add_shape(bullet, bullet_shape);
+	server->body_set_param(bullet, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	server->body_set_enable_continuous_collision_detection(bullet, p_continuous_cd);
+	server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.3, 0, 0)));
+	// 5 meters per step at 60 FPS.
+	server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(300, 0, 0));
+	server->body_set_space(bullet, space);
+
+	for (int frame = 0; frame < 10; frame++) {
+		server->step(1.0 / 60.0);
+	}
+
+	Transform3D transform = server->body_get_state(bullet, PhysicsServer3D::BODY_STATE_TRANSFORM);
+
+	server->free(bullet);
+	server->free(wall);
+	server->free(bullet_shape);
+	server->free(wall_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+
+	return transform.origin.x;
+}
+
+TEST_CASE("[PhysicsServer3D] Continuous collision detection stops fast bodies at thin walls") {
+	SUBCASE("Sphere") {
+		CHECK_MESSAGE(shoot_through_wall(PhysicsServer3D::SHAPE_SPHERE, false) > 10.0, "Without continuous collision detection, the bullet is expected to tunnel through the wall.");
+		CHECK_MESSAGE(shoot_through_wall(PhysicsServer3D::SHAPE_SPHERE, true) < 10.0, "With continuous collision detection, the bullet should be stopped by the wall.");
+	}
+
+	SUBCASE("Box") {
+		CHECK_MESSAGE(shoot_through_wall(PhysicsServer3D::SHAPE_BOX, false) > 10.0, "Without continuous collision detection, the bullet is expected to tunnel through the wall.");
+		CHECK_MESSAGE(shoot_through_wall(PhysicsServer3D::SHAPE_BOX, true) < 10.0, "With continuous collision detection, the bullet should be stopped by the wall.");
+	}
+
+	SUBCASE("Capsule") {
+		CHECK_MESSAGE(shoot_through_wall(PhysicsServer3D::SHAPE_CAPSULE, false) > 10.0, "Without continuous collision detection, the bullet is expected to tunnel through the wall.");
+		CHECK_MESSAGE(shoot_through_wall(PhysicsServer3D::SHAPE_CAPSULE, true) < 10.0, "With continuous collision detection, the bullet should be stopped by the wall.");
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Heightmap queries follow region updates") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	// A flat terrain large enough for several levels of height bounds.
+	const int size = 1025;
+	Vector<real_t> heights;
+	heights.resize(size * size);
+	heights.fill(0.0);
+
+	Dictionary data;
+	data["width"] = size;
+	data["depth"] = size;
+	data["heights"] = heights;
+	RID terrain_shape = server->heightmap_shape_create();
+	server->shape_set_data(terrain_shape, data);
+
+	RID terrain = server->body_create();
+	server->body_set_mode(terrain, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(terrain, terrain_shape);
+	server->body_set_space(terrain, space);
+
+	RID probe_shape = server->box_shape_create();
+	server->shape_set_data(probe_shape, Vector3(2.5, 2.5, 2.5));
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+
+	PhysicsDirectSpaceState3D::RayParameters ray;
+	ray.from = Vector3(-500, 10, -500);
+	ray.to = Vector3(500, -10, 500);
+	PhysicsDirectSpaceState3D::RayResult ray_result;
+
+	PhysicsDirectSpaceState3D::ShapeParameters probe;
+	probe.shape_rid = probe_shape;
+	probe.transform.origin = Vector3(-308, 20, -308);
+	PhysicsDirectSpaceState3D::ShapeResult probe_results[8];
+
+	REQUIRE(space_state->intersect_ray(ray, ray_result));
+	CHECK(ray_result.position.is_equal_approx(Vector3()));
+	CHECK(space_state->intersect_shape(probe, probe_results, 8) == 0);
+
+	// Raise a 9x9 block across the ray, from x and z = -312 to -304.
+	Vector<real_t> block;
+	block.resize(9 * 9);
+	block.fill(20.0);
+
+	Dictionary region_data;
+	region_data["width"] = size;
+	region_data["depth"] = size;
+	region_data["region"] = Rect2i(200, 200, 9, 9);
+	region_data["heights"] = block;
+	server->shape_set_data(terrain_shape, region_data);
+
+	REQUIRE(space_state->intersect_ray(ray, ray_result));
+	CHECK(ray_result.position.x > -313);
+	CHECK(ray_result.position.x < -303);
+	CHECK(space_state->intersect_shape(probe, probe_results, 8) == 1);
+
+	// Far from the block, the probe stays above the flat terrain.
+	probe.transform.origin = Vector3(300, 20, 300);
+	CHECK(space_state->intersect_shape(probe, probe_results, 8) == 0);
+
+	Dictionary updated_data = server->shape_get_data(terrain_shape);
+	CHECK(real_t(updated_data["max_height"]) == doctest::Approx(20.0));
+
+	server->free(terrain);
+	server->free(probe_shape);
+	server->free(terrain_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+}
+
+// Casts the rays in a single batch and checks each result against a single ray query.
+// Returns the number of hits, and the batched results in r_results.
+static int check_batched_rays(PhysicsDirectSpaceState3D *p_space_state, const PhysicsDirectSpaceState3D::RayParameters &p_parameters, const LocalVector<Vector3> &p_from, const LocalVector<Vector3> &p_to, LocalVector<PhysicsDirectSpaceState3D::RayResult> &r_results) {
+	const int ray_count = p_from.size();
+	r_results.resize(ray_count);
+	LocalVector<bool> hits;
+	hits.resize(ray_count);
+	int hit_count = p_space_state->intersect_rays(p_parameters, p_from.ptr(), p_to.ptr(), ray_count, r_results.ptr(), hits.ptr());
+
+	int expected_hit_count = 0;
+	for (int i = 0; i < ray_count; i++) {
+		PhysicsDirectSpaceState3D::RayParameters ray = p_parameters;
+		ray.from = p_from[i];
+		ray.to = p_to[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		bool expected_hit = p_space_state->intersect_ray(ray, expected);
+
+		INFO("Ray ", i, " from ", p_from[i], " to ", p_to[i]);
+		REQUIRE(hits[i] == expected_hit);
+		if (!expected_hit) {
+			continue;
+		}
+		expected_hit_count++;
+		CHECK(r_results[i].position.is_equal_approx(expected.position));
+		CHECK(r_results[i].normal.is_equal_approx(expected.normal));
+		CHECK(r_results[i].rid == expected.rid);
+		CHECK(r_results[i].shape == expected.shape);
+	}
+
+	CHECK(hit_count == expected_hit_count);
+	return hit_count;
+}
+
+TEST_CASE("[PhysicsServer3D] Batched ray queries match single ray queries") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	// A 48x48 grid of small boxes, more than a single packet can cull at once.
+	const int grid_size = 48;
+	RID small_box_shape = server->box_shape_create();
+	server->shape_set_data(small_box_shape, Vector3(0.2, 0.2, 0.2));
+	RID grid = server->body_create();
+	server->body_set_mode(grid, PhysicsServer3D::BODY_MODE_STATIC);
+	for (int z = 0; z < grid_size; z++) {
+		for (int x = 0; x < grid_size; x++) {
+			server->body_add_shape(grid, small_box_shape, Transform3D(Basis(), Vector3(x, 0, z)));
+		}
+	}
+	server->body_set_space(grid, space);
+
+	// A single large box away from the grid, for packets with few candidates.
+	RID large_box_shape = server->box_shape_create();
+	server->shape_set_data(large_box_shape, Vector3(2, 2, 2));
+	RID block = server->body_create();
+	server->body_set_mode(block, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(block, large_box_shape);
+	server->body_set_state(block, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(100, 0, 0)));
+	server->body_set_space(block, space);
+
+	// Two overlapping bodies, to resolve rays starting inside both of them.
+	RID overlapping_shape = server->box_shape_create();
+	server->shape_set_data(overlapping_shape, Vector3(1, 1, 1));
+	RID overlapping_bodies[2];
+	for (int i = 0; i < 2; i++) {
+		overlapping_bodies[i] = server->body_create();
+		server->body_set_mode(overlapping_bodies[i], PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(overlapping_bodies[i], overlapping_shape);
+		server->body_set_state(overlapping_bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(200, i * 0.5, 0)));
+		server->body_set_space(overlapping_bodies[i], space);
+	}
+
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	// First packet: rays along the grid rows, spanning the whole grid so the packet falls back to one query per ray.
+	// Odd rays pass between two rows and miss.
+	for (int i = 0; i < 16; i++) {
+		real_t z = i * 3 + (i % 2 == 1 ? 0.5 : 0.0);
+		from.push_back(Vector3(-1, 0, z));
+		to.push_back(Vector3(grid_size, 0, z));
+	}
+	// Second packet: rays falling onto the large box, the outer ones miss it.
+	for (int i = 0; i < 16; i++) {
+		real_t x = 95.5 + i * 0.6;
+		from.push_back(Vector3(x, 5, 0.5));
+		to.push_back(Vector3(x, -5, 0.5));
+	}
+	// Last partial packet: rays falling onto a few grid cells, alternately on a box and between two boxes.
+	for (int i = 0; i < 5; i++) {
+		real_t x = 10 + i * 0.5;
+		from.push_back(Vector3(x, 5, 10));
+		to.push_back(Vector3(x, -5, 10));
+	}
+
+	// Scattered packet: short rays far apart from each other, only the one above the large box hits.
+	for (int i = 0; i < 16; i++) {
+		real_t x = i * 40 - 300;
+		from.push_back(Vector3(x, 5, 0.5));
+		to.push_back(Vector3(x, -5, 0.5));
+	}
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	const int hit_count = check_batched_rays(space_state, parameters, from, to, results);
+	CHECK(hit_count > 0);
+	CHECK(hit_count < (int)from.size());
+
+	// Rays starting inside both overlapping bodies.
+	LocalVector<Vector3> inside_from;
+	LocalVector<Vector3> inside_to;
+	for (int i = 0; i < 4; i++) {
+		inside_from.push_back(Vector3(199.5 + i * 0.25, 0.25, 0));
+		inside_to.push_back(Vector3(199.5 + i * 0.25, 5, 0));
+	}
+
+	// Without hit_from_inside, the rays leave both bodies and hit nothing else.
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> inside_results;
+	CHECK(check_batched_rays(space_state, parameters, inside_from, inside_to, inside_results) == 0);
+	// With it, both bodies contain the start of each ray, the same one has to be reported either way.
+	parameters.hit_from_inside = true;
+	CHECK(check_batched_rays(space_state, parameters, inside_from, inside_to, inside_results) == (int)inside_from.size());
+
+	// The first ray hits the first box of the first row.
+	CHECK(results[0].rid == grid);
+	CHECK(results[0].shape == 0);
+	CHECK(results[0].position.is_equal_approx(Vector3(-0.2, 0, 0)));
+
+	for (int i = 0; i < 2; i++) {
+		server->free(overlapping_bodies[i]);
+	}
+	server->free(overlapping_shape);
+	server->free(block);
+	server->free(grid);
+	server->free(large_box_shape);
+	server->free(small_box_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+}
+
+// Hangs a square cloth of p_size * p_size vertices from its top edge and lets it swing for p_frames steps.
+// Returns a hash of the final vertex positions, and the average step time in r_step_usec.
+static uint32_t simulate_cloth(int p_thread_count, int p_size, int p_frames, uint64_t &r_step_usec) {
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(p_thread_count);
+
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	for (int y = 0; y < p_size; y++) {
+		for (int x = 0; x < p_size; x++) {
+			vertices.push_back(Vector3(x * 0.02, 0, y * 0.02));
+			if (x > 0 && y > 0) {
+				const int i = y * p_size + x;
+				indices.push_back(i - p_size - 1);
+				indices.push_back(i - p_size);
+				indices.push_back(i);
+				indices.push_back(i - p_size - 1);
+				indices.push_back(i);
+				indices.push_back(i - 1);
+			}
+		}
+	}
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+	arrays[RS::ARRAY_INDEX] = indices;
+	RID mesh = RS::get_singleton()->mesh_create();
+	RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+	RID cloth = server->soft_body_create();
+	server->soft_body_set_mesh(cloth, mesh);
+	server->soft_body_set_space(cloth, space);
+	for (int x = 0; x < p_size; x++) {
+		server->soft_body_pin_point(cloth, x, true);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < p_frames; frame++) {
+		server->step(1.0 / 60.0);
+	}
+	r_step_usec = (OS::get_singleton()->get_ticks_usec() - begin) / p_frames;
+
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (int i = 0; i < vertices.size(); i++) {
+		Vector3 position = server->soft_body_get_point_global_position(cloth, i);
+		hash = hash_murmur3_one_real(position.x, hash);
+		hash = hash_murmur3_one_real(position.y, hash);
+		hash = hash_murmur3_one_real(position.z, hash);
+	}
+
+	server->free(cloth);
+	server->free(space);
+	RS::get_singleton()->free(mesh);
+
+	return hash_fmix32(hash);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Soft body cloth is solved identically on several threads") {
+	// 3,136 vertices give more links than the threshold for splitting their batches across threads.
+	const int size = 56;
+	const int frames = 10;
+
+	uint64_t step_usec = 0;
+	uint32_t single_thread_hash = simulate_cloth(1, size, frames, step_usec);
+	uint32_t multi_thread_hash = simulate_cloth(4, size, frames, step_usec);
+
+	// Restore the default pool for the following tests.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	CHECK_MESSAGE(single_thread_hash == multi_thread_hash, "Solving the cloth on several threads should give bit-identical results.");
+}
+
+TEST_CASE("[Stress][SceneTree][PhysicsServer3D] Soft body cloth benchmark") {
+	// 10,201 vertices, enough for the solver to split its link batches across threads.
+	const int size = 101;
+	const int frames = 30;
+	const int thread_count = MAX(2, OS::get_singleton()->get_processor_count());
+
+	uint64_t single_thread_usec = 0;
+	uint64_t multi_thread_usec = 0;
+	uint32_t single_thread_hash = simulate_cloth(1, size, frames, single_thread_usec);
+	uint32_t multi_thread_hash = simulate_cloth(thread_count, size, frames, multi_thread_usec);
+
+	// Restore the default pool for the following tests.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	CHECK_MESSAGE(single_thread_hash == multi_thread_hash, "Solving the cloth on several threads should give bit-identical results.");
+	MESSAGE("Stepped a ", size * size, " vertex cloth in ", single_thread_usec, " usec on 1 thread and ", multi_thread_usec, " usec on ", thread_count, " threads.");
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
@@ -75,12 +75,16 @@
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
+#include "tests/core/os/test_frame_arena.h"
 #include "tests/core/os/test_os.h"
+#include "tests/core/os/test_small_allocator.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_command_queue.h"
+#include "tests/core/templates/test_dense_hash_map.h"
 #include "tests/core/templates/test_hash_map.h"
 #include "tests/core/templates/test_hash_set.h"
 #include "tests/core/templates/test_list.h"
@@ -90,6 +94,7 @@
 #include "tests/core/templates/test_paged_array.h"
 #include "tests/core/templates/test_rid.h"
 #include "tests/core/templates/test_vector.h"
+#include "tests/core/templates/test_work_stealing_deque.h"
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
 #include "tests/core/test_time.h"
@@ -123,6 +128,7 @@
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
+#include "tests/servers/test_physics_server_2d.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 
@@ -138,6 +144,7 @@
 #include "tests/scene/test_primitives.h"
 #include "tests/servers/test_navigation_server_2d.h"
 #include "tests/servers/test_navigation_server_3d.h"
+#include "tests/servers/test_physics_server_3d.h"
 #endif // _3D_DISABLED
 
 #include "modules/modules_tests.gen.h"